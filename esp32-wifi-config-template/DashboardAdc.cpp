@@ -0,0 +1,462 @@
+/*
+ * DashboardAdc.cpp
+ *
+ * Continuous ADC driver setup, the filter task and the polling fallback.
+ */
+
+#include "DashboardAdc.h"
+#if ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(5, 0, 0)
+#include <driver/adc.h>
+#endif
+
+#define ADC_TASK_STACK 4096         // Holds one DASHBOARD_ADC_FRAME
+#define ADC_READ_TIMEOUT 100        // ms a driver read may block
+#define ADC_NO_INDEX 0xFF
+
+// Result layout: 2-byte type1 on the ESP32 and S2, 4-byte type2 elsewhere
+#if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
+#define ADC_OUTPUT_FORMAT ADC_DIGI_OUTPUT_FORMAT_TYPE1
+#define ADC_RESULT_CHANNEL(p) ((p)->type1.channel)
+#define ADC_RESULT_DATA(p) ((p)->type1.data)
+#else
+#define ADC_OUTPUT_FORMAT ADC_DIGI_OUTPUT_FORMAT_TYPE2
+#define ADC_RESULT_CHANNEL(p) ((p)->type2.channel)
+#define ADC_RESULT_DATA(p) ((p)->type2.data)
+#endif
+
+DashboardAdc::DashboardAdc() {
+    _count = 0;
+    memset(_indexOf, ADC_NO_INDEX, sizeof(_indexOf));
+    _rate = DASHBOARD_ADC_RATE;
+    _oversample = DASHBOARD_ADC_OVERSAMPLE;
+    _median = DASHBOARD_ADC_MEDIAN;
+    _emaShift = DASHBOARD_ADC_EMA_SHIFT;
+
+    memset(_filters, 0, sizeof(_filters));
+    _continuous = false;
+    _running = false;
+    _interval = 0;
+    _samples = 0;
+    _overruns = 0;
+    _task = nullptr;
+
+    memset(_values, 0, sizeof(_values));
+    memset(_valid, 0, sizeof(_valid));
+    portMUX_TYPE unlocked = portMUX_INITIALIZER_UNLOCKED;
+    _lock = unlocked;
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    _handle = nullptr;
+    memset(_cali, 0, sizeof(_cali));
+#endif
+    memset(_calibrated, 0, sizeof(_calibrated));
+}
+
+int8_t DashboardAdc::addChannel(uint8_t pin, adc_atten_t atten) {
+    // Arduino numbers ADC2 channels from SOC_ADC_MAX_CHANNEL_NUM on
+    int8_t channel = digitalPinToAnalogChannel(pin);
+    if (channel < 0 || channel >= SOC_ADC_MAX_CHANNEL_NUM || _task) {
+        return -1;
+    }
+    if (_indexOf[channel] != ADC_NO_INDEX) {
+        return _indexOf[channel];
+    }
+    if (_count >= DASHBOARD_ADC_CHANNELS) {
+        return -1;
+    }
+
+    uint8_t index = _count++;
+    _pins[index] = pin;
+    _adcChannels[index] = channel;
+    _atten[index] = atten;
+    _indexOf[channel] = index;
+    return index;
+}
+
+void DashboardAdc::setSampleRate(uint32_t hz) {
+    if (hz < SOC_ADC_SAMPLE_FREQ_THRES_LOW) hz = SOC_ADC_SAMPLE_FREQ_THRES_LOW;
+    if (hz > SOC_ADC_SAMPLE_FREQ_THRES_HIGH) hz = SOC_ADC_SAMPLE_FREQ_THRES_HIGH;
+    _rate = hz;
+}
+
+void DashboardAdc::setFilter(uint16_t oversample, uint8_t median, uint8_t emaShift) {
+    // 256 x 12 bits still fits the Q8 average in 31 bits
+    _oversample = oversample < 1 ? 1 : (oversample > 256 ? 256 : oversample);
+    if (median > DASHBOARD_ADC_MEDIAN) median = DASHBOARD_ADC_MEDIAN;
+    _median = median < 1 ? 1 : (median | 1);
+    _emaShift = emaShift > 8 ? 8 : emaShift;
+}
+
+bool DashboardAdc::begin(BaseType_t core, UBaseType_t priority) {
+    if (_task) {
+        return true;
+    }
+    if (_count == 0) {
+        Serial.println("ADC: no channels");
+        return false;
+    }
+
+    for (uint8_t i = 0; i < _count; i++) {
+        calibrate(i);
+    }
+    _continuous = DASHBOARD_ADC_DMA && driverOpen();
+
+    xTaskCreatePinnedToCore(taskMain, "adc", ADC_TASK_STACK, this, priority, &_task, core);
+    if (_continuous) {
+        Serial.printf("ADC: %u channel(s), %lu conversions/s, %u per reading\n",
+                      (unsigned)_count, (unsigned long)_rate, (unsigned)_oversample);
+    } else {
+        Serial.println("ADC: continuous mode unavailable, polling with analogRead()");
+    }
+    return true;
+}
+
+void DashboardAdc::setInterval(uint32_t intervalMs) {
+    _interval = intervalMs;
+    if (_task) {
+        xTaskNotifyGive(_task);     // Wake a task waiting out the old interval
+    }
+}
+
+// ==================== READINGS ====================
+
+float DashboardAdc::value(uint8_t index) const {
+    if (index >= _count) {
+        return NAN;
+    }
+    portENTER_CRITICAL(&_lock);
+    int32_t value = _values[index];
+    bool valid = _valid[index];
+    portEXIT_CRITICAL(&_lock);
+    return valid ? value / 65536.0f : NAN;
+}
+
+float DashboardAdc::millivolts(uint8_t index) const {
+    if (index >= _count) {
+        return NAN;
+    }
+    portENTER_CRITICAL(&_lock);
+    int32_t value = _values[index];
+    bool valid = _valid[index];
+    portEXIT_CRITICAL(&_lock);
+    if (!valid) {
+        return NAN;
+    }
+
+    // The calibration takes whole counts: interpolate the fraction
+    int raw = value >> 16;
+    if (raw > 4094) raw = 4094;
+    float fraction = (value - ((int32_t)raw << 16)) / 65536.0f;
+    int low = rawToMillivolts(index, raw);
+    int high = rawToMillivolts(index, raw + 1);
+    if (low < 0 || high < 0) {
+        return NAN;
+    }
+    return low + (high - low) * fraction;
+}
+
+bool DashboardAdc::calibrated(uint8_t index) const {
+    return index < _count && _calibrated[index];
+}
+
+// ==================== FILTER ====================
+
+void DashboardAdc::taskMain(void* arg) {
+    DashboardAdc* adc = static_cast<DashboardAdc*>(arg);
+    if (adc->_continuous) {
+        adc->runContinuous();
+    } else {
+        adc->runPolling();
+    }
+}
+
+// Oversample -> median -> EMA for one conversion
+void DashboardAdc::feed(uint8_t index, uint16_t raw) {
+    Filter& filter = _filters[index];
+    filter.sum += raw;
+    if (++filter.taken < _oversample) {
+        return;
+    }
+    int32_t average = (int32_t)((filter.sum << 8) / filter.taken);
+    filter.sum = 0;
+    filter.taken = 0;
+
+    filter.window[filter.head] = average;
+    filter.head = (filter.head + 1) % _median;
+    if (filter.filled < _median) filter.filled++;
+
+    // Median of (at most DASHBOARD_ADC_MEDIAN) values: insertion sort
+    int32_t sorted[DASHBOARD_ADC_MEDIAN];
+    for (uint8_t i = 0; i < filter.filled; i++) {
+        int32_t x = filter.window[i];
+        uint8_t j = i;
+        for (; j > 0 && sorted[j - 1] > x; j--) {
+            sorted[j] = sorted[j - 1];
+        }
+        sorted[j] = x;
+    }
+    int32_t target = sorted[filter.filled / 2] << 8;
+
+    if (!filter.started) {
+        filter.started = true;
+        filter.ema = target;
+    } else {
+        filter.ema += (target - filter.ema) >> _emaShift;
+    }
+
+    portENTER_CRITICAL(&_lock);
+    _values[index] = filter.ema;
+    _valid[index] = true;
+    portEXIT_CRITICAL(&_lock);
+}
+
+// Conversions of one driver frame; returns how many were ours
+uint32_t DashboardAdc::parse(const uint8_t* frame, uint32_t length) {
+    uint32_t used = 0;
+    for (uint32_t offset = 0; offset + sizeof(adc_digi_output_data_t) <= length;
+         offset += sizeof(adc_digi_output_data_t)) {
+        const adc_digi_output_data_t* result = (const adc_digi_output_data_t*)(frame + offset);
+        uint32_t channel = ADC_RESULT_CHANNEL(result);
+        if (channel >= SOC_ADC_MAX_CHANNEL_NUM || _indexOf[channel] == ADC_NO_INDEX) {
+            continue;
+        }
+        feed(_indexOf[channel], ADC_RESULT_DATA(result));
+        used++;
+    }
+    _samples += used;
+    return used;
+}
+
+void DashboardAdc::runContinuous() {
+    uint8_t frame[DASHBOARD_ADC_FRAME];
+    uint32_t wanted = 0;        // Conversions left in this burst
+
+    for (;;) {
+        if (!_running) {
+            driverStart();
+            for (uint8_t i = 0; i < _count; i++) {
+                _filters[i].sum = 0;        // A burst starts a fresh window
+                _filters[i].taken = 0;
+            }
+            wanted = (uint32_t)_oversample * _count;
+        }
+
+        uint32_t length = 0;
+        esp_err_t result = driverRead(frame, sizeof(frame), &length, ADC_READ_TIMEOUT);
+        if (result == ESP_ERR_INVALID_STATE) {
+            _overruns++;                    // adc_digi: frames were dropped before this one
+        }
+        uint32_t used = length > 0 ? parse(frame, length) : 0;
+
+        if (_interval == 0) {
+            continue;
+        }
+        wanted = wanted > used ? wanted - used : 0;
+        if (wanted > 0) {
+            continue;
+        }
+        driverStop();
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(_interval));
+    }
+}
+
+// No continuous driver: the same filters fed from analogRead()
+void DashboardAdc::runPolling() {
+    for (;;) {
+        uint32_t interval = _interval;
+        uint32_t rounds = DASHBOARD_ADC_POLL_BURST;
+        if (interval > 0) {
+            rounds = _oversample;
+            for (uint8_t i = 0; i < _count; i++) {
+                _filters[i].sum = 0;
+                _filters[i].taken = 0;
+            }
+        }
+
+        for (uint32_t round = 0; round < rounds; round++) {
+            for (uint8_t i = 0; i < _count; i++) {
+                feed(i, analogRead(_pins[i]));
+            }
+        }
+        _samples += rounds * _count;
+        ulTaskNotifyTake(pdTRUE, interval > 0 ? pdMS_TO_TICKS(interval) : 1);
+    }
+}
+
+// ==================== DRIVER ====================
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+
+// user_data is &_overruns
+static bool IRAM_ATTR adcPoolOverflow(adc_continuous_handle_t handle,
+                                      const adc_continuous_evt_data_t* data, void* user) {
+    (*static_cast<volatile uint32_t*>(user))++;
+    return false;
+}
+
+bool DashboardAdc::driverOpen() {
+    adc_continuous_handle_cfg_t handleConfig = {};
+    handleConfig.max_store_buf_size = DASHBOARD_ADC_FRAME * 4;
+    handleConfig.conv_frame_size = DASHBOARD_ADC_FRAME;
+    if (adc_continuous_new_handle(&handleConfig, &_handle) != ESP_OK) {
+        return false;
+    }
+
+    adc_digi_pattern_config_t pattern[DASHBOARD_ADC_CHANNELS] = {};
+    for (uint8_t i = 0; i < _count; i++) {
+        pattern[i].atten = _atten[i];
+        pattern[i].channel = _adcChannels[i];
+        pattern[i].unit = ADC_UNIT_1;
+        pattern[i].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+    }
+    adc_continuous_config_t config = {};
+    config.pattern_num = _count;
+    config.adc_pattern = pattern;
+    config.sample_freq_hz = _rate;
+    config.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+    config.format = ADC_OUTPUT_FORMAT;
+    if (adc_continuous_config(_handle, &config) != ESP_OK) {
+        adc_continuous_deinit(_handle);
+        _handle = nullptr;
+        return false;
+    }
+
+    adc_continuous_evt_cbs_t callbacks = {};
+    callbacks.on_pool_ovf = adcPoolOverflow;
+    adc_continuous_register_event_callbacks(_handle, &callbacks, (void*)&_overruns);
+    return true;
+}
+
+void DashboardAdc::driverStart() {
+    // Conversions left from before a stop are stale
+    uint8_t stale[64];
+    uint32_t length = 0;
+    while (adc_continuous_read(_handle, stale, sizeof(stale), &length, 0) == ESP_OK && length > 0) {
+    }
+    adc_continuous_start(_handle);
+    _running = true;
+}
+
+void DashboardAdc::driverStop() {
+    adc_continuous_stop(_handle);
+    _running = false;
+}
+
+esp_err_t DashboardAdc::driverRead(uint8_t* frame, uint32_t size, uint32_t* length, uint32_t timeoutMs) {
+    return adc_continuous_read(_handle, frame, size, length, timeoutMs);
+}
+
+void DashboardAdc::calibrate(uint8_t index) {
+    esp_err_t result = ESP_FAIL;
+#if ADC_CALI_SCHEME_CURVE_FITTING_SUPPORTED
+    adc_cali_curve_fitting_config_t config = {};
+    config.unit_id = ADC_UNIT_1;
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 0)
+    config.chan = (adc_channel_t)_adcChannels[index];
+#endif
+    config.atten = _atten[index];
+    config.bitwidth = ADC_BITWIDTH_12;
+    result = adc_cali_create_scheme_curve_fitting(&config, &_cali[index]);
+    _calibrated[index] = result == ESP_OK;
+#elif ADC_CALI_SCHEME_LINE_FITTING_SUPPORTED
+    adc_cali_line_fitting_config_t config = {};
+    config.unit_id = ADC_UNIT_1;
+    config.atten = _atten[index];
+    config.bitwidth = ADC_BITWIDTH_12;
+#if CONFIG_IDF_TARGET_ESP32
+    config.default_vref = 1100;     // Chips without a Vref/two-point eFuse
+#endif
+    result = adc_cali_create_scheme_line_fitting(&config, &_cali[index]);
+
+    bool efuse = result == ESP_OK;
+#if CONFIG_IDF_TARGET_ESP32
+    adc_cali_line_fitting_efuse_val_t scheme;
+    efuse = efuse && adc_cali_line_fitting_efuse_get_scheme(&scheme) == ESP_OK
+        && scheme != ADC_CALI_LINE_FITTING_EFUSE_VAL_DEFAULT_VREF;
+#endif
+    _calibrated[index] = efuse;
+#endif
+    if (result != ESP_OK) {
+        _cali[index] = nullptr;
+    }
+}
+
+int DashboardAdc::rawToMillivolts(uint8_t index, int raw) const {
+    int millivolts = 0;
+    if (!_cali[index] || adc_cali_raw_to_voltage(_cali[index], raw, &millivolts) != ESP_OK) {
+        return -1;
+    }
+    return millivolts;
+}
+
+#else // adc_digi (IDF 4.4)
+
+#if CONFIG_IDF_TARGET_ESP32
+#define ADC_CONV_LIMIT 1            // Required on the ESP32 (I2S-driven)
+#else
+#define ADC_CONV_LIMIT 0
+#endif
+
+bool DashboardAdc::driverOpen() {
+    adc_digi_init_config_t init = {};
+    init.max_store_buf_size = DASHBOARD_ADC_FRAME * 4;
+    init.conv_num_each_intr = DASHBOARD_ADC_FRAME;
+    for (uint8_t i = 0; i < _count; i++) {
+        init.adc1_chan_mask |= 1UL << _adcChannels[i];
+    }
+    if (adc_digi_initialize(&init) != ESP_OK) {
+        return false;
+    }
+
+    adc_digi_pattern_config_t pattern[DASHBOARD_ADC_CHANNELS] = {};
+    for (uint8_t i = 0; i < _count; i++) {
+        pattern[i].atten = _atten[i];
+        pattern[i].channel = _adcChannels[i];
+        pattern[i].unit = 0;        // ADC1 (the pattern counts units from 0)
+        pattern[i].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+    }
+    adc_digi_configuration_t config = {};
+    config.conv_limit_en = ADC_CONV_LIMIT;
+    config.conv_limit_num = 250;
+    config.pattern_num = _count;
+    config.adc_pattern = pattern;
+    config.sample_freq_hz = _rate;
+    config.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+    config.format = ADC_OUTPUT_FORMAT;
+    if (adc_digi_controller_configure(&config) != ESP_OK) {
+        adc_digi_deinitialize();
+        return false;
+    }
+    return true;
+}
+
+void DashboardAdc::driverStart() {
+    // Conversions left from before a stop are stale
+    uint8_t stale[64];
+    uint32_t length = 0;
+    while (adc_digi_read_bytes(stale, sizeof(stale), &length, 0) == ESP_OK && length > 0) {
+    }
+    adc_digi_start();
+    _running = true;
+}
+
+void DashboardAdc::driverStop() {
+    adc_digi_stop();
+    _running = false;
+}
+
+esp_err_t DashboardAdc::driverRead(uint8_t* frame, uint32_t size, uint32_t* length, uint32_t timeoutMs) {
+    return adc_digi_read_bytes(frame, size, length, timeoutMs);
+}
+
+void DashboardAdc::calibrate(uint8_t index) {
+    esp_adc_cal_value_t source = esp_adc_cal_characterize(ADC_UNIT_1, _atten[index], ADC_WIDTH_BIT_12,
+                                                          1100, &_cali[index]);
+    _calibrated[index] = source != ESP_ADC_CAL_VAL_DEFAULT_VREF;
+}
+
+int DashboardAdc::rawToMillivolts(uint8_t index, int raw) const {
+    return (int)esp_adc_cal_raw_to_voltage(raw, &_cali[index]);
+}
+
+#endif
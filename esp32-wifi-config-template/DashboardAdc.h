@@ -0,0 +1,162 @@
+/*
+ * DashboardAdc.h
+ *
+ * Background analog acquisition for sensors read through the ADC, in
+ * place of blocking analogRead() calls from loop():
+ *
+ *   DashboardAdc adc;
+ *   int8_t adcSensor = adc.addChannel(34);     // GPIO on ADC1
+ *   adc.begin();
+ *   ...
+ *   channels.setValue(chSensor, adc.value(adcSensor));
+ *
+ * The ADC runs in continuous (DMA) mode at DASHBOARD_ADC_RATE
+ * conversions per second, shared by the channels, and a task filters
+ * the frames as they arrive, all in integer arithmetic:
+ *
+ *   oversample  average of 'oversample' raw conversions (Q8 counts)
+ *   median      of the last 1, 3 or 5 averages: drops single spikes
+ *               such as the ones WiFi transmissions put on the ADC
+ *   EMA         y += (x - y) >> shift (Q16 counts)
+ *
+ * value() returns the newest filtered reading in raw counts (0..4095);
+ * millivolts() converts it with the eFuse calibration of the chip. The
+ * calibration runs on the reader's side, once per read, not per
+ * conversion.
+ *
+ * The driver is the IDF adc_continuous one (Arduino core 3.x) or the
+ * adc_digi one (core 2.x; it uses I2S0 on the original ESP32). If it
+ * cannot start, or with -DDASHBOARD_ADC_DMA=0, the task polls the same
+ * pipeline with analogRead() instead, DASHBOARD_ADC_POLL_BURST
+ * conversions per channel per tick.
+ *
+ * Only ADC1 pins are accepted: ADC2 is unavailable while WiFi is on.
+ *
+ * setInterval() switches to bursts: one filter window per interval and
+ * the converter stopped in between, so sleep mode can still reach
+ * light sleep.
+ */
+
+#ifndef DASHBOARD_ADC_H
+#define DASHBOARD_ADC_H
+
+#include <Arduino.h>
+#include <esp_idf_version.h>
+#include <hal/adc_types.h>
+#include <soc/soc_caps.h>
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+#include <esp_adc/adc_continuous.h>
+#include <esp_adc/adc_cali.h>
+#include <esp_adc/adc_cali_scheme.h>
+#else
+#include <esp_adc_cal.h>
+#endif
+
+#ifndef DASHBOARD_ADC_DMA
+#define DASHBOARD_ADC_DMA 1             // 0 = always poll with analogRead()
+#endif
+
+#define DASHBOARD_ADC_CHANNELS 4        // Most channels sampled
+#define DASHBOARD_ADC_RATE 20000        // Conversions/s over all channels
+#define DASHBOARD_ADC_OVERSAMPLE 64     // Default conversions per average
+#define DASHBOARD_ADC_MEDIAN 5          // Largest median window
+#define DASHBOARD_ADC_EMA_SHIFT 4       // Default EMA: alpha = 1/16
+#define DASHBOARD_ADC_FRAME 1024        // Bytes the driver hands over at once
+#define DASHBOARD_ADC_POLL_BURST 4      // Fallback: conversions per channel per tick
+
+// 11 dB was renamed 12 dB (same setting: full range, ~0.15-2.45 V usable)
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0)
+#define DASHBOARD_ADC_ATTEN ADC_ATTEN_DB_12
+#else
+#define DASHBOARD_ADC_ATTEN ADC_ATTEN_DB_11
+#endif
+
+class DashboardAdc {
+public:
+    DashboardAdc();
+
+    // Call before begin(). Returns the index for value(), or -1 if the
+    // pin is not on ADC1 or the table is full.
+    int8_t addChannel(uint8_t pin, adc_atten_t atten = DASHBOARD_ADC_ATTEN);
+    void setSampleRate(uint32_t hz);
+    // median: window of 1 (off), 3 or 5; emaShift: 0 (off) .. 8
+    void setFilter(uint16_t oversample, uint8_t median, uint8_t emaShift);
+
+    // Start the driver (or the polling fallback) and the filter task
+    bool begin(BaseType_t core = 1, UBaseType_t priority = 2);
+
+    // Any task: 0 = sample continuously, else one filter window every
+    // intervalMs with the converter stopped in between
+    void setInterval(uint32_t intervalMs);
+
+    // Filtered reading in raw counts, NAN until the first one
+    float value(uint8_t index) const;
+    // The same, calibrated (NAN without a reading)
+    float millivolts(uint8_t index) const;
+
+    uint8_t count() const { return _count; }
+    bool continuous() const { return _continuous; }     // false = polling
+    bool calibrated(uint8_t index) const;               // eFuse values, not the default curve
+    uint32_t samples() const { return _samples; }       // Conversions filtered
+    uint32_t overruns() const { return _overruns; }     // Frames lost (task too slow)
+
+private:
+    // Filter state, only touched by the task
+    struct Filter {
+        uint32_t sum;
+        uint16_t taken;
+        uint8_t head;
+        uint8_t filled;
+        int32_t window[DASHBOARD_ADC_MEDIAN];   // Q8 averages
+        int32_t ema;                            // Q16
+        bool started;
+    };
+
+    uint8_t _count;
+    uint8_t _pins[DASHBOARD_ADC_CHANNELS];
+    uint8_t _adcChannels[DASHBOARD_ADC_CHANNELS];
+    adc_atten_t _atten[DASHBOARD_ADC_CHANNELS];
+    uint8_t _indexOf[SOC_ADC_MAX_CHANNEL_NUM];  // ADC1 channel -> index, 0xFF = unused
+    uint32_t _rate;
+    uint16_t _oversample;
+    uint8_t _median;
+    uint8_t _emaShift;
+
+    Filter _filters[DASHBOARD_ADC_CHANNELS];
+    bool _continuous;
+    bool _running;
+    volatile uint32_t _interval;
+    volatile uint32_t _samples;
+    volatile uint32_t _overruns;
+    TaskHandle_t _task;
+
+    // Published readings (Q16), under _lock
+    int32_t _values[DASHBOARD_ADC_CHANNELS];
+    bool _valid[DASHBOARD_ADC_CHANNELS];
+    mutable portMUX_TYPE _lock;
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    adc_continuous_handle_t _handle;
+    adc_cali_handle_t _cali[DASHBOARD_ADC_CHANNELS];
+#else
+    esp_adc_cal_characteristics_t _cali[DASHBOARD_ADC_CHANNELS];
+#endif
+    bool _calibrated[DASHBOARD_ADC_CHANNELS];
+
+    static void taskMain(void* arg);
+    void runContinuous();
+    void runPolling();
+    void feed(uint8_t index, uint16_t raw);
+    uint32_t parse(const uint8_t* frame, uint32_t length);
+
+    // Driver backend (adc_continuous or adc_digi)
+    bool driverOpen();
+    void driverStart();
+    void driverStop();
+    esp_err_t driverRead(uint8_t* frame, uint32_t size, uint32_t* length, uint32_t timeoutMs);
+    void calibrate(uint8_t index);
+    int rawToMillivolts(uint8_t index, int raw) const;
+};
+
+#endif // DASHBOARD_ADC_H
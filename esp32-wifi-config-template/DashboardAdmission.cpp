@@ -0,0 +1,81 @@
+/*
+ * DashboardAdmission.cpp
+ *
+ * Socket limit and per-client token buckets.
+ */
+
+#include "DashboardAdmission.h"
+
+#define ADMIT_TOKEN 1000                // One request, in bucket units
+#define ADMIT_SYSTEM_SOCKETS 3          // Listener, mDNS, MQTT: not for clients
+
+DashboardAdmission::DashboardAdmission() {
+    memset(_buckets, 0, sizeof(_buckets));
+    _socketLimit = DASHBOARD_SOCKETS_PER_STATION;
+    _limited = 0;
+    _busy = 0;
+}
+
+void DashboardAdmission::begin(uint8_t stations) {
+    int limit = stations * DASHBOARD_SOCKETS_PER_STATION;
+#ifdef CONFIG_LWIP_MAX_SOCKETS
+    if (limit > CONFIG_LWIP_MAX_SOCKETS - ADMIT_SYSTEM_SOCKETS) {
+        limit = CONFIG_LWIP_MAX_SOCKETS - ADMIT_SYSTEM_SOCKETS;
+    }
+#endif
+    if (limit <= DASHBOARD_SOCKETS_RESERVED) {
+        limit = DASHBOARD_SOCKETS_RESERVED + 1;
+    }
+    _socketLimit = (uint8_t)limit;
+}
+
+AdmissionResult DashboardAdmission::admit(uint32_t address, bool control, uint8_t open,
+                                          uint32_t now) {
+    // Control costs no token, so button presses never starve the polls
+    if (control) {
+        return ADMIT_OK;
+    }
+
+    if (open + DASHBOARD_SOCKETS_RESERVED >= _socketLimit) {
+        _busy = _busy + 1;
+        return ADMIT_BUSY;
+    }
+    Bucket& entry = bucket(address, now);
+    if (entry.tokens < ADMIT_TOKEN) {
+        _limited = _limited + 1;
+        return ADMIT_LIMITED;
+    }
+    entry.tokens -= ADMIT_TOKEN;
+    return ADMIT_OK;
+}
+
+// The client's bucket, refilled up to now; an unknown client takes the
+// slot seen longest ago and starts full
+DashboardAdmission::Bucket& DashboardAdmission::bucket(uint32_t address, uint32_t now) {
+    Bucket* oldest = &_buckets[0];
+    for (uint8_t i = 0; i < DASHBOARD_RATE_CLIENTS; i++) {
+        Bucket& entry = _buckets[i];
+        if (entry.address == address && address != 0) {
+            // Units per ms = requests per second; capped before multiplying
+            const uint32_t full = DASHBOARD_RATE_BURST * ADMIT_TOKEN;
+            uint32_t elapsed = now - entry.stamp;
+            if (elapsed >= full / DASHBOARD_RATE_PER_SEC) {
+                entry.tokens = full;
+            } else {
+                entry.tokens += elapsed * DASHBOARD_RATE_PER_SEC;
+                if (entry.tokens > full) entry.tokens = full;
+            }
+            entry.stamp = now;
+            return entry;
+        }
+        if (entry.address == 0 || (oldest->address != 0
+            && (int32_t)(entry.stamp - oldest->stamp) < 0)) {
+            oldest = &entry;
+        }
+    }
+
+    oldest->address = address;
+    oldest->tokens = DASHBOARD_RATE_BURST * ADMIT_TOKEN;
+    oldest->stamp = now;
+    return *oldest;
+}
@@ -0,0 +1,75 @@
+/*
+ * DashboardAdmission.h
+ *
+ * Admission control for the dashboard server. A soft-AP serves a
+ * handful of phones; a few forgotten tabs polling /api/status, plus the
+ * refresh after every button press, are enough to keep a single
+ * WebServer busy. Every request is checked before its handler runs:
+ *
+ *   - Sockets: at most DASHBOARD_SOCKETS_PER_STATION per station that
+ *     may join (DashboardConfig::maxConnections), and never more than
+ *     lwIP has. Open push streams and async requests still being sent
+ *     count; a poll that would go over the limit gets 503.
+ *   - Rate: a token bucket per client address (DASHBOARD_RATE_BURST
+ *     requests at once, DASHBOARD_RATE_PER_SEC after that). A poll
+ *     without a token gets 429 with Retry-After.
+ *
+ * Control requests (outputs, mode, actions, edits) are never refused and
+ * take no token, so it is the polling of a busy client that waits, not
+ * its buttons, and a burst of presses does not cost the next polls. The
+ * last DASHBOARD_SOCKETS_RESERVED sockets are kept for them.
+ *
+ * Belongs to the task that serves requests (one per backend).
+ */
+
+#ifndef DASHBOARD_ADMISSION_H
+#define DASHBOARD_ADMISSION_H
+
+#include <Arduino.h>
+
+#ifndef DASHBOARD_RATE_BURST
+#define DASHBOARD_RATE_BURST 8          // Requests a client may send at once
+#endif
+#ifndef DASHBOARD_RATE_PER_SEC
+#define DASHBOARD_RATE_PER_SEC 4        // ... and per second after that
+#endif
+#define DASHBOARD_RATE_CLIENTS 8        // Addresses tracked (oldest forgotten first)
+#define DASHBOARD_SOCKETS_PER_STATION 2 // A push stream and a request
+#define DASHBOARD_SOCKETS_RESERVED 1    // Only for control requests
+
+enum AdmissionResult : uint8_t {
+    ADMIT_OK,
+    ADMIT_LIMITED,              // Out of tokens: 429
+    ADMIT_BUSY                  // Out of sockets: 503
+};
+
+class DashboardAdmission {
+public:
+    DashboardAdmission();
+
+    // Socket limit for this many stations
+    void begin(uint8_t stations);
+
+    // 'open': client sockets in use besides this request's
+    AdmissionResult admit(uint32_t address, bool control, uint8_t open, uint32_t now);
+
+    uint8_t socketLimit() const { return _socketLimit; }
+    uint32_t limited() const { return _limited; }   // Answered 429
+    uint32_t busy() const { return _busy; }         // Answered 503
+
+private:
+    struct Bucket {
+        uint32_t address;       // 0 = free
+        uint32_t tokens;        // In 1/1000 requests
+        uint32_t stamp;         // millis() of the last refill
+    };
+
+    Bucket _buckets[DASHBOARD_RATE_CLIENTS];
+    uint8_t _socketLimit;
+    volatile uint32_t _limited;
+    volatile uint32_t _busy;
+
+    Bucket& bucket(uint32_t address, uint32_t now);
+};
+
+#endif // DASHBOARD_ADMISSION_H
@@ -0,0 +1,37 @@
+/*
+ * DashboardBoot.cpp
+ *
+ * Boot stage timestamps.
+ */
+
+#include "DashboardBoot.h"
+#include <esp_timer.h>
+
+static const char* const BOOT_NAMES[BOOT_STAGES] = {
+    "control", "begin", "loop", "wifi", "server", "first_request", "first_page"
+};
+
+volatile uint32_t DashboardBoot::_stamps[BOOT_STAGES];
+
+void DashboardBoot::mark(BootStage stage) {
+    if (stage < BOOT_STAGES && _stamps[stage] == 0) {
+        uint32_t now = (uint32_t)esp_timer_get_time();
+        _stamps[stage] = now ? now : 1;
+    }
+}
+
+const char* DashboardBoot::name(BootStage stage) {
+    return stage < BOOT_STAGES ? BOOT_NAMES[stage] : "";
+}
+
+void DashboardBoot::print(Print& out) {
+    out.print("Boot:");
+    for (uint8_t stage = 0; stage < BOOT_STAGES; stage++) {
+        uint32_t us = _stamps[stage];
+        if (us) {
+            out.printf(" %s %lu.%lu ms", BOOT_NAMES[stage], (unsigned long)(us / 1000),
+                       (unsigned long)(us % 1000 / 100));
+        }
+    }
+    out.println();
+}
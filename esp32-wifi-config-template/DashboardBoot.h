@@ -0,0 +1,58 @@
+/*
+ * DashboardBoot.h
+ *
+ * Startup timeline: when each boot stage was first reached, in
+ * microseconds since the application started (the ROM and bootloader
+ * time before that is not counted). The dashboard marks its own stages;
+ * the sketch marks BOOT_CONTROL once its outputs are in a safe state:
+ *
+ *   void setup() {
+ *       pinMode(RELAY_PIN, OUTPUT);
+ *       digitalWrite(RELAY_PIN, LOW);      // Safe state first
+ *       DashboardBoot::mark(BOOT_CONTROL);
+ *       ...
+ *       config.deferStart = true;
+ *       dashboard.begin(config);           // Returns at once
+ *   }
+ *
+ * With deferStart, dashboard.begin() only starts a task that brings up
+ * WiFi and the server, so setup() and loop() go on with control
+ * meanwhile (without it, begin() returns once the server listens). The
+ * timeline is printed once the server listens and is in /api/metrics
+ * as dashboard_boot_stage_seconds{stage="..."}. Time to first page
+ * includes the time a phone takes to join and ask for it.
+ */
+
+#ifndef DASHBOARD_BOOT_H
+#define DASHBOARD_BOOT_H
+
+#include <Arduino.h>
+
+enum BootStage : uint8_t {
+    BOOT_CONTROL,               // Outputs safe (marked by the sketch)
+    BOOT_BEGIN,                 // dashboard.begin() returned
+    BOOT_LOOP,                  // First dashboard loop()
+    BOOT_WIFI,                  // Soft-AP / station started
+    BOOT_SERVER,                // HTTP server listening
+    BOOT_FIRST_REQUEST,         // First request served
+    BOOT_FIRST_PAGE,            // First page (/) served
+    BOOT_STAGES
+};
+
+class DashboardBoot {
+public:
+    // Record 'stage' the first time it is reached (any task)
+    static void mark(BootStage stage);
+
+    // us since start, 0 = not reached yet
+    static uint32_t at(BootStage stage) { return stage < BOOT_STAGES ? _stamps[stage] : 0; }
+    static const char* name(BootStage stage);
+
+    // The stages reached so far, on one line
+    static void print(Print& out);
+
+private:
+    static volatile uint32_t _stamps[BOOT_STAGES];
+};
+
+#endif // DASHBOARD_BOOT_H
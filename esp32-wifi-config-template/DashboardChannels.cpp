@@ -0,0 +1,114 @@
+/*
+ * DashboardChannels.cpp
+ *
+ * Channel table implementation.
+ */
+
+#include "DashboardChannels.h"
+#include <math.h>
+
+ChannelTableBase::ChannelTableBase(DashboardChannel* channels, ChannelDeadband* deadbands,
+                                   uint8_t capacity) {
+    _channels = channels;
+    _deadbands = deadbands;
+    _capacity = capacity;
+    _count = 0;
+    _metaVersion = 0;
+    _version = 0;
+    _changed = 0;
+}
+
+uint8_t ChannelTableBase::add(const char* label, const char* unit, uint8_t flags) {
+    if (_count >= _capacity) {
+        return CHANNEL_INVALID;
+    }
+
+    DashboardChannel& channel = _channels[_count];
+    channel.id = _count;
+    channel.flags = flags;
+    channel.label = label;
+    channel.unit = unit ? unit : "";
+    channel.value = 0;
+    _deadbands[_count].absolute = 0;
+    _deadbands[_count].relative = 0;
+
+    _metaVersion++;
+    _changed |= 1UL << _count;
+    return _count++;
+}
+
+uint8_t ChannelTableBase::addOutput(const char* label, uint8_t flags) {
+    return add(label, "", flags | CHANNEL_OUTPUT);
+}
+
+// Different enough from 'last' to count as a change
+static bool exceeds(float last, float value, const ChannelDeadband& deadband) {
+    if (isnan(value) || isnan(last)) {
+        return isnan(value) != isnan(last);
+    }
+    float band = deadband.relative * fabsf(last);
+    if (band < deadband.absolute) band = deadband.absolute;
+    return fabsf(value - last) > band;
+}
+
+bool ChannelTableBase::setValue(uint8_t id, float value) {
+    if (!valid(id) || !exceeds(_channels[id].value, value, _deadbands[id])) {
+        return false;
+    }
+    _channels[id].value = value;
+    _changed |= 1UL << id;
+    _version++;
+    return true;
+}
+
+bool ChannelTableBase::setState(uint8_t id, bool state) {
+    return setValue(id, state ? 1.0f : 0.0f);
+}
+
+void ChannelTableBase::setDeadband(uint8_t id, float absolute, float relative) {
+    if (valid(id)) {
+        _deadbands[id].absolute = absolute > 0 ? absolute : 0;
+        _deadbands[id].relative = relative > 0 ? relative : 0;
+    }
+}
+
+uint32_t ChannelTableBase::takeChanged() {
+    uint32_t changed = _changed;
+    _changed = 0;
+    return changed;
+}
+
+float ChannelTableBase::value(uint8_t id) const {
+    return valid(id) ? _channels[id].value : 0;
+}
+
+bool ChannelTableBase::state(uint8_t id) const {
+    return value(id) != 0;
+}
+
+void ChannelTableBase::setLabel(uint8_t id, const char* label) {
+    if (valid(id) && _channels[id].label != label) {
+        _channels[id].label = label;
+        _metaVersion++;
+    }
+}
+
+void ChannelTableBase::setUnit(uint8_t id, const char* unit) {
+    if (valid(id) && _channels[id].unit != unit) {
+        _channels[id].unit = unit;
+        _metaVersion++;
+    }
+}
+
+void ChannelTableBase::setVisible(uint8_t id, bool visible) {
+    if (!valid(id)) {
+        return;
+    }
+
+    uint8_t flags = visible ? (_channels[id].flags | CHANNEL_VISIBLE)
+                            : (_channels[id].flags & ~CHANNEL_VISIBLE);
+    if (flags != _channels[id].flags) {
+        _channels[id].flags = flags;
+        _metaVersion++;
+    }
+}
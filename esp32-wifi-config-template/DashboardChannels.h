@@ -0,0 +1,148 @@
+/*
+ * DashboardChannels.h
+ *
+ * Fixed-capacity channel table for WebDashboard.
+ *
+ * Every value shown on the dashboard is a channel: a sensor reading or
+ * an on/off output. The table is a plain array sized by a template
+ * parameter, so it lives wherever you declare it (global, static) and
+ * never touches the heap:
+ *
+ *   ChannelTable<8> channels;
+ *
+ *   uint8_t chTemp = channels.add("Temperature", "°C");
+ *   uint8_t chFan  = channels.addOutput("Fan");
+ *
+ *   channels.setValue(chTemp, 23.5);
+ *   channels.setState(chFan, true);
+ *
+ * A deadband keeps noise from counting as a change: setValue() only
+ * takes a new value if it differs from the last one taken by more than
+ * the absolute band or the relative band times that value:
+ *
+ *   channels.setDeadband(chTemp, 0.2);         // +/- 0.2 °C
+ *   channels.setDeadband(chLevel, 0, 0.01);    // +/- 1 %
+ *
+ * Each accepted change marks the channel dirty; WebDashboard::publish()
+ * only hands out a new state (SSE push, history, ...) when something
+ * is dirty. Without a deadband any change counts.
+ *
+ * Channel ids are assigned in the order channels are added (0, 1, ...).
+ * Labels and units are stored as pointers and must stay valid (use
+ * string literals). A table may only be modified by the task that
+ * calls WebDashboard::publish().
+ */
+
+#ifndef DASHBOARD_CHANNELS_H
+#define DASHBOARD_CHANNELS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Upper bound for any channel table used with WebDashboard; sizes the
+// published snapshot. Override with -DWEBDASHBOARD_MAX_CHANNELS=32.
+#ifndef WEBDASHBOARD_MAX_CHANNELS
+#define WEBDASHBOARD_MAX_CHANNELS 16
+#endif
+
+static_assert(WEBDASHBOARD_MAX_CHANNELS <= 32, "Dirty bits hold at most 32 channels");
+
+// Copy text that goes into JSON unescaped (a mode, a peer name), with
+// '_' for the characters that would need escaping. Always terminated.
+inline size_t copyJsonSafe(char* out, size_t size, const char* text) {
+    size_t length = 0;
+    while (text && text[length] && length < size - 1) {
+        char c = text[length];
+        out[length++] = (c == '"' || c == '\\' || (uint8_t)c < 0x20) ? '_' : c;
+    }
+    out[length] = '\0';
+    return length;
+}
+
+// Channel flags
+enum ChannelFlags : uint8_t {
+    CHANNEL_HIDDEN  = 0x00,     // Not shown on the dashboard
+    CHANNEL_VISIBLE = 0x01,     // Shown on the dashboard
+    CHANNEL_OUTPUT  = 0x02      // On/off output (value 0/1) with buttons
+};
+
+struct DashboardChannel {
+    uint8_t id;
+    uint8_t flags;              // ChannelFlags
+    const char* label;
+    const char* unit;
+    float value;
+};
+
+// Change threshold of one channel (see setDeadband())
+struct ChannelDeadband {
+    float absolute;
+    float relative;
+};
+
+#define CHANNEL_INVALID 0xFF    // Returned by add() when the table is full
+
+class ChannelTableBase {
+public:
+    // Add a channel; returns its id, or CHANNEL_INVALID if full
+    uint8_t add(const char* label, const char* unit, uint8_t flags = CHANNEL_VISIBLE);
+    uint8_t addOutput(const char* label, uint8_t flags = CHANNEL_VISIBLE);
+
+    // Values (cheap, call as often as you like). setValue() returns
+    // whether the value changed by more than the deadband.
+    bool setValue(uint8_t id, float value);
+    bool setState(uint8_t id, bool state);
+    float value(uint8_t id) const;
+    bool state(uint8_t id) const;
+
+    // Ignore changes up to max(absolute, relative * |value|)
+    void setDeadband(uint8_t id, float absolute, float relative = 0);
+
+    // Bit n set = channel n changed since the last takeChanged()
+    uint32_t changed() const { return _changed; }
+    uint32_t takeChanged();
+
+    // Number of accepted value changes so far
+    uint32_t version() const { return _version; }
+
+    // Metadata (bumps metaVersion() when something actually changes)
+    void setLabel(uint8_t id, const char* label);
+    void setUnit(uint8_t id, const char* unit);
+    void setVisible(uint8_t id, bool visible);
+
+    uint8_t count() const { return _count; }
+    uint8_t capacity() const { return _capacity; }
+    bool valid(uint8_t id) const { return id < _count; }
+    bool isOutput(uint8_t id) const { return valid(id) && (_channels[id].flags & CHANNEL_OUTPUT); }
+    const DashboardChannel& channel(uint8_t id) const { return _channels[id]; }
+
+    // Changes whenever a label, unit or flag changes
+    uint32_t metaVersion() const { return _metaVersion; }
+
+protected:
+    ChannelTableBase(DashboardChannel* channels, ChannelDeadband* deadbands, uint8_t capacity);
+
+private:
+    DashboardChannel* _channels;
+    ChannelDeadband* _deadbands;
+    uint8_t _capacity;
+    uint8_t _count;
+    uint32_t _metaVersion;
+    uint32_t _version;
+    uint32_t _changed;
+};
+
+template <uint8_t N>
+class ChannelTable : public ChannelTableBase {
+    static_assert(N > 0 && N <= WEBDASHBOARD_MAX_CHANNELS,
+                  "ChannelTable capacity must be 1..WEBDASHBOARD_MAX_CHANNELS");
+
+public:
+    ChannelTable() : ChannelTableBase(_storage, _deadbandStorage, N) {}
+
+private:
+    DashboardChannel _storage[N];
+    ChannelDeadband _deadbandStorage[N];
+};
+
+#endif // DASHBOARD_CHANNELS_H
@@ -0,0 +1,220 @@
+/*
+ * DashboardDht.cpp
+ *
+ * DHT start pulse on an esp_timer, reply captured by the RMT, decoding.
+ */
+
+#include "DashboardDht.h"
+#include <driver/gpio.h>
+
+#define DHT_TICK_HZ 1000000         // RMT resolution: 1 us
+#define DHT_IDLE_US 200             // Line high this long = reply over
+#define DHT_FILTER_NS 1250          // Glitches shorter than this are ignored
+#define DHT_START_US_22 1100
+#define DHT_START_US_11 18000
+
+// Reply timing (us): 80 low + 80 high, then per bit 50 low and
+// 26-28 high for a 0 or 70 high for a 1
+#define DHT_ACK_MIN 60
+#define DHT_ACK_MAX 110
+#define DHT_BIT_THRESHOLD 48
+#define DHT_BIT_MAX 100
+
+enum DhtState : uint8_t {
+    DHT_IDLE,
+    DHT_STARTING,
+    DHT_CAPTURING
+};
+
+DhtSensor::DhtSensor(uint8_t pin, uint8_t model) {
+    _pin = pin;
+    _model = model == DHT_MODEL_11 ? DHT_MODEL_11 : DHT_MODEL_22;
+    _rmtChannel = DASHBOARD_DHT_RMT_CHANNEL;
+    _state = DHT_IDLE;
+    _timer = nullptr;
+    _error = "";
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    _channel = nullptr;
+    _received = 0;
+    _captured = false;
+#else
+    _ring = nullptr;
+#endif
+}
+
+bool DhtSensor::begin() {
+    esp_timer_create_args_t timer = {};
+    timer.callback = release;
+    timer.arg = this;
+    timer.name = "dht";
+    if (esp_timer_create(&timer, &_timer) != ESP_OK) {
+        _error = "no timer";
+        return false;
+    }
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    rmt_rx_channel_config_t config = {};
+    config.gpio_num = (gpio_num_t)_pin;
+    config.clk_src = RMT_CLK_SRC_DEFAULT;
+    config.resolution_hz = DHT_TICK_HZ;
+    config.mem_block_symbols = SOC_RMT_MEM_WORDS_PER_CHANNEL;
+    if (rmt_new_rx_channel(&config, &_channel) != ESP_OK) {
+        _error = "no RMT channel";
+        return false;
+    }
+    rmt_rx_event_callbacks_t callbacks = {};
+    callbacks.on_recv_done = onReceived;
+    rmt_rx_register_event_callbacks(_channel, &callbacks, this);
+    rmt_enable(_channel);
+#else
+    rmt_config_t config = RMT_DEFAULT_CONFIG_RX((gpio_num_t)_pin, (rmt_channel_t)_rmtChannel);
+    config.clk_div = 80;                            // APB 80 MHz -> 1 us ticks
+    config.mem_block_num = 1;
+    config.rx_config.filter_en = true;
+    config.rx_config.filter_ticks_thresh = DHT_FILTER_NS / 12;  // APB cycles (12.5 ns)
+    config.rx_config.idle_threshold = DHT_IDLE_US;
+    if (rmt_config(&config) != ESP_OK
+        || rmt_driver_install((rmt_channel_t)_rmtChannel, DHT_SYMBOLS * sizeof(rmt_item32_t) * 2, 0) != ESP_OK) {
+        _error = "no RMT channel";
+        return false;
+    }
+    rmt_get_ringbuf_handle((rmt_channel_t)_rmtChannel, &_ring);
+#endif
+
+    // The RMT listens through the GPIO matrix; drive the pin open-drain
+    gpio_set_direction((gpio_num_t)_pin, GPIO_MODE_INPUT_OUTPUT_OD);
+    gpio_set_pull_mode((gpio_num_t)_pin, GPIO_PULLUP_ONLY);
+    gpio_set_level((gpio_num_t)_pin, 1);
+    return true;
+}
+
+bool DhtSensor::start() {
+    if (!_timer || _state != DHT_IDLE) {
+        _error = _timer ? "busy" : "not started";
+        return false;
+    }
+    _state = DHT_STARTING;
+    gpio_set_level((gpio_num_t)_pin, 0);
+    esp_timer_start_once(_timer, _model == DHT_MODEL_11 ? DHT_START_US_11 : DHT_START_US_22);
+    return true;
+}
+
+// esp_timer task: end the start pulse with the receiver already armed
+void DhtSensor::release(void* arg) {
+    DhtSensor* dht = static_cast<DhtSensor*>(arg);
+    if (dht->_state != DHT_STARTING) {
+        return;                     // Cancelled meanwhile
+    }
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    rmt_receive_config_t receive = {};
+    receive.signal_range_min_ns = DHT_FILTER_NS;
+    receive.signal_range_max_ns = DHT_IDLE_US * 1000;
+    dht->_captured = false;
+    rmt_receive(dht->_channel, dht->_symbols, sizeof(dht->_symbols), &receive);
+#else
+    rmt_rx_start((rmt_channel_t)dht->_rmtChannel, true);
+#endif
+    dht->_state = DHT_CAPTURING;
+    gpio_set_level((gpio_num_t)dht->_pin, 1);
+}
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+bool IRAM_ATTR DhtSensor::onReceived(rmt_channel_handle_t channel,
+                                     const rmt_rx_done_event_data_t* data, void* arg) {
+    DhtSensor* dht = static_cast<DhtSensor*>(arg);
+    dht->_received = data->num_symbols;
+    dht->_captured = true;
+    return false;
+}
+#endif
+
+SensorStatus DhtSensor::poll(float* values) {
+    if (_state != DHT_CAPTURING) {
+        return _state == DHT_STARTING ? SENSOR_BUSY : SENSOR_FAILED;
+    }
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    if (!_captured) {
+        return SENSOR_BUSY;
+    }
+    _state = DHT_IDLE;
+    return decode((const uint32_t*)_symbols, _received, values);
+#else
+    size_t size = 0;
+    void* items = xRingbufferReceive(_ring, &size, 0);
+    if (!items) {
+        return SENSOR_BUSY;
+    }
+    SensorStatus status = decode((const uint32_t*)items, size / sizeof(rmt_item32_t), values);
+    vRingbufferReturnItem(_ring, items);
+    rmt_rx_stop((rmt_channel_t)_rmtChannel);
+    _state = DHT_IDLE;
+    return status;
+#endif
+}
+
+void DhtSensor::cancel() {
+    uint8_t state = _state;
+    _state = DHT_IDLE;
+    esp_timer_stop(_timer);
+    if (state == DHT_CAPTURING) {
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+        // No reply: restart the channel to drop the pending receive
+        rmt_disable(_channel);
+        rmt_enable(_channel);
+#else
+        rmt_rx_stop((rmt_channel_t)_rmtChannel);
+#endif
+    }
+    gpio_set_level((gpio_num_t)_pin, 1);
+    _error = "no reply";
+}
+
+// RMT items and symbols share one layout: duration0:15, level0:1,
+// duration1:15, level1:1
+SensorStatus DhtSensor::decode(const uint32_t* words, size_t count, float* values) {
+    uint8_t bytes[5] = {0, 0, 0, 0, 0};
+    int bit = -1;               // -1 = waiting for the 80 us acknowledge
+
+    for (size_t i = 0; i < count * 2 && bit < 40; i++) {
+        uint32_t half = i % 2 ? words[i / 2] >> 16 : words[i / 2] & 0xFFFF;
+        uint32_t duration = half & 0x7FFF;
+        bool high = (half >> 15) & 1;
+        if (duration == 0) {
+            break;              // End of the capture
+        }
+        if (!high) {
+            continue;           // Low phases carry no data
+        }
+        if (bit < 0) {
+            if (duration >= DHT_ACK_MIN && duration <= DHT_ACK_MAX) bit = 0;
+            continue;
+        }
+        if (duration > DHT_BIT_MAX) {
+            _error = "bad pulse";
+            return SENSOR_FAILED;
+        }
+        bytes[bit / 8] = (uint8_t)(bytes[bit / 8] << 1 | (duration > DHT_BIT_THRESHOLD ? 1 : 0));
+        bit++;
+    }
+
+    if (bit < 40) {
+        _error = bit < 0 ? "no reply" : "short reply";
+        return SENSOR_FAILED;
+    }
+    if ((uint8_t)(bytes[0] + bytes[1] + bytes[2] + bytes[3]) != bytes[4]) {
+        _error = "checksum";
+        return SENSOR_FAILED;
+    }
+
+    if (_model == DHT_MODEL_11) {
+        values[1] = bytes[0] + bytes[1] / 10.0f;
+        values[0] = (bytes[2] & 0x7F) + bytes[3] / 10.0f;
+        if (bytes[2] & 0x80) values[0] = -values[0];
+    } else {
+        values[1] = (bytes[0] << 8 | bytes[1]) / 10.0f;
+        values[0] = ((bytes[2] & 0x7F) << 8 | bytes[3]) / 10.0f;
+        if (bytes[2] & 0x80) values[0] = -values[0];
+    }
+    return SENSOR_OK;
+}
@@ -0,0 +1,91 @@
+/*
+ * DashboardDht.h
+ *
+ * DHT11 / DHT22 (AM2302) SensorDriver that never disables interrupts.
+ * The usual driver (the DHT library) times the 40-bit reply in a busy
+ * loop with interrupts off, for about 5 ms per read; here the RMT
+ * peripheral captures the pulse widths and the driver decodes them
+ * afterwards:
+ *
+ *   start()    drive the line low; an esp_timer releases it after the
+ *              start pulse (1.1 ms DHT22, 18 ms DHT11) and arms the RMT
+ *   poll()     SENSOR_BUSY until the capture is complete, then decode
+ *              and check the checksum
+ *
+ * Values: 0 = temperature (°C), 1 = relative humidity (%).
+ *
+ * The pin is used open-drain; the module's pull-up (or a 10 kOhm one to
+ * 3.3 V) holds it high. With Arduino core 2.x (legacy RMT driver) the
+ * RMT channel is fixed, DASHBOARD_DHT_RMT_CHANNEL or setRmtChannel();
+ * core 3.x allocates one.
+ */
+
+#ifndef DASHBOARD_DHT_H
+#define DASHBOARD_DHT_H
+
+#include <esp_idf_version.h>
+#include <esp_timer.h>
+#include "DashboardSensors.h"
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+#include <driver/rmt_rx.h>
+#else
+#include <driver/rmt.h>
+#endif
+
+// Same values as the DHT library's DHT11 / DHT22 macros
+#define DHT_MODEL_11 11
+#define DHT_MODEL_22 22
+
+#ifndef DASHBOARD_DHT_RMT_CHANNEL
+#if CONFIG_IDF_TARGET_ESP32C3 || CONFIG_IDF_TARGET_ESP32S2
+#define DASHBOARD_DHT_RMT_CHANNEL 2     // First channel that can receive
+#else
+#define DASHBOARD_DHT_RMT_CHANNEL 4
+#endif
+#endif
+
+#define DHT_SYMBOLS 64                  // Capture buffer (a reply is ~43)
+
+class DhtSensor : public SensorDriver {
+public:
+    explicit DhtSensor(uint8_t pin, uint8_t model = DHT_MODEL_22);
+
+    // Legacy RMT driver only; call before begin()
+    void setRmtChannel(uint8_t channel) { _rmtChannel = channel; }
+
+    const char* name() const { return _model == DHT_MODEL_11 ? "dht11" : "dht22"; }
+    uint8_t valueCount() const { return 2; }
+    uint32_t minInterval() const { return _model == DHT_MODEL_11 ? 1000 : 2000; }
+
+    bool begin();
+    bool start();
+    SensorStatus poll(float* values);
+    void cancel();
+    const char* error() const { return _error; }
+
+private:
+    uint8_t _pin;
+    uint8_t _model;
+    uint8_t _rmtChannel;
+    volatile uint8_t _state;    // 0 = idle, 1 = start pulse, 2 = capturing
+    esp_timer_handle_t _timer;
+    const char* _error;
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    rmt_channel_handle_t _channel;
+    rmt_symbol_word_t _symbols[DHT_SYMBOLS];
+    volatile size_t _received;
+    volatile bool _captured;
+
+    static bool onReceived(rmt_channel_handle_t channel,
+                           const rmt_rx_done_event_data_t* data, void* arg);
+#else
+    RingbufHandle_t _ring;
+#endif
+
+    static void release(void* arg);
+    SensorStatus decode(const uint32_t* words, size_t count, float* values);
+};
+
+#endif // DASHBOARD_DHT_H
@@ -0,0 +1,119 @@
+/*
+ * DashboardEvents.cpp
+ *
+ * Server-Sent Events transport for both server backends.
+ */
+
+#include "DashboardEvents.h"
+#if !WEBDASHBOARD_ASYNC
+#include <lwip/sockets.h>
+#endif
+
+DashboardEvents::DashboardEvents() : _resync(false) {
+#if WEBDASHBOARD_ASYNC
+    _source = nullptr;
+#else
+    for (uint8_t i = 0; i < DASHBOARD_MAX_EVENT_CLIENTS; i++) {
+        _active[i] = false;
+    }
+#endif
+}
+
+bool DashboardEvents::takeResync() {
+    return _resync.exchange(false);
+}
+
+#if WEBDASHBOARD_ASYNC
+
+// ==================== ASYNC BACKEND ====================
+
+void DashboardEvents::begin(DashboardServer* server, const char* path) {
+    _source = new AsyncEventSource(path);
+    _source->onConnect([this](AsyncEventSourceClient* client) {
+        // Runs on the AsyncTCP task; the full state goes out from loop()
+        _resync = true;
+    });
+    server->addHandler(_source);
+}
+
+void DashboardEvents::send(const char* event, const char* data, uint32_t id) {
+    if (_source) {
+        _source->send(data, event, id);
+    }
+}
+
+uint8_t DashboardEvents::count() {
+    return _source ? _source->count() : 0;
+}
+
+#else
+
+// ==================== WEBSERVER BACKEND ====================
+
+void DashboardEvents::begin(DashboardServer* server, const char* path) {
+    // The route itself is registered by WebDashboard, which calls accept()
+}
+
+bool DashboardEvents::accept(WiFiClient client) {
+    for (uint8_t i = 0; i < DASHBOARD_MAX_EVENT_CLIENTS; i++) {
+        if (!_active[i] || !_clients[i].connected()) {
+            client.print("HTTP/1.1 200 OK\r\n"
+                         "Content-Type: text/event-stream\r\n"
+                         "Cache-Control: no-cache\r\n"
+                         "Connection: keep-alive\r\n"
+                         "\r\n"
+                         "retry: 2000\n\n");
+            // Our copy keeps the socket open after WebServer drops its own
+            _clients[i] = client;
+            _active[i] = true;
+            _resync = true;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Queue all of 'len' without waiting: a client whose TCP window is full
+// gets a short write (or none) instead of stalling the serving task
+static bool eventWrite(WiFiClient& client, const void* buf, size_t len) {
+    int sent = ::send(client.fd(), buf, len, MSG_DONTWAIT);
+    return sent == (int)len;
+}
+
+void DashboardEvents::send(const char* event, const char* data, uint32_t id) {
+    char head[48];
+    int headLen = snprintf(head, sizeof(head), "id: %lu\nevent: %s\ndata: ",
+                           (unsigned long)id, event);
+    size_t dataLen = strlen(data);
+
+    for (uint8_t i = 0; i < DASHBOARD_MAX_EVENT_CLIENTS; i++) {
+        if (!_active[i]) continue;
+
+        WiFiClient& client = _clients[i];
+        bool ok = client.connected()
+            && eventWrite(client, head, headLen)
+            && eventWrite(client, data, dataLen)
+            && eventWrite(client, "\n\n", 2);
+
+        if (!ok) {
+            // Closed, or stalled with part of a frame out: free the slot.
+            // The browser reconnects after 'retry' and gets the full state.
+            client.stop();
+            _active[i] = false;
+        }
+    }
+}
+
+uint8_t DashboardEvents::count() {
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < DASHBOARD_MAX_EVENT_CLIENTS; i++) {
+        if (_active[i] && !_clients[i].connected()) {
+            _clients[i].stop();
+            _active[i] = false;
+        }
+        if (_active[i]) n++;
+    }
+    return n;
+}
+
+#endif // WEBDASHBOARD_ASYNC
@@ -0,0 +1,61 @@
+/*
+ * DashboardEvents.h
+ *
+ * Server-Sent Events (SSE) transport for WebDashboard (/api/events).
+ *
+ * Browsers keep one connection open and the device pushes small
+ * "event: <name>\ndata: <json>\n\n" frames to it, instead of the page
+ * polling /api/status.
+ *
+ *   - WebServer backend: the request's socket is kept open after the
+ *     handler returns; up to DASHBOARD_MAX_EVENT_CLIENTS are tracked.
+ *     send() must be called from the task that runs handleClient().
+ *     Frames are written without blocking; a client that cannot take a
+ *     whole frame (full TCP window) is dropped rather than stalling the
+ *     other clients, and reconnects on its own.
+ *   - Async backend: wraps AsyncEventSource, which queues per client.
+ *
+ * Only transport lives here; WebDashboard decides what to send.
+ */
+
+#ifndef DASHBOARD_EVENTS_H
+#define DASHBOARD_EVENTS_H
+
+#include <atomic>
+#include "DashboardRequest.h"
+
+#define DASHBOARD_MAX_EVENT_CLIENTS 4    // Open SSE streams (WebServer backend)
+
+class DashboardEvents {
+public:
+    DashboardEvents();
+
+    // Register the stream endpoint (async) / prepare (WebServer)
+    void begin(DashboardServer* server, const char* path);
+
+#if !WEBDASHBOARD_ASYNC
+    // Take over the socket of the current request. Returns false if all
+    // client slots are in use (the request is then answered normally).
+    bool accept(WiFiClient client);
+#endif
+
+    // Send one event to every connected client
+    void send(const char* event, const char* data, uint32_t id);
+
+    // Number of connected clients (drops closed ones first)
+    uint8_t count();
+
+    // True once after a client connected (it needs the full state)
+    bool takeResync();
+
+private:
+#if WEBDASHBOARD_ASYNC
+    AsyncEventSource* _source;
+#else
+    WiFiClient _clients[DASHBOARD_MAX_EVENT_CLIENTS];
+    bool _active[DASHBOARD_MAX_EVENT_CLIENTS];
+#endif
+    std::atomic<bool> _resync;
+};
+
+#endif // DASHBOARD_EVENTS_H
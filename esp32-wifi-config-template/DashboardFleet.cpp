@@ -0,0 +1,259 @@
+/*
+ * DashboardFleet.cpp
+ *
+ * Peer discovery, polling task and the /api/fleet output.
+ */
+
+#include "DashboardFleet.h"
+#include "DashboardChannels.h"         // copyJsonSafe()
+#include <ArduinoJson.h>
+#include <ESPmDNS.h>
+
+#define FLEET_TASK_STACK 4096
+
+FleetBase::FleetBase(FleetPeer* peers, uint8_t capacity) {
+    _peers = peers;
+    _capacity = capacity;
+    _count = 0;
+    _dropped = 0;
+    portMUX_TYPE unlocked = portMUX_INITIALIZER_UNLOCKED;
+    _lock = unlocked;
+    _task = nullptr;
+}
+
+// Under _lock
+int8_t FleetBase::find(uint32_t ip) const {
+    for (uint8_t i = 0; i < _count; i++) {
+        if (_peers[i].ip == ip) return i;
+    }
+    return -1;
+}
+
+bool FleetBase::addPeer(IPAddress ip, const char* name) {
+    FleetPeer peer;
+    memset(&peer, 0, sizeof(peer));
+    peer.ip = (uint32_t)ip;
+
+    copyJsonSafe(peer.name, sizeof(peer.name), name);
+
+    bool added = false;
+    portENTER_CRITICAL(&_lock);
+    if (find(peer.ip) < 0 && _count < _capacity) {
+        _peers[_count] = peer;
+        _count++;
+        added = true;
+    }
+    portEXIT_CRITICAL(&_lock);
+    return added;
+}
+
+bool FleetBase::peer(uint8_t index, FleetPeer& out) const {
+    bool valid = false;
+    portENTER_CRITICAL(&_lock);
+    if (index < _count) {
+        out = _peers[index];
+        valid = true;
+    }
+    portEXIT_CRITICAL(&_lock);
+    return valid;
+}
+
+void FleetBase::begin(BaseType_t core, UBaseType_t priority) {
+    if (!_task) {
+        xTaskCreatePinnedToCore(taskMain, "fleet", FLEET_TASK_STACK, this, priority, &_task, core);
+    }
+}
+
+// ==================== POLLING ====================
+
+void FleetBase::taskMain(void* arg) {
+    FleetBase* fleet = static_cast<FleetBase*>(arg);
+    uint32_t lastDiscovery = 0;
+    bool discovered = false;
+
+    for (;;) {
+        uint32_t start = millis();
+        if (!discovered || start - lastDiscovery >= DASHBOARD_FLEET_DISCOVERY) {
+            fleet->discover();
+            lastDiscovery = millis();
+            discovered = true;
+        }
+
+        for (uint8_t i = 0; i < fleet->_count; i++) {
+            fleet->poll(i);
+        }
+
+        uint32_t elapsed = millis() - start;
+        vTaskDelay(pdMS_TO_TICKS(elapsed < DASHBOARD_FLEET_INTERVAL
+                                 ? DASHBOARD_FLEET_INTERVAL - elapsed : 1));
+    }
+}
+
+// Blocks for the mDNS query (about a second); runs on the fleet task only
+void FleetBase::discover() {
+    int found = MDNS.queryService("dashboard", "tcp");
+    for (int i = 0; i < found; i++) {
+#if defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 3
+        IPAddress ip = MDNS.address(i);
+#else
+        IPAddress ip = MDNS.IP(i);
+#endif
+        uint32_t address = (uint32_t)ip;
+        if (address == 0 || address == (uint32_t)WiFi.localIP()
+            || address == (uint32_t)WiFi.softAPIP()) {
+            continue;               // Not resolved, or this board
+        }
+
+        portENTER_CRITICAL(&_lock);
+        bool known = find(address) >= 0;
+        portEXIT_CRITICAL(&_lock);
+        if (!known && !addPeer(ip, MDNS.hostname(i).c_str())) {
+            _dropped++;
+        }
+    }
+}
+
+// The body is spliced into /api/fleet as it is: take only a JSON object,
+// not e.g. the HTML page of another service advertised the same way
+static bool fleetObject(const char* body, size_t length) {
+    while (length > 0 && (body[length - 1] == '\n' || body[length - 1] == '\r'
+                          || body[length - 1] == ' ')) {
+        length--;
+    }
+    if (length < 2 || body[0] != '{' || body[length - 1] != '}') {
+        return false;
+    }
+    StaticJsonDocument<16> skip;        // Keep nothing, check the syntax
+    skip.set(false);
+    StaticJsonDocument<16> doc;
+    return !deserializeJson(doc, body, length, DeserializationOption::Filter(skip));
+}
+
+void FleetBase::poll(uint8_t index) {
+    portENTER_CRITICAL(&_lock);
+    uint32_t ip = _peers[index].ip;
+    portEXIT_CRITICAL(&_lock);
+
+    uint32_t start = millis();
+    const char* body = nullptr;
+    size_t length = 0;
+    int status = fetch(ip, body, length);
+    uint32_t now = millis();
+    bool good = status == 200 && length < DASHBOARD_FLEET_VALUES && fleetObject(body, length);
+
+    portENTER_CRITICAL(&_lock);
+    FleetPeer& peer = _peers[index];
+    if (good) {
+        memcpy(peer.values, body, length);
+        peer.values[length] = '\0';
+        peer.length = length;
+        peer.rtt = now - start > 0xFFFF ? 0xFFFF : now - start;
+        peer.failures = 0;
+        peer.lastSeen = now ? now : 1;
+    } else if (peer.failures < 0xFFFF) {
+        peer.failures++;
+    }
+    portEXIT_CRITICAL(&_lock);
+}
+
+// GET /api/values from ip into _response. Returns the HTTP status (-1 on
+// a connection error, timeout or a response too large to keep).
+int FleetBase::fetch(uint32_t ip, const char*& body, size_t& length) {
+    WiFiClient client;
+    if (!client.connect(IPAddress(ip), 80, DASHBOARD_FLEET_TIMEOUT)) {
+        return -1;
+    }
+    client.print("GET /api/values HTTP/1.0\r\nConnection: close\r\n\r\n");
+
+    size_t used = 0;
+    bool complete = false;
+    uint32_t started = millis();
+    while (millis() - started < DASHBOARD_FLEET_TIMEOUT) {
+        int n = client.read((uint8_t*)_response + used, sizeof(_response) - 1 - used);
+        if (n > 0) {
+            used += n;
+            if (used >= sizeof(_response) - 1) break;   // Too large
+            continue;
+        }
+        if (!client.connected()) {
+            complete = true;        // Server closed: whole response read
+            break;
+        }
+        vTaskDelay(1);
+    }
+    client.stop();
+    _response[used] = '\0';
+
+    char* split = strstr(_response, "\r\n\r\n");
+    if (!complete || !split || strncmp(_response, "HTTP/1.", 7) != 0) {
+        return -1;
+    }
+    body = split + 4;
+    length = used - (body - _response);
+    return atoi(_response + 9);
+}
+
+// ==================== /api/fleet ====================
+
+size_t FleetBase::formatEntry(FleetCursor& cursor, const FleetPeer& peer) {
+    char age[12];
+    if (peer.lastSeen) {
+        snprintf(age, sizeof(age), "%lu", (unsigned long)((millis() - peer.lastSeen) / 1000));
+    } else {
+        strlcpy(age, "null", sizeof(age));
+    }
+
+    bool online = peer.lastSeen && peer.failures < DASHBOARD_FLEET_OFFLINE;
+    int n = snprintf(cursor.entry, sizeof(cursor.entry),
+                     "%s{\"ip\":\"%u.%u.%u.%u\",\"name\":\"%s\",\"online\":%s,\"age\":%s,"
+                     "\"rtt\":%u,\"failures\":%u,\"values\":%s}",
+                     cursor.index > 0 ? "," : "",
+                     (unsigned)(peer.ip & 0xFF), (unsigned)((peer.ip >> 8) & 0xFF),
+                     (unsigned)((peer.ip >> 16) & 0xFF), (unsigned)(peer.ip >> 24),
+                     peer.name, online ? "true" : "false", age, (unsigned)peer.rtt,
+                     (unsigned)peer.failures, peer.length ? peer.values : "null");
+    if (n < 0) return 0;
+    return (size_t)n < sizeof(cursor.entry) ? n : sizeof(cursor.entry) - 1;
+}
+
+// Each piece (head, one peer, tail) is formatted into cursor.entry and
+// copied out over as many calls as the buffers need
+size_t FleetBase::fill(FleetCursor& cursor, char* buffer, size_t size) {
+    size_t used = 0;
+    while (used < size) {
+        if (cursor.offset < cursor.length) {
+            size_t n = cursor.length - cursor.offset;
+            if (n > size - used) n = size - used;
+            memcpy(buffer + used, cursor.entry + cursor.offset, n);
+            cursor.offset += n;
+            used += n;
+            continue;
+        }
+
+        cursor.offset = 0;
+        cursor.length = 0;
+        int n = 0;
+        if (cursor.part == 0) {
+            n = snprintf(cursor.entry, sizeof(cursor.entry),
+                         "{\"count\":%u,\"interval\":%u,\"peers\":[",
+                         (unsigned)cursor.fleet->count(), (unsigned)DASHBOARD_FLEET_INTERVAL);
+            cursor.part = 1;
+        } else if (cursor.part == 1) {
+            FleetPeer peer;
+            if (cursor.fleet->peer(cursor.index, peer)) {
+                n = formatEntry(cursor, peer);
+                cursor.index++;
+            } else {
+                cursor.part = 2;
+            }
+        } else if (cursor.part == 2) {
+            n = snprintf(cursor.entry, sizeof(cursor.entry), "],\"dropped\":%lu}",
+                         (unsigned long)cursor.fleet->dropped());
+            cursor.part = 3;
+        } else {
+            break;
+        }
+        cursor.length = n > 0 ? n : 0;
+    }
+    return used;
+}
@@ -0,0 +1,113 @@
+/*
+ * DashboardFleet.h
+ *
+ * Aggregator role: one board polls the compact /api/values of its peers
+ * and serves the combined view at /api/fleet, so a laptop needs one
+ * connection to watch a whole plant instead of one per board.
+ *
+ *   Fleet<48> fleet;                       // Room for 48 peers
+ *   fleet.addPeer(IPAddress(10, 0, 0, 21)); // Optional: fixed peers
+ *   dashboard.setFleet(fleet);             // Before begin()
+ *
+ * Peers are found over mDNS (every board advertises _dashboard._tcp)
+ * every DASHBOARD_FLEET_DISCOVERY ms and can also be added by address.
+ * A peer stays in the table once seen, so a board that drops off shows
+ * up as offline instead of disappearing.
+ *
+ * Polling runs in its own FreeRTOS task (one peer at a time, over plain
+ * HTTP/1.0, every DASHBOARD_FLEET_INTERVAL ms) and never touches the
+ * board's own loop(). Each peer's last body is stored verbatim (up to
+ * DASHBOARD_FLEET_VALUES bytes) and embedded as "values" in /api/fleet,
+ * so only a body that is a valid JSON object counts as an answer;
+ * labels and units come from the peer's own /api/meta.
+ *
+ * The table is shared between the polling task and the HTTP handler
+ * under a spinlock held only for a copy of one entry.
+ */
+
+#ifndef DASHBOARD_FLEET_H
+#define DASHBOARD_FLEET_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+
+#define DASHBOARD_FLEET_INTERVAL 5000       // ms between polls of every peer
+#define DASHBOARD_FLEET_DISCOVERY 60000     // ms between mDNS queries
+#define DASHBOARD_FLEET_TIMEOUT 1000        // ms per peer request
+#define DASHBOARD_FLEET_VALUES 256          // Longest /api/values body kept
+#define DASHBOARD_FLEET_NAME 32             // Peer name incl. '\0'
+#define DASHBOARD_FLEET_OFFLINE 3           // Failed polls before "online":false
+#define DASHBOARD_FLEET_ENTRY (DASHBOARD_FLEET_VALUES + 160)   // One peer as JSON
+
+struct FleetPeer {
+    uint32_t ip;                // IPv4, as IPAddress converts it
+    char name[DASHBOARD_FLEET_NAME];
+    char values[DASHBOARD_FLEET_VALUES];    // Last good body; length 0 = none yet
+    uint16_t length;
+    uint16_t rtt;               // ms, last good poll
+    uint16_t failures;          // Consecutive failed polls
+    uint32_t lastSeen;          // millis() of the last good poll, 0 = never
+};
+
+class FleetBase;
+
+// Position in a /api/fleet response (see DashboardRequest::sendChunked)
+struct FleetCursor {
+    const FleetBase* fleet;
+    uint8_t part;               // 0 = head, 1 = peers, 2 = tail, 3 = done
+    uint8_t index;              // Next peer
+    uint16_t length;            // Bytes in entry
+    uint16_t offset;            // Bytes of entry already sent
+    char entry[DASHBOARD_FLEET_ENTRY];
+};
+
+class FleetBase {
+public:
+    // Poll ip even if it never shows up in mDNS (name: shown instead of
+    // the address). False when the table is full.
+    bool addPeer(IPAddress ip, const char* name = nullptr);
+
+    uint8_t count() const { return _count; }
+    uint8_t capacity() const { return _capacity; }
+    uint32_t dropped() const { return _dropped; }   // Discovered, no room
+
+    // Consistent copy of one entry
+    bool peer(uint8_t index, FleetPeer& out) const;
+
+    // Start the polling task (WebDashboard::begin() does this)
+    void begin(BaseType_t core = 0, UBaseType_t priority = 1);
+
+    // sendChunked() filler for /api/fleet
+    static size_t fill(FleetCursor& cursor, char* buffer, size_t size);
+
+protected:
+    FleetBase(FleetPeer* peers, uint8_t capacity);
+
+private:
+    FleetPeer* _peers;
+    uint8_t _capacity;
+    volatile uint8_t _count;
+    uint32_t _dropped;
+    mutable portMUX_TYPE _lock;
+    TaskHandle_t _task;
+    char _response[DASHBOARD_FLEET_VALUES + 256];   // Headers + body (task only)
+
+    int8_t find(uint32_t ip) const;
+    void discover();
+    void poll(uint8_t index);
+    int fetch(uint32_t ip, const char*& body, size_t& length);
+    static void taskMain(void* arg);
+    static size_t formatEntry(FleetCursor& cursor, const FleetPeer& peer);
+};
+
+// Fleet of up to N peers
+template <uint8_t N>
+class Fleet : public FleetBase {
+public:
+    Fleet() : FleetBase(_storage, N) {}
+
+private:
+    FleetPeer _storage[N];
+};
+
+#endif // DASHBOARD_FLEET_H
@@ -0,0 +1,257 @@
+/*
+ * DashboardHistory.cpp
+ *
+ * Channel history ring buffers and rollup tiers.
+ */
+
+#include "DashboardHistory.h"
+#include <math.h>
+
+#define FIXED_NONE INT16_MIN        // int16_t sample without a value
+
+HistoryBase::HistoryBase(float* samples, uint8_t channels, uint16_t depth, float)
+    : _written(0), _writing(0) {
+    _floatSamples = samples;
+    _fixedSamples = nullptr;
+    _scale = 1;
+    _channels = channels;
+    _depth = depth;
+    _period = DASHBOARD_HISTORY_PERIOD;
+    _started = false;
+    _start = 0;
+    _nextDue = 0;
+    _tier = nullptr;
+}
+
+HistoryBase::HistoryBase(int16_t* samples, uint8_t channels, uint16_t depth, float scale)
+    : HistoryBase((float*)nullptr, channels, depth, scale) {
+    _fixedSamples = samples;
+    _scale = scale > 0 ? scale : 1;
+}
+
+void HistoryBase::setPeriod(uint32_t periodMs) {
+    _period = periodMs > 0 ? periodMs : 1;
+    updateTiers();
+}
+
+void HistoryBase::addTier(RollupBase& tier) {
+    RollupBase** link = &_tier;
+    while (*link) {
+        link = &(*link)->_next;
+    }
+    tier._next = nullptr;
+    *link = &tier;
+    updateTiers();
+}
+
+uint8_t HistoryBase::tiers() const {
+    uint8_t n = 0;
+    for (const RollupBase* tier = _tier; tier; tier = tier->_next) {
+        n++;
+    }
+    return n;
+}
+
+const RollupBase* HistoryBase::tier(uint8_t n) const {
+    const RollupBase* tier = _tier;
+    while (tier && --n > 0) {
+        tier = tier->_next;
+    }
+    return n == 0 ? tier : nullptr;
+}
+
+// Bucket periods follow from the raw period; all tiers share its grid
+void HistoryBase::updateTiers() {
+    uint32_t period = _period;
+    for (RollupBase* tier = _tier; tier; tier = tier->_next) {
+        period *= tier->_factor;
+        tier->_period = period;
+        tier->_start = _start;
+    }
+}
+
+uint32_t HistoryBase::first() const {
+    uint32_t written = end();
+    return written > _depth ? written - _depth : 0;
+}
+
+void HistoryBase::store(uint8_t channel, uint16_t slot, float value) {
+    size_t index = (size_t)channel * _depth + slot;
+    if (_floatSamples) {
+        _floatSamples[index] = value;
+        return;
+    }
+
+    if (isnan(value)) {
+        _fixedSamples[index] = FIXED_NONE;
+        return;
+    }
+    float scaled = value * _scale;
+    if (scaled > 32767) scaled = 32767;
+    if (scaled < -32767) scaled = -32767;
+    _fixedSamples[index] = (int16_t)lroundf(scaled);
+}
+
+void HistoryBase::record(const DashboardChannel* channels, uint8_t count, uint32_t now) {
+    if (!_started) {
+        _started = true;
+        _start = now;
+        _nextDue = now;
+        updateTiers();
+    }
+    if ((int32_t)(now - _nextDue) < 0) {
+        return;
+    }
+
+    // Grid slots due by now: more than one if publishing stalled
+    uint32_t due = (now - _nextDue) / _period + 1;
+    uint32_t written = _written.load(std::memory_order_relaxed);
+    uint32_t target = written + due;
+
+    // Same protocol as DashboardSnapshot: announce, then write
+    _writing.store(target, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // A long stall only has to rewrite the last depth samples
+    uint32_t from = (target - written > _depth) ? target - _depth : written;
+    for (uint32_t sample = from; sample != target; sample++) {
+        uint16_t slot = sample % _depth;
+        for (uint8_t channel = 0; channel < _channels; channel++) {
+            store(channel, slot, channel < count ? channels[channel].value : NAN);
+        }
+    }
+
+    _written.store(target, std::memory_order_release);
+    _nextDue += due * _period;
+
+    if (_tier) {
+        _tier->feed(channels, count, due);
+    }
+}
+
+bool HistoryBase::read(uint8_t channel, uint32_t sample, float& value) const {
+    uint32_t written = _written.load(std::memory_order_acquire);
+    if (channel >= _channels || sample >= written || written - sample > _depth) {
+        return false;
+    }
+
+    size_t index = (size_t)channel * _depth + sample % _depth;
+    if (_floatSamples) {
+        value = _floatSamples[index];
+    } else {
+        int16_t fixed = _fixedSamples[index];
+        value = fixed == FIXED_NONE ? NAN : fixed / _scale;
+    }
+
+    // Overwritten meanwhile if the writer got as far as sample + depth
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return _writing.load(std::memory_order_relaxed) - sample <= _depth;
+}
+
+// ==================== ROLLUP TIERS ====================
+
+static void resetSample(RollupSample& sample) {
+    sample.min = 0;
+    sample.max = 0;
+    sample.sum = 0;
+    sample.count = 0;
+}
+
+// Fold 'other' into 'sample'
+static void combine(RollupSample& sample, const RollupSample& other) {
+    if (other.count == 0) {
+        return;
+    }
+    if (sample.count == 0 || other.min < sample.min) sample.min = other.min;
+    if (sample.count == 0 || other.max > sample.max) sample.max = other.max;
+    sample.sum += other.sum;
+    sample.count += other.count;
+}
+
+RollupBase::RollupBase(RollupSample* buckets, RollupSample* current, uint8_t channels,
+                       uint16_t depth, uint16_t factor)
+    : _written(0), _writing(0) {
+    _buckets = buckets;
+    _current = current;
+    _channels = channels;
+    _depth = depth;
+    _factor = factor > 0 ? factor : 1;
+    _period = 0;
+    _start = 0;
+    _filled = 0;
+    _next = nullptr;
+
+    for (uint8_t channel = 0; channel < _channels; channel++) {
+        resetSample(_current[channel]);
+    }
+}
+
+uint32_t RollupBase::first() const {
+    uint32_t written = end();
+    return written > _depth ? written - _depth : 0;
+}
+
+// 'repeat' identical raw samples (more than one after a stall)
+void RollupBase::feed(const DashboardChannel* channels, uint8_t count, uint32_t repeat) {
+    while (repeat > 0) {
+        uint32_t take = _factor - _filled;
+        if (take > repeat) take = repeat;
+
+        for (uint8_t channel = 0; channel < _channels && channel < count; channel++) {
+            float value = channels[channel].value;
+            if (isnan(value)) continue;
+            RollupSample sample = { value, value, value * take, take };
+            combine(_current[channel], sample);
+        }
+
+        _filled += take;
+        repeat -= take;
+        if (_filled == _factor) {
+            flush();
+        }
+    }
+}
+
+// One completed bucket per channel from the tier below
+void RollupBase::merge(const RollupSample* samples, uint8_t count) {
+    for (uint8_t channel = 0; channel < _channels && channel < count; channel++) {
+        combine(_current[channel], samples[channel]);
+    }
+    if (++_filled == _factor) {
+        flush();
+    }
+}
+
+void RollupBase::flush() {
+    uint32_t written = _written.load(std::memory_order_relaxed);
+
+    // Same protocol as the raw samples: announce, write, publish
+    _writing.store(written + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    uint16_t slot = written % _depth;
+    for (uint8_t channel = 0; channel < _channels; channel++) {
+        _buckets[(size_t)channel * _depth + slot] = _current[channel];
+    }
+    _written.store(written + 1, std::memory_order_release);
+
+    if (_next) {
+        _next->merge(_current, _channels);
+    }
+    for (uint8_t channel = 0; channel < _channels; channel++) {
+        resetSample(_current[channel]);
+    }
+    _filled = 0;
+}
+
+bool RollupBase::read(uint8_t channel, uint32_t bucket, RollupSample& sample) const {
+    uint32_t written = _written.load(std::memory_order_acquire);
+    if (channel >= _channels || bucket >= written || written - bucket > _depth) {
+        return false;
+    }
+
+    sample = _buckets[(size_t)channel * _depth + bucket % _depth];
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return _writing.load(std::memory_order_relaxed) - bucket <= _depth;
+}
@@ -0,0 +1,186 @@
+/*
+ * DashboardHistory.h
+ *
+ * Fixed-size time-series history for WebDashboard channels.
+ *
+ * Every channel gets its own contiguous ring of samples, so reading one
+ * channel's trend walks memory linearly. Samples sit on a fixed time
+ * grid (one per period), which makes timestamps implicit:
+ *
+ *   time of sample n = start + n * period
+ *
+ * Declare it with the number of channels to record (ids 0..Channels-1),
+ * the samples kept per channel and the sample type:
+ *
+ *   DashboardHistory<3, 600> history;              // float, 7.2 KB
+ *   DashboardHistory<3, 600, int16_t> history(100); // 0.01 steps, 3.6 KB
+ *
+ *   history.setPeriod(1000);                        // 1 sample/second
+ *   dashboard.setHistory(history);
+ *
+ * int16_t stores round(value * scale), clamped to +/-32767, so pick the
+ * scale from the resolution you need and the range of the sensor.
+ *
+ * WebDashboard records a sample whenever data is published and a grid
+ * slot is due; if publishing stalls, the missed slots repeat the value
+ * published next. Recording runs on the publishing task; the server
+ * reads concurrently without a lock and detects samples that were
+ * overwritten while it was reading them.
+ *
+ * Rollup tiers: long time spans are kept as aggregated buckets
+ * (min/max/sum/count per channel), each made of 'factor' entries of the
+ * tier below. They are updated as samples arrive, O(1) per sample:
+ *
+ *   DashboardHistory<3, 120> history;    // 2 min of 1 s samples
+ *   DashboardRollup<3, 60> minutes(60);  // 1 h of 1 min buckets
+ *   DashboardRollup<3, 24> hours(60);    // 24 h of 1 h buckets
+ *
+ *   history.addTier(minutes);            // Tier 1
+ *   history.addTier(hours);              // Tier 2
+ */
+
+#ifndef DASHBOARD_HISTORY_H
+#define DASHBOARD_HISTORY_H
+
+#include <stdint.h>
+#include <atomic>
+#include "DashboardChannels.h"
+
+#define DASHBOARD_HISTORY_PERIOD 1000   // Default ms between samples
+
+// One aggregated bucket of one channel (count 0 = no data)
+struct RollupSample {
+    float min;
+    float max;
+    float sum;
+    uint32_t count;
+
+    float avg() const { return count ? sum / count : 0; }
+};
+
+class RollupBase {
+public:
+    uint8_t channels() const { return _channels; }
+    uint16_t depth() const { return _depth; }
+    uint16_t factor() const { return _factor; }    // Entries of the tier below
+    uint32_t period() const { return _period; }    // ms per bucket
+
+    // Reader side, numbered like HistoryBase samples; bucket n covers
+    // [timeOf(n), timeOf(n) + period())
+    uint32_t end() const { return _written.load(std::memory_order_acquire); }
+    uint32_t first() const;
+    uint32_t timeOf(uint32_t bucket) const { return _start + bucket * _period; }
+    bool read(uint8_t channel, uint32_t bucket, RollupSample& sample) const;
+
+protected:
+    RollupBase(RollupSample* buckets, RollupSample* current, uint8_t channels,
+               uint16_t depth, uint16_t factor);
+
+private:
+    friend class HistoryBase;
+
+    RollupSample* _buckets;     // Channel-major: [channel][slot]
+    RollupSample* _current;     // Bucket being filled, one per channel
+    uint8_t _channels;
+    uint16_t _depth;
+    uint16_t _factor;
+    uint32_t _period;
+    uint32_t _start;
+    uint16_t _filled;           // Entries in _current so far
+    RollupBase* _next;          // Next coarser tier
+
+    std::atomic<uint32_t> _written;
+    std::atomic<uint32_t> _writing;
+
+    void feed(const DashboardChannel* channels, uint8_t count, uint32_t repeat);
+    void merge(const RollupSample* samples, uint8_t count);
+    void flush();
+};
+
+class HistoryBase {
+public:
+    // Time between samples (call before data is recorded)
+    void setPeriod(uint32_t periodMs);
+    uint32_t period() const { return _period; }
+
+    // Append a rollup tier fed by the last one (or by the raw samples)
+    void addTier(RollupBase& tier);
+    uint8_t tiers() const;                          // Rollup tiers added
+    const RollupBase* tier(uint8_t n) const;        // n = 1..tiers()
+
+    uint8_t channels() const { return _channels; }
+    uint16_t depth() const { return _depth; }
+
+    // Writer side: record the channel values if a grid slot is due
+    void record(const DashboardChannel* channels, uint8_t count, uint32_t now);
+
+    // Reader side. Samples are numbered from 0 since boot; end() is the
+    // number of the next sample to be recorded, first() the oldest one
+    // still stored.
+    uint32_t end() const { return _written.load(std::memory_order_acquire); }
+    uint32_t first() const;
+    uint32_t timeOf(uint32_t sample) const { return _start + sample * _period; }
+
+    // False if the sample is not stored (not yet recorded, or already
+    // overwritten, possibly while it was being read)
+    bool read(uint8_t channel, uint32_t sample, float& value) const;
+
+protected:
+    // Overloaded on the sample type; scale only applies to int16_t
+    HistoryBase(float* samples, uint8_t channels, uint16_t depth, float scale);
+    HistoryBase(int16_t* samples, uint8_t channels, uint16_t depth, float scale);
+
+private:
+    float* _floatSamples;       // One of these two is used
+    int16_t* _fixedSamples;
+    float _scale;
+
+    uint8_t _channels;
+    uint16_t _depth;
+    uint32_t _period;
+
+    bool _started;
+    uint32_t _start;            // Time of sample 0
+    uint32_t _nextDue;          // Time of sample _written
+    RollupBase* _tier;          // First rollup tier
+
+    // Samples [_written, _writing) are being written right now
+    std::atomic<uint32_t> _written;
+    std::atomic<uint32_t> _writing;
+
+    void store(uint8_t channel, uint16_t slot, float value);
+    void updateTiers();
+};
+
+template <uint8_t Channels, uint16_t Depth, typename Sample = float>
+class DashboardHistory : public HistoryBase {
+    static_assert(Channels > 0 && Channels <= WEBDASHBOARD_MAX_CHANNELS,
+                  "DashboardHistory channels must be 1..WEBDASHBOARD_MAX_CHANNELS");
+    static_assert(Depth > 1, "DashboardHistory depth must be at least 2");
+
+public:
+    // scale: fixed-point factor, only used with int16_t samples
+    explicit DashboardHistory(float scale = 10)
+        : HistoryBase(_storage, Channels, Depth, scale) {}
+
+private:
+    Sample _storage[Channels * Depth];   // Channel-major: [channel][slot]
+};
+
+template <uint8_t Channels, uint16_t Depth>
+class DashboardRollup : public RollupBase {
+    static_assert(Channels > 0 && Channels <= WEBDASHBOARD_MAX_CHANNELS,
+                  "DashboardRollup channels must be 1..WEBDASHBOARD_MAX_CHANNELS");
+    static_assert(Depth > 1, "DashboardRollup depth must be at least 2");
+
+public:
+    // factor: entries of the tier below per bucket (e.g. 60)
+    explicit DashboardRollup(uint16_t factor)
+        : RollupBase(_storage, _filling, Channels, Depth, factor) {}
+
+private:
+    RollupSample _storage[Channels * Depth];
+    RollupSample _filling[Channels];
+};
+
+#endif // DASHBOARD_HISTORY_H
@@ -0,0 +1,623 @@
+/*
+ * DashboardLog.cpp
+ *
+ * LittleFS log: block assembly and page writes on the log task, segment
+ * rotation, resume after a reboot, and the streamed range reads.
+ */
+
+#include "DashboardLog.h"
+#include <sys/time.h>
+
+#define LOG_TASK_STACK 4096
+#define LOG_SYNC 1                  // Message::kind
+#define LOG_TEXT_MAX 96             // Longest piece fill() writes at once
+#define LOG_READ_RECORDS 32         // Records read from the file at once
+#define LOG_CLOCK_VALID 1600000000L // Unix seconds: the clock has been set
+
+DashboardLog::DashboardLog(uint8_t channels, float scale) {
+    if (channels < 1) channels = 1;
+    if (channels > DASHBOARD_LOG_CHANNELS) channels = DASHBOARD_LOG_CHANNELS;
+    _channels = channels;
+    _scale = scale > 0 ? scale : 1;
+    _period = DASHBOARD_LOG_PERIOD;
+    _capacity = 0;
+
+    _recording = false;
+    _slot = 0;
+    _nextDue = 0;
+    _dropped = 0;
+    _queue = nullptr;
+    _task = nullptr;
+
+    memset(&_header, 0, sizeof(_header));
+    _blockOpen = false;
+    _used = 0;
+    _flushed = 0;
+    _records = 0;
+    _continues = false;
+    _expectSlot = 0;
+    _nextSeq = 0;
+    _nextTime = 0;
+    _boot = 0;
+    _bootTimed = false;
+    _bootTime = 0;
+    _bootUptime = 0;
+    _blocksInSegment = 0;
+    _tailPad = 0;
+
+    _firstSegment = 0;
+    _lastSegment = 0;
+    _blockCount = 0;
+    _maxSegments = 2;
+    _lastTime = 0;
+    portMUX_TYPE unlocked = portMUX_INITIALIZER_UNLOCKED;
+    _lock = unlocked;
+    _fsLock = nullptr;
+}
+
+void DashboardLog::setPeriod(uint32_t periodMs) {
+    _period = periodMs > 0 ? periodMs : 1;
+}
+
+void DashboardLog::setCapacity(size_t bytes) {
+    _capacity = bytes;
+}
+
+uint64_t DashboardLog::lastTime() const {
+    portENTER_CRITICAL(&_lock);
+    uint64_t time = _lastTime;
+    portEXIT_CRITICAL(&_lock);
+    return time;
+}
+
+void DashboardLog::segmentPath(char* out, size_t size, uint32_t number) {
+    snprintf(out, size, DASHBOARD_LOG_DIR "/%08lu.bin", (unsigned long)number);
+}
+
+static bool validHeader(const LogBlockHeader& header) {
+    return header.magic == LOG_MAGIC && header.channels >= 1
+        && header.channels <= DASHBOARD_LOG_CHANNELS && header.period > 0 && header.scale > 0;
+}
+
+bool DashboardLog::begin(BaseType_t core, UBaseType_t priority) {
+    if (_task) {
+        return true;
+    }
+    if (!LittleFS.begin(true)) {
+        Serial.println("Log: LittleFS mount failed");
+        return false;
+    }
+    if (!LittleFS.exists(DASHBOARD_LOG_DIR)) {
+        LittleFS.mkdir(DASHBOARD_LOG_DIR);
+    }
+
+    const size_t segmentBytes = (size_t)DASHBOARD_LOG_BLOCK * DASHBOARD_LOG_SEGMENT;
+    size_t capacity = _capacity ? _capacity : LittleFS.totalBytes() / 100 * DASHBOARD_LOG_FILL;
+    _maxSegments = capacity / segmentBytes;
+    if (_maxSegments < 2) _maxSegments = 2;
+
+    _fsLock = xSemaphoreCreateMutex();
+    _queue = xQueueCreate(DASHBOARD_LOG_QUEUE, sizeof(Message));
+    resume();
+
+    xTaskCreatePinnedToCore(taskMain, "log", LOG_TASK_STACK, this, priority, &_task, core);
+    Serial.printf("Log: %lu of %lu segments (%u KB each), boot %u, next record %lu\n",
+                  (unsigned long)(_lastSegment - _firstSegment + 1), (unsigned long)_maxSegments,
+                  (unsigned)(segmentBytes / 1024), (unsigned)_boot, (unsigned long)_nextSeq);
+    return true;
+}
+
+// ==================== RESUME ====================
+
+// Find the segments, continue seq and time from the newest block, and
+// note how much of a block cut off by the reboot is left to pad
+void DashboardLog::resume() {
+    uint32_t first = UINT32_MAX;
+    uint32_t last = 0;
+    File dir = LittleFS.open(DASHBOARD_LOG_DIR);
+    for (File file = dir.openNextFile(); file; file = dir.openNextFile()) {
+        const char* name = file.name();
+        const char* base = strrchr(name, '/');
+        base = base ? base + 1 : name;
+        char* end;
+        unsigned long number = strtoul(base, &end, 10);
+        if (end != base && strcmp(end, ".bin") == 0) {
+            if (number < first) first = number;
+            if (number > last) last = number;
+        }
+    }
+    dir.close();
+
+    if (first == UINT32_MAX) {
+        first = last = 0;
+    }
+    _firstSegment = first;
+    _lastSegment = last;
+    openSegment(last);
+
+    size_t size = _file.size();
+    _blockCount = (size + DASHBOARD_LOG_BLOCK - 1) / DASHBOARD_LOG_BLOCK;
+    _blocksInSegment = _blockCount;
+    size_t partial = size % DASHBOARD_LOG_BLOCK;
+    _tailPad = partial ? DASHBOARD_LOG_BLOCK - partial : 0;
+
+    // Newest readable header: usually the last block's, else (cut off
+    // inside the header, or a fresh segment) the one before
+    uint32_t top = _lastSegment * DASHBOARD_LOG_SEGMENT + _blockCount;
+    uint32_t bottom = _firstSegment * DASHBOARD_LOG_SEGMENT;
+    LogBlockHeader header;
+    for (uint32_t block = top; block > bottom && top - block < DASHBOARD_LOG_SEGMENT; block--) {
+        if (!readHeader(block - 1, header)) continue;
+
+        // Its real records end at the first pad (or the end of the file)
+        uint16_t capacity = header.capacity();
+        size_t recordSize = header.channels * sizeof(int16_t);
+        uint16_t records = 0;
+        char path[32];
+        segmentPath(path, sizeof(path), (block - 1) / DASHBOARD_LOG_SEGMENT);
+        File file = LittleFS.open(path, "r");
+        size_t offset = ((block - 1) % DASHBOARD_LOG_SEGMENT) * DASHBOARD_LOG_BLOCK;
+        if (file && file.seek(offset + sizeof(LogBlockHeader))) {
+            size_t length = file.read(_block, capacity * recordSize);
+            while (records < capacity && (records + 1) * recordSize <= length) {
+                int16_t value;
+                memcpy(&value, _block + records * recordSize, sizeof(value));
+                if (value == LOG_PAD) break;
+                records++;
+            }
+        }
+        file.close();
+
+        _nextSeq = header.seq + capacity;
+        _nextTime = header.time + (uint64_t)records * header.period;
+        _lastTime = records ? _nextTime - header.period : header.time;
+        _boot = header.boot + 1;
+        break;
+    }
+}
+
+// Finish the block the reboot cut off: unused records become LOG_PAD
+void DashboardLog::writePad() {
+    if (!_tailPad) {
+        return;
+    }
+    size_t start = DASHBOARD_LOG_BLOCK - _tailPad;
+    for (size_t i = 0; i < _tailPad; i++) {
+        size_t position = start + i;
+        uint8_t pad = 0;
+        if (position >= sizeof(LogBlockHeader)) {
+            // Little-endian LOG_PAD, aligned to the records
+            pad = (position - sizeof(LogBlockHeader)) % 2 ? 0x80 : 0x01;
+        }
+        _block[i] = pad;
+    }
+
+    xSemaphoreTake(_fsLock, portMAX_DELAY);
+    _file.write(_block, _tailPad);
+    _file.flush();
+    xSemaphoreGive(_fsLock);
+    _tailPad = 0;
+}
+
+// ==================== WRITER ====================
+
+void DashboardLog::record(const DashboardChannel* channels, uint8_t count, uint32_t now) {
+    if (!_queue) {
+        return;
+    }
+    if (!_recording) {
+        _recording = true;
+        _nextDue = now;
+    }
+    if ((int32_t)(now - _nextDue) < 0) {
+        return;
+    }
+
+    // Same grid as DashboardHistory: missed slots repeat the value
+    uint32_t due = (now - _nextDue) / _period + 1;
+    Message message;
+    message.kind = 0;
+    message.repeat = due > 0xFFFF ? 0xFFFF : due;   // The rest becomes a gap
+    message.slot = _slot;
+    message.uptime = _nextDue;
+    for (uint8_t channel = 0; channel < DASHBOARD_LOG_CHANNELS; channel++) {
+        float value = channel < count && channel < _channels ? channels[channel].value : NAN;
+        if (isnan(value)) {
+            message.values[channel] = LOG_NONE;
+            continue;
+        }
+        float scaled = value * _scale;
+        if (scaled > 32766) scaled = 32766;
+        if (scaled < -32766) scaled = -32766;
+        message.values[channel] = (int16_t)lroundf(scaled);
+    }
+
+    if (xQueueSend(_queue, &message, 0) != pdTRUE) {
+        _dropped += due;
+    }
+    _slot += due;
+    _nextDue += due * _period;
+}
+
+void DashboardLog::sync() {
+    if (!_queue) {
+        return;
+    }
+    Message message = {};
+    message.kind = LOG_SYNC;
+    xQueueSend(_queue, &message, 0);
+}
+
+void DashboardLog::taskMain(void* arg) {
+    DashboardLog* log = static_cast<DashboardLog*>(arg);
+    log->writePad();
+
+    Message message;
+    for (;;) {
+        if (xQueueReceive(log->_queue, &message, portMAX_DELAY) == pdTRUE) {
+            log->handle(message);
+        }
+    }
+}
+
+void DashboardLog::handle(const Message& message) {
+    if (message.kind == LOG_SYNC) {
+        writeOut(true);
+        return;
+    }
+
+    if (message.slot != _expectSlot) {
+        _continues = false;     // Records were dropped: new run
+        finishBlock();
+    }
+    for (uint16_t i = 0; i < message.repeat; i++) {
+        if (!_blockOpen) {
+            startBlock(message.uptime + i * _period);
+        }
+        append(message.values);
+        if (_records == _header.capacity()) {
+            _continues = true;
+            finishBlock();
+        }
+    }
+    _expectSlot = message.slot + message.repeat;
+    writeOut(false);
+}
+
+void DashboardLog::startBlock(uint32_t uptime) {
+    if (_blocksInSegment >= DASHBOARD_LOG_SEGMENT) {
+        rotate();
+    }
+
+    // Unix time once the clock is set, else continue the log's own time
+    struct timeval now;
+    gettimeofday(&now, nullptr);
+    bool clock = now.tv_sec > LOG_CLOCK_VALID;
+    uint64_t time;
+    if (clock) {
+        time = (uint64_t)now.tv_sec * 1000 + now.tv_usec / 1000 - (millis() - uptime);
+    } else {
+        if (!_bootTimed) {
+            _bootTimed = true;
+            _bootTime = _nextTime;
+            _bootUptime = uptime;
+        }
+        time = _bootTime + (uint32_t)(uptime - _bootUptime);
+    }
+
+    // Right after a full block, stay on its grid unless the clock moved
+    uint64_t predicted = _nextTime;
+    bool sameClock = ((_header.flags & LOG_CLOCK_SET) != 0) == clock;
+    if (_continues && sameClock && _header.period == _period
+        && (time > predicted ? time - predicted : predicted - time) <= DASHBOARD_LOG_DRIFT) {
+        time = predicted;
+    }
+    if (time < _nextTime) {
+        time = _nextTime;       // Never before the previous record
+    }
+
+    memset(&_header, 0, sizeof(_header));
+    _header.magic = LOG_MAGIC;
+    _header.seq = _nextSeq;
+    _header.time = time;
+    _header.period = _period;
+    _header.scale = _scale;
+    _header.channels = _channels;
+    _header.flags = clock ? LOG_CLOCK_SET : 0;
+    _header.boot = _boot;
+
+    memcpy(_block, &_header, sizeof(_header));
+    _used = sizeof(_header);
+    _flushed = 0;
+    _records = 0;
+    _blockOpen = true;
+}
+
+void DashboardLog::append(const int16_t* values) {
+    memcpy(_block + _used, values, _channels * sizeof(int16_t));
+    _used += _channels * sizeof(int16_t);
+    _records++;
+
+    uint64_t time = _header.time + (uint64_t)(_records - 1) * _header.period;
+    _nextTime = time + _header.period;
+    portENTER_CRITICAL(&_lock);
+    _lastTime = time;
+    portEXIT_CRITICAL(&_lock);
+}
+
+void DashboardLog::finishBlock() {
+    if (!_blockOpen) {
+        return;
+    }
+    int16_t pad = LOG_PAD;
+    while (_used + sizeof(pad) <= DASHBOARD_LOG_BLOCK) {
+        memcpy(_block + _used, &pad, sizeof(pad));
+        _used += sizeof(pad);
+    }
+    memset(_block + _used, 0, DASHBOARD_LOG_BLOCK - _used);
+    _used = DASHBOARD_LOG_BLOCK;
+    writeOut(false);
+
+    _nextSeq = _header.seq + _header.capacity();
+    _blockOpen = false;
+    _blocksInSegment++;
+}
+
+// Whole pages only, unless partial (sync) or the block is complete
+void DashboardLog::writeOut(bool partial) {
+    if (!_blockOpen) {
+        return;
+    }
+    size_t end = _used;
+    if (!partial && _used < DASHBOARD_LOG_BLOCK) {
+        end -= _used % DASHBOARD_LOG_PAGE;
+    }
+    if (end <= _flushed) {
+        return;
+    }
+
+    xSemaphoreTake(_fsLock, portMAX_DELAY);
+    size_t written = _file.write(_block + _flushed, end - _flushed);
+    _file.flush();
+    if (_flushed == 0 && written > 0) {
+        portENTER_CRITICAL(&_lock);
+        _blockCount = _blockCount + 1;      // Readers may see it now
+        portEXIT_CRITICAL(&_lock);
+    }
+    xSemaphoreGive(_fsLock);
+
+    if (written != end - _flushed) {
+        Serial.println("Log: write failed (filesystem full?)");
+    }
+    _flushed = end;
+}
+
+void DashboardLog::openSegment(uint32_t number) {
+    char path[32];
+    segmentPath(path, sizeof(path), number);
+    _file = LittleFS.open(path, FILE_APPEND);
+}
+
+// Next segment file; drop the oldest beyond the capacity
+void DashboardLog::rotate() {
+    xSemaphoreTake(_fsLock, portMAX_DELAY);
+    _file.close();
+    uint32_t next = _lastSegment + 1;
+    openSegment(next);
+
+    portENTER_CRITICAL(&_lock);
+    _lastSegment = next;
+    _blockCount = 0;
+    portEXIT_CRITICAL(&_lock);
+    _blocksInSegment = 0;
+
+    while (_lastSegment - _firstSegment + 1 > _maxSegments) {
+        char path[32];
+        segmentPath(path, sizeof(path), _firstSegment);
+        LittleFS.remove(path);
+        portENTER_CRITICAL(&_lock);
+        _firstSegment = _firstSegment + 1;
+        portEXIT_CRITICAL(&_lock);
+    }
+    xSemaphoreGive(_fsLock);
+}
+
+// ==================== READER ====================
+
+bool DashboardLog::readHeader(uint32_t block, LogBlockHeader& header) const {
+    char path[32];
+    segmentPath(path, sizeof(path), block / DASHBOARD_LOG_SEGMENT);
+
+    xSemaphoreTake(_fsLock, portMAX_DELAY);
+    File file = LittleFS.open(path, "r");
+    bool read = file && file.seek((block % DASHBOARD_LOG_SEGMENT) * DASHBOARD_LOG_BLOCK)
+        && file.read((uint8_t*)&header, sizeof(header)) == sizeof(header);
+    file.close();
+    xSemaphoreGive(_fsLock);
+    return read && validHeader(header);
+}
+
+// The block holding the first record at or after both since and from:
+// the one before the first block that starts past both
+uint32_t DashboardLog::findBlock(uint32_t since, uint64_t from) const {
+    portENTER_CRITICAL(&_lock);
+    uint32_t low = _firstSegment * DASHBOARD_LOG_SEGMENT;
+    uint32_t high = _lastSegment * DASHBOARD_LOG_SEGMENT + _blockCount;
+    portEXIT_CRITICAL(&_lock);
+
+    uint32_t first = low;
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        LogBlockHeader header;
+        if (readHeader(middle, header) && header.seq > since && header.time > from) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+    return low > first ? low - 1 : first;
+}
+
+bool DashboardLog::open(LogCursor& cursor, uint8_t channel, uint32_t since, uint64_t from,
+                        uint64_t to, uint32_t limit) const {
+    memset(&cursor, 0, sizeof(cursor));
+    cursor.log = this;
+    cursor.channel = channel;
+    cursor.next = since;
+    cursor.from = from;
+    cursor.to = to;
+    cursor.remaining = limit > 0 && limit < DASHBOARD_LOG_LIMIT ? limit : DASHBOARD_LOG_LIMIT;
+    if (!_task || channel >= _channels) {
+        return false;
+    }
+    cursor.block = findBlock(since, from);
+    return true;
+}
+
+// Values of one block from cursor.next on, as long as there is room.
+// Called with _fsLock held and the block's segment open.
+static size_t logRecords(LogCursor& cursor, File& file, const LogBlockHeader& header,
+                         char* out, size_t size) {
+    uint16_t capacity = header.capacity();
+    size_t recordSize = header.channels * sizeof(int16_t);
+    uint32_t index = cursor.next > header.seq ? cursor.next - header.seq : 0;
+    if (cursor.from > header.time) {
+        uint64_t skip = (cursor.from - header.time + header.period - 1) / header.period;
+        if (skip > index) index = skip > capacity ? capacity : (uint32_t)skip;
+    }
+    if (index >= capacity) {
+        cursor.block++;
+        return 0;
+    }
+
+    size_t offset = (cursor.block % DASHBOARD_LOG_SEGMENT) * DASHBOARD_LOG_BLOCK
+        + sizeof(LogBlockHeader) + index * recordSize;
+    if (!file.seek(offset)) {
+        cursor.part = 2;
+        return 0;
+    }
+
+    size_t length = 0;
+    int16_t records[LOG_READ_RECORDS * DASHBOARD_LOG_CHANNELS];
+    while (index < capacity && cursor.remaining > 0 && size - length > LOG_TEXT_MAX) {
+        uint32_t want = capacity - index;
+        if (want > LOG_READ_RECORDS) want = LOG_READ_RECORDS;
+        size_t got = file.read((uint8_t*)records, want * recordSize) / recordSize;
+        if (got == 0) {
+            cursor.part = 2;    // End of what is on flash
+            return length;
+        }
+
+        for (size_t i = 0; i < got && size - length > LOG_TEXT_MAX; i++) {
+            const int16_t* record = records + i * header.channels;
+            uint64_t time = header.time + (uint64_t)index * header.period;
+            if (record[0] == LOG_PAD) {
+                index = capacity;           // Rest of the block is unused
+                break;
+            }
+            if (time > cursor.to || cursor.remaining == 0) {
+                cursor.part = 2;
+                return length;
+            }
+
+            uint32_t seq = header.seq + index;
+            if (!cursor.inRun || seq != cursor.runSeq || time != cursor.runTime
+                || header.period != cursor.runPeriod) {
+                // Not a continuation of the open run (a gap or reboot)
+                length += snprintf(out + length, size - length,
+                                   "%s%s{\"seq\":%lu,\"t\":%llu,\"clock\":%s,\"dt\":%lu,\"v\":[",
+                                   cursor.inRun ? "]}" : "", cursor.runs > 0 ? "," : "",
+                                   (unsigned long)seq, (unsigned long long)time,
+                                   (header.flags & LOG_CLOCK_SET) ? "true" : "false",
+                                   (unsigned long)header.period);
+                cursor.inRun = true;
+                cursor.runEmpty = true;
+                cursor.runs++;
+            }
+
+            int16_t value = cursor.channel < header.channels ? record[cursor.channel] : LOG_NONE;
+            const char* comma = cursor.runEmpty ? "" : ",";
+            if (value == LOG_NONE) {
+                length += snprintf(out + length, size - length, "%snull", comma);
+            } else {
+                length += snprintf(out + length, size - length, "%s%.6g", comma,
+                                   value / header.scale);
+            }
+            cursor.runEmpty = false;
+            index++;
+            cursor.next = seq + 1;
+            cursor.runSeq = seq + 1;
+            cursor.runTime = time + header.period;
+            cursor.runPeriod = header.period;
+            cursor.remaining--;
+        }
+    }
+    if (index >= capacity) {
+        cursor.block++;
+    }
+    if (cursor.remaining == 0) {
+        cursor.part = 2;
+    }
+    return length;
+}
+
+size_t DashboardLog::fill(LogCursor& cursor, char* buffer, size_t size) {
+    if (size < LOG_TEXT_MAX + 2) {
+        return 0;
+    }
+
+    size_t length = 0;
+    if (cursor.part == 0) {
+        length = snprintf(buffer, size, "{\"ch\":%u,\"tier\":\"log\",\"runs\":[",
+                          (unsigned)cursor.channel);
+        cursor.part = cursor.log->_task ? 1 : 2;
+    }
+
+    const DashboardLog* log = cursor.log;
+    if (cursor.part == 1) {
+        xSemaphoreTake(log->_fsLock, portMAX_DELAY);
+        File file;
+        uint32_t openSegment = UINT32_MAX;
+        while (cursor.part == 1 && size - length > LOG_TEXT_MAX) {
+            portENTER_CRITICAL(&log->_lock);
+            uint32_t first = log->_firstSegment * DASHBOARD_LOG_SEGMENT;
+            uint32_t end = log->_lastSegment * DASHBOARD_LOG_SEGMENT + log->_blockCount;
+            portEXIT_CRITICAL(&log->_lock);
+
+            if (cursor.block < first) {
+                cursor.block = first;       // Rotated away meanwhile
+            }
+            if (cursor.block >= end) {
+                cursor.part = 2;
+                break;
+            }
+
+            uint32_t segment = cursor.block / DASHBOARD_LOG_SEGMENT;
+            if (segment != openSegment) {
+                char path[32];
+                segmentPath(path, sizeof(path), segment);
+                file.close();
+                file = LittleFS.open(path, "r");
+                openSegment = segment;
+            }
+
+            LogBlockHeader header;
+            if (!file || !file.seek((cursor.block % DASHBOARD_LOG_SEGMENT) * DASHBOARD_LOG_BLOCK)
+                || file.read((uint8_t*)&header, sizeof(header)) != sizeof(header)
+                || !validHeader(header)) {
+                cursor.block++;             // Unreadable: skip it
+                continue;
+            }
+            length += logRecords(cursor, file, header, buffer + length, size - length);
+        }
+        file.close();
+        xSemaphoreGive(log->_fsLock);
+    }
+
+    if (cursor.part == 2 && size - length > LOG_TEXT_MAX) {
+        length += snprintf(buffer + length, size - length, "%s],\"next\":%lu}",
+                           cursor.inRun ? "]}" : "", (unsigned long)cursor.next);
+        cursor.part = 3;
+    }
+    return length;
+}
@@ -0,0 +1,211 @@
+/*
+ * DashboardLog.h
+ *
+ * Long-term channel history on LittleFS, for the days and weeks the RAM
+ * history (DashboardHistory.h) cannot hold:
+ *
+ *   DashboardLog log(3);               // Channels 0-2, 0.1 steps
+ *   log.setPeriod(1000);               // 1 record/second
+ *   dashboard.setLog(log);             // Before begin()
+ *
+ * /api/history?ch=<id>&tier=log streams it (see handleHistory()).
+ *
+ * Format: an append-only sequence of DASHBOARD_LOG_BLOCK byte blocks,
+ * split into segment files of DASHBOARD_LOG_SEGMENT blocks
+ * (/log/00000000.bin, ...). Every block starts with a LogBlockHeader
+ * followed by fixed-size records, one int16_t per channel
+ * (round(value * scale), LOG_NONE = no value, LOG_PAD = the unused
+ * rest of a block). Records sit on a grid, so their times are implicit:
+ *
+ *   seq of record i  = header.seq + i
+ *   time of record i = header.time + i * header.period
+ *
+ * Because blocks have a fixed size and each header carries the first
+ * seq and time, the headers are the index: a range read binary-searches
+ * them (a dozen 32-byte reads for a week of data) and then reads the
+ * records sequentially, straight from the file into the response.
+ *
+ * Writes: record() only hands the values to the log task (a queue, no
+ * flash access on the publishing task). The task assembles the block in
+ * RAM and appends it to the file one DASHBOARD_LOG_PAGE at a time, so a
+ * power cut loses at most the page being filled; sync() writes that
+ * page early (the dashboard calls it before the /api/reset restart). A
+ * gap (a reboot, or records dropped because the queue was full) ends
+ * the block: its unused records are LOG_PAD and the next block starts
+ * with its own header, so a reader sees that as a new run.
+ *
+ * Time: header.time is Unix time in ms (LOG_CLOCK_SET) once the system
+ * clock has been set, e.g. by SNTP on a station connection. Until then
+ * it continues from the end of the log, so it always increases, across
+ * reboots too, but downtime is not visible.
+ *
+ * Space: the oldest segment is deleted when the log would exceed its
+ * capacity (default DASHBOARD_LOG_FILL % of the partition). A record
+ * takes 2 bytes per channel: a week of 3 channels at 1 Hz is about
+ * 3.6 MB, so pick a partition table with a large enough LittleFS
+ * partition (see README).
+ */
+
+#ifndef DASHBOARD_LOG_H
+#define DASHBOARD_LOG_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "DashboardChannels.h"
+
+#define DASHBOARD_LOG_PERIOD 1000       // Default ms between records
+#define DASHBOARD_LOG_BLOCK 4096        // Bytes per block (one flash sector)
+#define DASHBOARD_LOG_PAGE 256          // Bytes appended to the file at once
+#define DASHBOARD_LOG_SEGMENT 32        // Blocks per segment file (128 KB)
+#define DASHBOARD_LOG_CHANNELS 8        // Most channels a log records
+#define DASHBOARD_LOG_QUEUE 16          // Records waiting for the log task
+#define DASHBOARD_LOG_FILL 90           // Default capacity, % of the partition
+#define DASHBOARD_LOG_LIMIT 86400       // Most records per /api/history response
+#define DASHBOARD_LOG_DRIFT 2000        // ms the clock may drift before a run is re-anchored
+#define DASHBOARD_LOG_DIR "/log"
+
+#define LOG_MAGIC 0x31474C44UL          // "DLG1"
+#define LOG_NONE INT16_MIN              // Record without a value
+#define LOG_PAD (INT16_MIN + 1)         // Unused record at the end of a block
+#define LOG_CLOCK_SET 0x01              // LogBlockHeader::flags
+
+struct LogBlockHeader {
+    uint32_t magic;             // LOG_MAGIC
+    uint32_t seq;               // Number of the first record, since the log began
+    uint64_t time;              // ms of the first record (Unix time if LOG_CLOCK_SET)
+    uint32_t period;            // ms between records
+    float scale;                // value = record / scale
+    uint8_t channels;           // int16_t per record
+    uint8_t flags;
+    uint16_t boot;              // Boots since the log began
+    uint32_t reserved;
+
+    // Records in a block of this layout
+    uint16_t capacity() const {
+        return (DASHBOARD_LOG_BLOCK - sizeof(LogBlockHeader)) / (channels * sizeof(int16_t));
+    }
+};
+
+static_assert(sizeof(LogBlockHeader) == 32, "LogBlockHeader is part of the file format");
+
+class DashboardLog;
+
+// Position in a streamed /api/history?tier=log response
+struct LogCursor {
+    const DashboardLog* log;
+    uint8_t channel;
+    uint8_t part;               // 0 = head, 1 = records, 2 = tail, 3 = done
+    bool inRun;                 // A run's "v" array is open
+    bool runEmpty;              // ... and has no values yet
+    uint16_t runs;
+    uint32_t block;             // Global block number being read
+    uint32_t next;              // seq of the next record
+    uint32_t remaining;         // Records left under the limit
+    uint64_t from;              // Skip records before this time (ms)
+    uint64_t to;                // Stop after this time (ms)
+    uint32_t runSeq;            // seq, time and period the open run continues with
+    uint64_t runTime;
+    uint32_t runPeriod;
+};
+
+class DashboardLog {
+public:
+    // channels: ids 0..channels-1 are recorded; scale as in DashboardHistory
+    explicit DashboardLog(uint8_t channels, float scale = 10);
+
+    // Call before begin()
+    void setPeriod(uint32_t periodMs);
+    void setCapacity(size_t bytes);     // 0 = DASHBOARD_LOG_FILL % of the partition
+
+    // Mount LittleFS (formatted if it has never been), find the end of
+    // the log and start the log task (WebDashboard::begin() does this)
+    bool begin(BaseType_t core = 0, UBaseType_t priority = 1);
+
+    // Publishing task: queue the values if a grid slot is due (no I/O)
+    void record(const DashboardChannel* channels, uint8_t count, uint32_t now);
+
+    // Write the page being filled now (e.g. before a restart)
+    void sync();
+
+    bool started() const { return _task != nullptr; }
+    uint8_t channels() const { return _channels; }
+    uint32_t period() const { return _period; }
+    uint32_t dropped() const { return _dropped; }   // Records lost to a full queue
+    uint64_t lastTime() const;                      // Time of the newest record
+
+    // Reader side (any task): position a cursor at 'since' (a seq) or at
+    // 'from' (a time in ms), whichever is later
+    bool open(LogCursor& cursor, uint8_t channel, uint32_t since, uint64_t from,
+              uint64_t to, uint32_t limit) const;
+
+    // sendChunked() filler:
+    // {"ch":..,"tier":"log","runs":[{"seq":..,"t":..,"clock":..,"dt":..,"v":[..]},..],"next":..}
+    static size_t fill(LogCursor& cursor, char* buffer, size_t size);
+
+private:
+    uint8_t _channels;
+    float _scale;
+    uint32_t _period;
+    size_t _capacity;
+
+    // Producer (publishing task)
+    bool _recording;
+    uint32_t _slot;             // Grid slots since boot
+    uint32_t _nextDue;
+    volatile uint32_t _dropped;
+
+    struct Message {
+        uint8_t kind;           // 0 = records, 1 = sync
+        uint16_t repeat;        // Identical records (a stalled publisher)
+        uint32_t slot;
+        uint32_t uptime;        // millis() of the first one
+        int16_t values[DASHBOARD_LOG_CHANNELS];
+    };
+    QueueHandle_t _queue;
+    TaskHandle_t _task;
+
+    // Log task: the block being assembled
+    uint8_t _block[DASHBOARD_LOG_BLOCK];
+    LogBlockHeader _header;
+    bool _blockOpen;
+    size_t _used;               // Bytes of _block filled
+    size_t _flushed;            // Bytes of _block in the file
+    uint16_t _records;
+    bool _continues;            // The last block ended full, not at a gap
+    uint32_t _expectSlot;
+    uint32_t _nextSeq;
+    uint64_t _nextTime;         // Earliest time the next block may start at
+    uint16_t _boot;
+    bool _bootTimed;            // _bootTime valid
+    uint64_t _bootTime;         // Log time at _bootUptime without a clock
+    uint32_t _bootUptime;
+    File _file;                 // Newest segment, open for appending
+    uint32_t _blocksInSegment;
+    uint32_t _tailPad;          // Bytes to finish a block cut off by a reboot
+
+    // Segments [_firstSegment, _lastSegment], shared with readers
+    volatile uint32_t _firstSegment;
+    volatile uint32_t _lastSegment;
+    volatile uint32_t _blockCount;      // Blocks in the newest segment
+    uint32_t _maxSegments;
+    uint64_t _lastTime;
+    mutable portMUX_TYPE _lock;
+    SemaphoreHandle_t _fsLock;          // Held for every file operation
+
+    static void taskMain(void* arg);
+    void resume();
+    void handle(const Message& message);
+    void startBlock(uint32_t uptime);
+    void writePad();
+    void finishBlock();
+    void append(const int16_t* values);
+    void writeOut(bool partial);
+    void openSegment(uint32_t number);
+    void rotate();
+
+    static void segmentPath(char* out, size_t size, uint32_t number);
+    bool readHeader(uint32_t block, LogBlockHeader& header) const;
+    uint32_t findBlock(uint32_t since, uint64_t from) const;
+};
+
+#endif // DASHBOARD_LOG_H
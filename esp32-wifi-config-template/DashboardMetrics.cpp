@@ -0,0 +1,253 @@
+/*
+ * DashboardMetrics.cpp
+ *
+ * Histograms and the Prometheus text output.
+ */
+
+#include "DashboardMetrics.h"
+
+#if WEBDASHBOARD_METRICS
+
+#include <WiFi.h>
+#include "DashboardBoot.h"
+
+// Upper bucket bounds in microseconds (100 us .. 250 ms)
+static const uint32_t BUCKET_BOUNDS[DASHBOARD_METRICS_BUCKETS] = {
+    100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000
+};
+
+static const char* const COMMAND_NAMES[METRICS_COMMANDS] = {
+    "output", "mode", "reset", "custom", "control", "deferred"
+};
+
+struct GaugeInfo {
+    const char* name;
+    const char* type;
+};
+
+static const GaugeInfo GAUGES[METRICS_GAUGES] = {
+    { "dashboard_uptime_seconds", "gauge" },
+    { "dashboard_heap_free_bytes", "gauge" },
+    { "dashboard_heap_min_free_bytes", "gauge" },
+    { "dashboard_heap_largest_free_block_bytes", "gauge" },
+    { "dashboard_cpu_frequency_mhz", "gauge" },
+    { "dashboard_wifi_stations", "gauge" },
+    { "dashboard_event_streams", "gauge" },
+    { "dashboard_commands_dropped_total", "counter" },
+    { "dashboard_scheduler_overruns_total", "counter" },
+    { "dashboard_wifi_sta_connected", "gauge" },
+    { "dashboard_wifi_sta_reconnects_total", "counter" },
+    { "dashboard_params_writes_total", "counter" },
+    { "dashboard_log_dropped_total", "counter" },
+    { "dashboard_sensor_reads_total", "counter" },
+    { "dashboard_sensor_failures_total", "counter" },
+    { "dashboard_rule_trips_total", "counter" },
+    { "dashboard_requests_limited_total", "counter" },
+    { "dashboard_requests_busy_total", "counter" },
+    { "dashboard_responses_cached_total", "counter" }
+};
+
+// Output order of a scrape
+enum MetricsSection : uint8_t {
+    SECTION_GAUGES,
+    SECTION_BOOT,
+    SECTION_ROUTES,
+    SECTION_COMMANDS,
+    SECTION_POLL,
+    SECTION_LOOP,
+    SECTION_DONE
+};
+
+// Lines per histogram series: buckets, +Inf, _sum, _count
+#define SERIES_LINES (DASHBOARD_METRICS_BUCKETS + 3)
+
+#define METRICS_LINE_MAX 160
+
+DashboardMetrics::DashboardMetrics() {
+    memset(_routes, 0, sizeof(_routes));
+    memset(_commands, 0, sizeof(_commands));
+    memset(&_poll, 0, sizeof(_poll));
+    memset(&_loop, 0, sizeof(_loop));
+    _routeCount = 0;
+    _lastLoop = 0;
+    _dropped = 0;
+}
+
+uint8_t DashboardMetrics::addRoute(const char* path) {
+    for (uint8_t route = 0; route < _routeCount; route++) {
+        if (strcmp(_routeNames[route], path) == 0) return route;
+    }
+    if (_routeCount >= DASHBOARD_METRICS_ROUTES) {
+        return METRICS_NO_ROUTE;
+    }
+    _routeNames[_routeCount] = path;
+    return _routeCount++;
+}
+
+uint32_t DashboardMetrics::elapsedUs(uint32_t start) {
+    uint32_t mhz = getCpuFrequencyMhz();
+    return (cycles() - start) / (mhz > 0 ? mhz : 1);
+}
+
+void DashboardMetrics::record(MetricsHistogram& histogram, uint32_t us) {
+    uint8_t bucket = 0;
+    while (bucket < DASHBOARD_METRICS_BUCKETS && us > BUCKET_BOUNDS[bucket]) {
+        bucket++;
+    }
+    histogram.buckets[bucket]++;
+    histogram.sumUs += us;
+    histogram.count++;
+}
+
+void DashboardMetrics::recordRoute(uint8_t route, uint32_t start) {
+    if (route < _routeCount) {
+        record(_routes[route], elapsedUs(start));
+    }
+}
+
+void DashboardMetrics::recordCommand(uint8_t command, uint32_t start) {
+    if (command < METRICS_COMMANDS) {
+        record(_commands[command], elapsedUs(start));
+    }
+}
+
+void DashboardMetrics::recordPoll(uint32_t start) {
+    record(_poll, elapsedUs(start));
+}
+
+void DashboardMetrics::recordLoop() {
+    // micros() instead of cycles: the period may span many clock changes
+    uint32_t now = micros();
+    if (_lastLoop != 0) {
+        record(_loop, now - _lastLoop);
+    }
+    _lastLoop = now ? now : 1;
+}
+
+MetricsCursor DashboardMetrics::cursor() const {
+    MetricsCursor cursor;
+    memset(&cursor, 0, sizeof(cursor));
+    cursor.metrics = this;
+    cursor.gauges[GAUGE_UPTIME] = millis() / 1000;
+    cursor.gauges[GAUGE_HEAP_FREE] = ESP.getFreeHeap();
+    cursor.gauges[GAUGE_HEAP_MIN_FREE] = ESP.getMinFreeHeap();
+    cursor.gauges[GAUGE_HEAP_LARGEST_BLOCK] = ESP.getMaxAllocHeap();
+    cursor.gauges[GAUGE_CPU_MHZ] = getCpuFrequencyMhz();
+    cursor.gauges[GAUGE_STATIONS] = WiFi.softAPgetStationNum();
+    cursor.gauges[GAUGE_COMMANDS_DROPPED] = _dropped;
+    return cursor;
+}
+
+// One line of a histogram family: a "# TYPE" line, then SERIES_LINES
+// per series. label may be nullptr (single unlabelled series).
+static int formatHistogram(char* out, size_t size, uint16_t index, const char* name,
+                           const char* labelKey, const char* label,
+                           const MetricsHistogram& histogram) {
+    if (index == 0) {
+        return snprintf(out, size, "# TYPE %s histogram\n", name);
+    }
+
+    uint8_t line = (index - 1) % SERIES_LINES;
+    char labels[64];
+    char separator = label ? ',' : '{';    // Before le="..."
+    if (label) {
+        snprintf(labels, sizeof(labels), "{%s=\"%s\"", labelKey, label);
+    } else {
+        labels[0] = '\0';
+    }
+
+    if (line <= DASHBOARD_METRICS_BUCKETS) {
+        uint32_t cumulative = 0;
+        for (uint8_t bucket = 0; bucket <= line; bucket++) {
+            cumulative += histogram.buckets[bucket];
+        }
+        char bound[16];
+        if (line < DASHBOARD_METRICS_BUCKETS) {
+            snprintf(bound, sizeof(bound), "%g", BUCKET_BOUNDS[line] / 1e6);
+        } else {
+            strlcpy(bound, "+Inf", sizeof(bound));
+        }
+        return snprintf(out, size, "%s_bucket%s%cle=\"%s\"} %lu\n", name, labels,
+                        separator, bound, (unsigned long)cumulative);
+    }
+
+    const char* close = label ? "}" : "";
+    if (line == DASHBOARD_METRICS_BUCKETS + 1) {
+        return snprintf(out, size, "%s_sum%s%s %lu.%06lu\n", name, labels, close,
+                        (unsigned long)(histogram.sumUs / 1000000),
+                        (unsigned long)(histogram.sumUs % 1000000));
+    }
+    return snprintf(out, size, "%s_count%s%s %lu\n", name, labels, close,
+                    (unsigned long)histogram.count);
+}
+
+// Line 'index' of the current section, or -1 past its end
+int DashboardMetrics::formatLine(const MetricsCursor& cursor, char* out, size_t size) {
+    const DashboardMetrics& metrics = *cursor.metrics;
+    uint16_t index = cursor.index;
+    uint16_t series = index > 0 ? (index - 1) / SERIES_LINES : 0;
+
+    switch (cursor.section) {
+        case SECTION_GAUGES:
+            if (index >= METRICS_GAUGES) return -1;
+            return snprintf(out, size, "# TYPE %s %s\n%s %lu\n", GAUGES[index].name,
+                            GAUGES[index].type, GAUGES[index].name,
+                            (unsigned long)cursor.gauges[index]);
+        case SECTION_BOOT: {
+            // Stages not reached yet are left out (empty lines)
+            if (index > BOOT_STAGES) return -1;
+            if (index == 0) return snprintf(out, size, "# TYPE dashboard_boot_stage_seconds gauge\n");
+            uint32_t us = DashboardBoot::at((BootStage)(index - 1));
+            if (us == 0) return 0;
+            return snprintf(out, size, "dashboard_boot_stage_seconds{stage=\"%s\"} %lu.%06lu\n",
+                            DashboardBoot::name((BootStage)(index - 1)),
+                            (unsigned long)(us / 1000000), (unsigned long)(us % 1000000));
+        }
+        case SECTION_ROUTES:
+            if (series >= metrics._routeCount) return -1;
+            return formatHistogram(out, size, index, "dashboard_request_duration_seconds",
+                                   "route", metrics._routeNames[series],
+                                   metrics._routes[series]);
+        case SECTION_COMMANDS:
+            if (series >= METRICS_COMMANDS) return -1;
+            return formatHistogram(out, size, index, "dashboard_callback_duration_seconds",
+                                   "command", COMMAND_NAMES[series],
+                                   metrics._commands[series]);
+        case SECTION_POLL:
+            if (series >= 1) return -1;
+            return formatHistogram(out, size, index, "dashboard_poll_duration_seconds",
+                                   nullptr, nullptr, metrics._poll);
+        case SECTION_LOOP:
+            if (series >= 1) return -1;
+            return formatHistogram(out, size, index, "dashboard_loop_interval_seconds",
+                                   nullptr, nullptr, metrics._loop);
+        default:
+            return -1;
+    }
+}
+
+size_t DashboardMetrics::fill(MetricsCursor& cursor, char* buffer, size_t size) {
+    char line[METRICS_LINE_MAX];
+    size_t used = 0;
+
+    while (cursor.section < SECTION_DONE) {
+        int length = formatLine(cursor, line, sizeof(line));
+        if (length < 0) {
+            cursor.section++;
+            cursor.index = 0;
+            continue;
+        }
+        if ((size_t)length >= sizeof(line)) {
+            length = sizeof(line) - 1;      // Truncated; cannot happen with the names above
+        }
+        if (used + length > size) {
+            break;                          // Next piece
+        }
+        memcpy(buffer + used, line, length);
+        used += length;
+        cursor.index++;
+    }
+    return used;
+}
+
+#endif // WEBDASHBOARD_METRICS
@@ -0,0 +1,149 @@
+/*
+ * DashboardMetrics.h
+ *
+ * Low-overhead instrumentation for WebDashboard, served at /api/metrics
+ * in Prometheus text format:
+ *
+ *   - Latency histograms per route, per command type (the application
+ *     callbacks) and for each WebServer poll (handleClient())
+ *   - Loop period histogram (its spread is the loop jitter)
+ *   - Free heap, its low-water mark, largest free block, connected
+ *     stations, open event streams, dropped commands, scheduler overruns,
+ *     station link state and reconnect attempts
+ *   - Boot timeline: when each startup stage was reached (DashboardBoot.h)
+ *
+ * Durations come from the CPU cycle counter (two register reads per
+ * measurement), converted with the CPU clock when recorded; with DFS
+ * (POWER_SAVE) a span that crosses a clock change is approximate.
+ * Histograms have fixed buckets, so recording is a few compares and
+ * increments and never allocates. On the async backend a route's time
+ * covers its handler only; the response is sent afterwards.
+ *
+ * Each histogram is written by one task; /api/metrics reads the 32-bit
+ * counters without locking, so a scrape may be off by a request.
+ *
+ * Build with -DWEBDASHBOARD_METRICS=0 to strip all of it (the route is
+ * then not registered either).
+ */
+
+#ifndef DASHBOARD_METRICS_H
+#define DASHBOARD_METRICS_H
+
+#ifndef WEBDASHBOARD_METRICS
+#define WEBDASHBOARD_METRICS 1
+#endif
+
+#if WEBDASHBOARD_METRICS
+
+#include <Arduino.h>
+#include <esp_idf_version.h>
+#include <esp_cpu.h>
+
+#define DASHBOARD_METRICS_ROUTES 20     // Routes with their own histogram
+#define DASHBOARD_METRICS_BUCKETS 11    // Bucket bounds (plus +Inf)
+#define METRICS_NO_ROUTE 0xFF           // addRoute() when full
+
+// Command types as labelled in the callback histogram; the first ones
+// match DashboardCommandType
+enum MetricsCommand : uint8_t {
+    METRICS_OUTPUT,
+    METRICS_MODE,
+    METRICS_RESET,
+    METRICS_CUSTOM,
+    METRICS_CONTROL,
+    METRICS_DEFERRED,           // defer()red actions
+    METRICS_COMMANDS
+};
+
+// Gauges a scrape reports, captured when the request arrives
+enum MetricsGauge : uint8_t {
+    GAUGE_UPTIME,
+    GAUGE_HEAP_FREE,
+    GAUGE_HEAP_MIN_FREE,
+    GAUGE_HEAP_LARGEST_BLOCK,
+    GAUGE_CPU_MHZ,
+    GAUGE_STATIONS,
+    GAUGE_STREAMS,
+    GAUGE_COMMANDS_DROPPED,
+    GAUGE_SCHEDULER_OVERRUNS,
+    GAUGE_STA_CONNECTED,
+    GAUGE_STA_RECONNECTS,
+    GAUGE_PARAM_WRITES,
+    GAUGE_LOG_DROPPED,
+    GAUGE_SENSOR_READS,
+    GAUGE_SENSOR_FAILURES,
+    GAUGE_RULE_TRIPS,
+    GAUGE_REQUESTS_LIMITED,
+    GAUGE_REQUESTS_BUSY,
+    GAUGE_RESPONSES_CACHED,
+    METRICS_GAUGES
+};
+
+struct MetricsHistogram {
+    uint32_t buckets[DASHBOARD_METRICS_BUCKETS + 1];   // Last one: +Inf
+    uint64_t sumUs;
+    uint32_t count;
+};
+
+class DashboardMetrics;
+
+// Position in a /api/metrics response (see DashboardRequest::sendChunked)
+struct MetricsCursor {
+    const DashboardMetrics* metrics;
+    uint32_t gauges[METRICS_GAUGES];
+    uint8_t section;
+    uint16_t index;
+};
+
+class DashboardMetrics {
+public:
+    DashboardMetrics();
+
+    static uint32_t cycles() {
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+        return esp_cpu_get_cycle_count();
+#else
+        return esp_cpu_get_ccount();
+#endif
+    }
+
+    // Histogram slot for a route (path must stay valid); a path added
+    // again (GET and POST handlers) shares its slot
+    uint8_t addRoute(const char* path);
+
+    // 'start' is cycles() when the work began
+    void recordRoute(uint8_t route, uint32_t start);
+    void recordCommand(uint8_t command, uint32_t start);
+    void recordPoll(uint32_t start);
+
+    // Call at the top of every loop()
+    void recordLoop();
+
+    void commandDropped() { _dropped++; }
+    uint32_t dropped() const { return _dropped; }
+
+    // Start a scrape: system gauges filled in, the caller adds the rest
+    // (GAUGE_STREAMS and everything from GAUGE_SCHEDULER_OVERRUNS on)
+    MetricsCursor cursor() const;
+
+    // sendChunked() filler: as many whole lines as fit
+    static size_t fill(MetricsCursor& cursor, char* buffer, size_t size);
+
+private:
+    const char* _routeNames[DASHBOARD_METRICS_ROUTES];
+    MetricsHistogram _routes[DASHBOARD_METRICS_ROUTES];
+    uint8_t _routeCount;
+    MetricsHistogram _commands[METRICS_COMMANDS];
+    MetricsHistogram _poll;
+    MetricsHistogram _loop;
+    uint32_t _lastLoop;         // micros() of the previous loop()
+    uint32_t _dropped;
+
+    static void record(MetricsHistogram& histogram, uint32_t us);
+    static uint32_t elapsedUs(uint32_t start);
+    static int formatLine(const MetricsCursor& cursor, char* out, size_t size);
+};
+
+#endif // WEBDASHBOARD_METRICS
+
+#endif // DASHBOARD_METRICS_H
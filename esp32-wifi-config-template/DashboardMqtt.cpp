@@ -0,0 +1,294 @@
+/*
+ * DashboardMqtt.cpp
+ *
+ * Change coalescing, telemetry batches and the MQTT task.
+ */
+
+#include "DashboardMqtt.h"
+
+#if WEBDASHBOARD_MQTT
+
+#include <math.h>
+
+#define MQTT_TASK_STACK 4096
+#define MQTT_TASK_PERIOD 50         // ms between keep-alive/queue checks
+#define MQTT_ENTRY_MAX 32           // One "id":value pair
+
+// Longest state payload: every value plus the mode
+#define MQTT_STATE_MAX (WEBDASHBOARD_MAX_CHANNELS * 16 + DASHBOARD_MQTT_MODE + 16)
+
+DashboardMqtt::DashboardMqtt() {
+    memset(_values, 0, sizeof(_values));
+    _count = 0;
+    _dirty = 0;
+    _mode[0] = '\0';
+    _modeDirty = false;
+    portMUX_TYPE unlocked = portMUX_INITIALIZER_UNLOCKED;
+    _lock = unlocked;
+
+    _head = 0;
+    _queued = 0;
+
+    _host = nullptr;
+    _port = 1883;
+    _user = nullptr;
+    _password = nullptr;
+    _base = nullptr;
+    _clientId = nullptr;
+    _telemetryTopic[0] = '\0';
+    _stateTopic[0] = '\0';
+    _statusTopic[0] = '\0';
+
+    _client.setClient(_socket);
+    _task = nullptr;
+    _connected = false;
+    _backoff = DASHBOARD_MQTT_RETRY_MIN;
+    _nextAttempt = 0;
+    _stateStale = false;
+    _lastState = 0;
+    _sent = 0;
+    _dropped = 0;
+}
+
+void DashboardMqtt::setServer(const char* host, uint16_t port) {
+    _host = host;
+    _port = port;
+}
+
+void DashboardMqtt::setCredentials(const char* user, const char* password) {
+    _user = user;
+    _password = password;
+}
+
+void DashboardMqtt::setTopic(const char* base) {
+    _base = base;
+}
+
+void DashboardMqtt::begin(const char* clientId, BaseType_t core, UBaseType_t priority) {
+    if (_task) {
+        return;
+    }
+    if (!_host) {
+        Serial.println("MQTT: no server set, not started");
+        return;
+    }
+
+    _clientId = clientId;
+    char base[DASHBOARD_MQTT_TOPIC];
+    if (_base) {
+        strlcpy(base, _base, sizeof(base));
+    } else {
+        snprintf(base, sizeof(base), "dashboard/%s", clientId);
+    }
+    snprintf(_telemetryTopic, sizeof(_telemetryTopic), "%s/telemetry", base);
+    snprintf(_stateTopic, sizeof(_stateTopic), "%s/state", base);
+    snprintf(_statusTopic, sizeof(_statusTopic), "%s/status", base);
+
+    _client.setServer(_host, _port);
+    xTaskCreatePinnedToCore(taskMain, "mqtt", MQTT_TASK_STACK, this, priority, &_task, core);
+    Serial.printf("MQTT: %s:%u, topics %s/...\n", _host, (unsigned)_port, base);
+}
+
+// ==================== CHANGE COALESCING ====================
+
+static uint32_t channelMask(uint8_t count) {
+    return count >= 32 ? 0xFFFFFFFFUL : (1UL << count) - 1;
+}
+
+void DashboardMqtt::offer(const DashboardChannel* channels, uint8_t count, const char* mode) {
+    if (count > WEBDASHBOARD_MAX_CHANNELS) {
+        count = WEBDASHBOARD_MAX_CHANNELS;
+    }
+
+    portENTER_CRITICAL(&_lock);
+    if (count != _count) {
+        _count = count;
+        _dirty = channelMask(count);
+    }
+    for (uint8_t id = 0; id < count; id++) {
+        // Bitwise, so NaN -> NaN is no change
+        float value = channels[id].value;
+        if (memcmp(&value, &_values[id], sizeof(value)) != 0) {
+            _values[id] = value;
+            _dirty |= 1UL << id;
+        }
+    }
+    if (mode && strncmp(mode, _mode, sizeof(_mode) - 1) != 0) {
+        copyJsonSafe(_mode, sizeof(_mode), mode);
+        _modeDirty = true;
+    }
+    portEXIT_CRITICAL(&_lock);
+}
+
+static int formatValue(char* out, size_t size, const char* prefix, float value) {
+    if (isnan(value) || isinf(value)) {
+        return snprintf(out, size, "%snull", prefix);
+    }
+    return snprintf(out, size, "%s%.6g", prefix, value);
+}
+
+// One tick: everything that changed becomes one batch (or several if it
+// does not fit one message)
+void DashboardMqtt::stageBatches() {
+    float values[WEBDASHBOARD_MAX_CHANNELS];
+    char mode[DASHBOARD_MQTT_MODE];
+
+    portENTER_CRITICAL(&_lock);
+    uint8_t count = _count;
+    uint32_t dirty = _dirty & channelMask(count);
+    bool modeDirty = _modeDirty;
+    memcpy(values, _values, sizeof(values));
+    memcpy(mode, _mode, sizeof(mode));
+    _dirty = 0;
+    _modeDirty = false;
+    portEXIT_CRITICAL(&_lock);
+
+    if (dirty || modeDirty) {
+        _stateStale = true;
+    }
+
+    char payload[DASHBOARD_MQTT_MESSAGE];
+    uint8_t id = 0;
+    while (dirty || modeDirty) {
+        size_t length = snprintf(payload, sizeof(payload), "{\"t\":%lu,\"c\":{",
+                                 (unsigned long)millis());
+        bool first = true;
+        for (; id < count; id++) {
+            if (!(dirty & (1UL << id))) continue;
+
+            char entry[MQTT_ENTRY_MAX];
+            char prefix[8];
+            snprintf(prefix, sizeof(prefix), "%s\"%u\":", first ? "" : ",", (unsigned)id);
+            int n = formatValue(entry, sizeof(entry), prefix, values[id]);
+            // Leave room for the closing braces and the mode
+            if (length + n + DASHBOARD_MQTT_MODE + 12 > sizeof(payload)) break;
+            memcpy(payload + length, entry, n);
+            length += n;
+            first = false;
+            dirty &= ~(1UL << id);
+        }
+
+        payload[length++] = '}';
+        if (modeDirty) {
+            length += snprintf(payload + length, sizeof(payload) - length, ",\"m\":\"%s\"", mode);
+            modeDirty = false;
+        }
+        payload[length++] = '}';
+        enqueue(payload, length);
+    }
+}
+
+void DashboardMqtt::enqueue(const char* payload, size_t length) {
+    if (_queued == DASHBOARD_MQTT_QUEUE) {
+        // Telemetry is best effort: the oldest batch makes room
+        _head = (_head + 1) % DASHBOARD_MQTT_QUEUE;
+        _queued--;
+        _dropped++;
+    }
+
+    Batch& batch = _queue[(_head + _queued) % DASHBOARD_MQTT_QUEUE];
+    memcpy(batch.payload, payload, length);
+    batch.length = length;
+    _queued++;
+}
+
+// ==================== MQTT TASK ====================
+
+static bool send(PubSubClient& client, const char* topic, const char* payload,
+                 size_t length, bool retained) {
+    return client.beginPublish(topic, length, retained)
+        && client.write((const uint8_t*)payload, length) == length
+        && client.endPublish();
+}
+
+// Every value, sent retained whenever the connection comes up
+bool DashboardMqtt::publishState() {
+    float values[WEBDASHBOARD_MAX_CHANNELS];
+    char mode[DASHBOARD_MQTT_MODE];
+
+    portENTER_CRITICAL(&_lock);
+    uint8_t count = _count;
+    memcpy(values, _values, sizeof(values));
+    memcpy(mode, _mode, sizeof(mode));
+    portEXIT_CRITICAL(&_lock);
+
+    char payload[MQTT_STATE_MAX];
+    size_t length = snprintf(payload, sizeof(payload), "{\"v\":[");
+    for (uint8_t id = 0; id < count; id++) {
+        length += formatValue(payload + length, sizeof(payload) - length,
+                              id > 0 ? "," : "", values[id]);
+    }
+    length += snprintf(payload + length, sizeof(payload) - length, "],\"m\":\"%s\"}", mode);
+    if (!send(_client, _stateTopic, payload, length, true)) {
+        return false;
+    }
+    _stateStale = false;
+    _lastState = millis();
+    _sent++;
+    return true;
+}
+
+bool DashboardMqtt::connect() {
+    if (!_client.connect(_clientId, _user, _password, _statusTopic, 1, true, "offline")) {
+        return false;
+    }
+    send(_client, _statusTopic, "online", 6, true);
+    publishState();
+    return true;
+}
+
+void DashboardMqtt::drain() {
+    while (_queued > 0 && _client.connected()) {
+        const Batch& batch = _queue[_head];
+        if (!send(_client, _telemetryTopic, batch.payload, batch.length, false)) {
+            break;                  // Kept; retried after the reconnect
+        }
+        _head = (_head + 1) % DASHBOARD_MQTT_QUEUE;
+        _queued--;
+        _sent++;
+    }
+}
+
+void DashboardMqtt::taskMain(void* arg) {
+    DashboardMqtt* mqtt = static_cast<DashboardMqtt*>(arg);
+    uint32_t lastTick = millis();
+
+    for (;;) {
+        uint32_t now = millis();
+        if (now - lastTick >= DASHBOARD_MQTT_INTERVAL) {
+            lastTick = now;
+            mqtt->stageBatches();
+        }
+
+        if (mqtt->_client.connected()) {
+            mqtt->_client.loop();   // Keep-alive
+            mqtt->drain();
+            if (mqtt->_stateStale && now - mqtt->_lastState >= DASHBOARD_MQTT_STATE_INTERVAL) {
+                mqtt->publishState();
+            }
+        } else {
+            if (mqtt->_connected) {
+                mqtt->_connected = false;
+                mqtt->_nextAttempt = now;
+                Serial.println("MQTT: disconnected");
+            }
+            // Only count attempts that had a network to go through
+            if (WiFi.isConnected() && (int32_t)(now - mqtt->_nextAttempt) >= 0) {
+                if (mqtt->connect()) {
+                    mqtt->_connected = true;
+                    mqtt->_backoff = DASHBOARD_MQTT_RETRY_MIN;
+                    Serial.println("MQTT: connected");
+                    mqtt->drain();
+                } else {
+                    mqtt->_nextAttempt = millis() + mqtt->_backoff;
+                    mqtt->_backoff = mqtt->_backoff * 2 > DASHBOARD_MQTT_RETRY_MAX
+                        ? DASHBOARD_MQTT_RETRY_MAX : mqtt->_backoff * 2;
+                }
+            }
+        }
+
+        vTaskDelay(pdMS_TO_TICKS(MQTT_TASK_PERIOD));
+    }
+}
+
+#endif // WEBDASHBOARD_MQTT
@@ -0,0 +1,134 @@
+/*
+ * DashboardMqtt.h
+ *
+ * Pushes the dashboard's channel values to an MQTT broker (PubSubClient),
+ * fed from the same publish() path as the web page:
+ *
+ *   DashboardMqtt mqtt;
+ *   mqtt.setServer("broker.plant.lan");
+ *   dashboard.setMqtt(mqtt);               // Before begin()
+ *
+ * Build with -DWEBDASHBOARD_MQTT=1 and PubSubClient in lib_deps (see the
+ * esp32dev-mqtt environment in platformio.ini).
+ *
+ * Topics, under <base> (default "dashboard/<hostname>"):
+ *   <base>/telemetry   {"t":<ms>,"c":{"<id>":value,...},"m":"<mode>"}
+ *                      the channels that changed since the previous batch
+ *   <base>/state       {"v":[...],"m":"<mode>"}, every value (retained)
+ *   <base>/status      "online", or "offline" as the last will (retained)
+ *
+ * Flow: publish() only notes the latest value of each changed channel
+ * (a copy under a spinlock, no I/O). Every DASHBOARD_MQTT_INTERVAL ms the
+ * MQTT task turns those into one telemetry batch, so a channel that
+ * changes ten times in a tick costs one entry and a tick costs one
+ * message, not one per channel. Batches wait in a ring of
+ * DASHBOARD_MQTT_QUEUE while the broker is unreachable.
+ *
+ * Delivery classes (PubSubClient publishes at QoS 0 only, so these
+ * decide what survives an outage instead):
+ *   - state: never queued; rebuilt from the current values and sent
+ *     retained first on every (re)connect (and at most every
+ *     DASHBOARD_MQTT_STATE_INTERVAL ms after changes), so subscribers
+ *     always get a recent picture
+ *   - telemetry: best effort history; when the ring is full the oldest
+ *     batch is dropped (dropped() counts them)
+ *
+ * Connecting (with backoff, only while the station is joined), sending
+ * and the keep-alive all run on the MQTT task; a slow or dead broker
+ * never blocks loop() or the application logic.
+ */
+
+#ifndef DASHBOARD_MQTT_H
+#define DASHBOARD_MQTT_H
+
+#ifndef WEBDASHBOARD_MQTT
+#define WEBDASHBOARD_MQTT 0
+#endif
+
+#if WEBDASHBOARD_MQTT
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <PubSubClient.h>
+#include "DashboardChannels.h"
+
+#define DASHBOARD_MQTT_INTERVAL 1000    // ms per telemetry batch (tick)
+#define DASHBOARD_MQTT_STATE_INTERVAL 60000 // ms, min between state refreshes
+#define DASHBOARD_MQTT_QUEUE 16         // Batches kept while disconnected
+#define DASHBOARD_MQTT_MESSAGE 256      // Longest payload; bigger batches are split
+#define DASHBOARD_MQTT_TOPIC 64         // Longest topic incl. '\0'
+#define DASHBOARD_MQTT_MODE 16          // Mode string incl. '\0'
+#define DASHBOARD_MQTT_RETRY_MIN 1000   // ms before the first reconnect
+#define DASHBOARD_MQTT_RETRY_MAX 60000  // ms, upper bound of the backoff
+
+class DashboardMqtt {
+public:
+    DashboardMqtt();
+
+    // Call before begin()
+    void setServer(const char* host, uint16_t port = 1883);
+    void setCredentials(const char* user, const char* password);
+    void setTopic(const char* base);    // Default: dashboard/<clientId>
+
+    // Start the MQTT task (WebDashboard::begin() does this with the
+    // mDNS hostname as client id)
+    void begin(const char* clientId, BaseType_t core = 0, UBaseType_t priority = 1);
+
+    // Publishing task: remember what changed (no network I/O)
+    void offer(const DashboardChannel* channels, uint8_t count, const char* mode);
+
+    bool connected() const { return _connected; }
+    uint32_t sent() const { return _sent; }         // Messages published
+    uint32_t dropped() const { return _dropped; }   // Telemetry batches lost
+    uint8_t queued() const { return _queued; }
+
+private:
+    // Latest values, shared with the publishing task under _lock
+    float _values[WEBDASHBOARD_MAX_CHANNELS];
+    uint8_t _count;
+    uint32_t _dirty;            // Bit n: channel n changed since the last batch
+    char _mode[DASHBOARD_MQTT_MODE];
+    bool _modeDirty;
+    portMUX_TYPE _lock;
+
+    // Outbound telemetry ring (MQTT task only)
+    struct Batch {
+        uint16_t length;
+        char payload[DASHBOARD_MQTT_MESSAGE];
+    };
+    Batch _queue[DASHBOARD_MQTT_QUEUE];
+    uint8_t _head;              // Oldest batch
+    volatile uint8_t _queued;
+
+    const char* _host;
+    uint16_t _port;
+    const char* _user;
+    const char* _password;
+    const char* _base;
+    const char* _clientId;
+    char _telemetryTopic[DASHBOARD_MQTT_TOPIC];
+    char _stateTopic[DASHBOARD_MQTT_TOPIC];
+    char _statusTopic[DASHBOARD_MQTT_TOPIC];
+
+    WiFiClient _socket;
+    PubSubClient _client;
+    TaskHandle_t _task;
+    volatile bool _connected;
+    uint32_t _backoff;
+    uint32_t _nextAttempt;
+    bool _stateStale;           // Values changed since the last state message
+    uint32_t _lastState;        // millis() of the last state message
+    volatile uint32_t _sent;
+    volatile uint32_t _dropped;
+
+    static void taskMain(void* arg);
+    void stageBatches();
+    void enqueue(const char* payload, size_t length);
+    bool connect();
+    bool publishState();
+    void drain();
+};
+
+#endif // WEBDASHBOARD_MQTT
+
+#endif // DASHBOARD_MQTT_H
@@ -0,0 +1,307 @@
+/*
+ * DashboardPage.h
+ *
+ * GENERATED by tools/build_html.py from web/dashboard.html - do not edit.
+ *
+ * Original: 17714 bytes, gzipped: 4564 bytes
+ */
+
+#ifndef DASHBOARD_PAGE_H
+#define DASHBOARD_PAGE_H
+
+#include <Arduino.h>
+
+#define DASHBOARD_PAGE_ETAG "\"a3cdf0ea2ca85409\""
+
+const size_t DASHBOARD_PAGE_GZ_LEN = 4564;
+
+const uint8_t DASHBOARD_PAGE_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xdd, 0x5c, 0xdd, 0x6e, 0xe3, 0xc8,
+    0x95, 0xbe, 0xef, 0xa7, 0xa8, 0xe6, 0x4c, 0x86, 0xe2, 0x46, 0xa2, 0x25, 0xf9, 0xb7, 0x25, 0x4b,
+    0x93, 0x9e, 0x6e, 0x1b, 0xd3, 0x41, 0x77, 0xdb, 0x88, 0xdd, 0x01, 0x82, 0x46, 0x63, 0xa7, 0x44,
+    0x16, 0x25, 0xc6, 0x14, 0x49, 0x90, 0x94, 0xdc, 0x8e, 0xc7, 0x77, 0xb9, 0xda, 0x8b, 0x0d, 0x90,
+    0x5d, 0x20, 0x48, 0x72, 0x11, 0xcc, 0xd5, 0xbe, 0xc2, 0x3e, 0x4f, 0x5e, 0x60, 0xf3, 0x08, 0x7b,
+    0x4e, 0x55, 0x91, 0x2a, 0x92, 0x45, 0x4a, 0x9e, 0xee, 0x0c, 0x16, 0xdb, 0x03, 0xd8, 0x12, 0x59,
+    0x75, 0xea, 0xfc, 0x7e, 0x75, 0xce, 0xa9, 0xf2, 0x9c, 0x3e, 0x7d, 0x79, 0xf1, 0xe2, 0xfa, 0x37,
+    0x97, 0x67, 0x64, 0x91, 0x2d, 0x83, 0xe9, 0x93, 0xd3, 0xfc, 0x17, 0xa3, 0xee, 0xf4, 0x09, 0x81,
+    0x7f, 0xa7, 0x4b, 0x96, 0x51, 0xe2, 0x2c, 0x68, 0x92, 0xb2, 0x6c, 0x62, 0xbc, 0xbb, 0x3e, 0xef,
+    0x9d, 0x18, 0xea, 0xab, 0x90, 0x2e, 0xd9, 0xc4, 0x58, 0xfb, 0xec, 0x36, 0x8e, 0x92, 0xcc, 0x20,
+    0x4e, 0x14, 0x66, 0x2c, 0x84, 0xa1, 0xb7, 0xbe, 0x9b, 0x2d, 0x26, 0x2e, 0x5b, 0xfb, 0x0e, 0xeb,
+    0xf1, 0x2f, 0x5d, 0xe2, 0x87, 0x7e, 0xe6, 0xd3, 0xa0, 0x97, 0x3a, 0x34, 0x60, 0x93, 0x81, 0xdd,
+    0xcf, 0x49, 0x65, 0x7e, 0x16, 0xb0, 0xe9, 0xd9, 0xd5, 0xe5, 0xfe, 0x90, 0xbc, 0xa4, 0xe9, 0x62,
+    0x16, 0xd1, 0xc4, 0x3d, 0xdd, 0x13, 0x8f, 0xc5, 0x90, 0x34, 0xbb, 0xcb, 0x3f, 0xe3, 0xbf, 0x7f,
+    0x21, 0xf7, 0x64, 0x49, 0x93, 0xb9, 0x1f, 0x8e, 0x48, 0x7f, 0x4c, 0x62, 0xea, 0xba, 0x7e, 0x38,
+    0xe7, 0x9f, 0x67, 0xd1, 0xc7, 0x5e, 0xea, 0xff, 0x8e, 0x7f, 0x9d, 0x45, 0x89, 0xcb, 0x92, 0x1e,
+    0x3c, 0x1a, 0x93, 0x87, 0x62, 0xf2, 0x2c, 0x72, 0xef, 0xc8, 0x7d, 0xf1, 0x15, 0xff, 0x79, 0xc0,
+    0x77, 0xcf, 0xa3, 0x4b, 0x3f, 0xb8, 0x1b, 0x91, 0x1e, 0x8d, 0xe3, 0x80, 0xf5, 0xd2, 0xbb, 0x34,
+    0x63, 0xcb, 0x2e, 0xf9, 0x26, 0xf0, 0xc3, 0x9b, 0x37, 0xd4, 0xb9, 0xe2, 0xdf, 0xcf, 0x61, 0x64,
+    0x97, 0x98, 0x57, 0x6c, 0x1e, 0x31, 0xf2, 0xee, 0x95, 0xd9, 0x25, 0xbf, 0x8a, 0x66, 0x51, 0x16,
+    0x75, 0xc9, 0xf3, 0x04, 0x84, 0xeb, 0x92, 0x94, 0x86, 0x69, 0x2f, 0x65, 0x89, 0xef, 0x8d, 0x4b,
+    0x4b, 0xcc, 0xa8, 0x73, 0x33, 0x4f, 0xa2, 0x55, 0xe8, 0x8e, 0x08, 0x50, 0x64, 0x34, 0xe9, 0xcd,
+    0x13, 0xea, 0xfa, 0xa0, 0xae, 0xce, 0x60, 0xff, 0xd0, 0x65, 0xf3, 0x2e, 0xf9, 0xe2, 0xe8, 0xe8,
+    0x98, 0x31, 0x4a, 0xfa, 0x3f, 0x83, 0xcf, 0xc7, 0x47, 0x07, 0x33, 0x3a, 0x24, 0x83, 0x7e, 0xff,
+    0x67, 0x56, 0x99, 0xd4, 0xd2, 0x0f, 0x7b, 0x0b, 0xe6, 0xcf, 0x17, 0xd9, 0x08, 0x5f, 0xaf, 0x17,
+    0xe5, 0xd7, 0x85, 0x36, 0x86, 0xfd, 0xf8, 0x63, 0xf9, 0x95, 0x13, 0x05, 0x51, 0x32, 0x22, 0x5f,
+    0xec, 0xef, 0xef, 0x6f, 0x5e, 0x6c, 0x34, 0x63, 0xa3, 0xfd, 0x28, 0x30, 0x97, 0x54, 0xf4, 0xb3,
+    0xa4, 0x1f, 0x85, 0x15, 0x47, 0xe4, 0xa4, 0x5f, 0xa3, 0x5a, 0x58, 0x82, 0xd0, 0x55, 0x16, 0x35,
+    0x8b, 0x7d, 0xbb, 0xf0, 0x33, 0x56, 0x79, 0x2d, 0x2c, 0x84, 0x8a, 0x58, 0xa5, 0x20, 0xcd, 0x51,
+    0x95, 0x36, 0x37, 0xe7, 0x82, 0xba, 0xd1, 0x2d, 0xd2, 0x47, 0x89, 0xc8, 0x11, 0xfe, 0x48, 0xe6,
+    0x33, 0xda, 0xe9, 0x77, 0xf9, 0x7f, 0xf6, 0x7e, 0x45, 0x41, 0xd1, 0x9a, 0x25, 0x5e, 0x80, 0x53,
+    0x16, 0xbe, 0xeb, 0xb2, 0x50, 0x27, 0x2b, 0x7a, 0x79, 0x4d, 0xce, 0xcf, 0x68, 0x24, 0xa9, 0x6a,
+    0x8d, 0xcc, 0x85, 0x7d, 0xf6, 0x6b, 0x9a, 0xcc, 0xd8, 0xc7, 0xac, 0x47, 0x03, 0x7f, 0x0e, 0xda,
+    0x74, 0x60, 0x51, 0x96, 0x68, 0x59, 0x1f, 0x80, 0xfb, 0x73, 0x97, 0x05, 0x47, 0x67, 0x60, 0xe7,
+    0x13, 0xa0, 0x23, 0xad, 0x00, 0xce, 0x9e, 0x65, 0xd1, 0x72, 0x44, 0x0e, 0xe3, 0x92, 0xd3, 0xdb,
+    0xe9, 0x6a, 0xc6, 0x03, 0x0a, 0xa6, 0x46, 0x31, 0x75, 0xfc, 0x0c, 0x3c, 0xbd, 0x6f, 0x3f, 0x1b,
+    0xab, 0x84, 0x06, 0x07, 0x95, 0x49, 0x32, 0x9e, 0x61, 0x4e, 0x99, 0xe9, 0x12, 0x61, 0xe6, 0x64,
+    0x7e, 0x14, 0xb6, 0x68, 0xf2, 0x0b, 0xef, 0xc4, 0x7b, 0xe6, 0xd1, 0x76, 0xcb, 0x0f, 0xab, 0xba,
+    0x68, 0x71, 0xe3, 0x8a, 0xa8, 0xe5, 0x01, 0x1a, 0xd6, 0x16, 0x43, 0x5d, 0xbc, 0x4b, 0x99, 0x4f,
+    0xb6, 0x50, 0x1f, 0x1c, 0x36, 0x45, 0x91, 0x70, 0x84, 0xf2, 0x3b, 0xd7, 0x4f, 0xe3, 0x80, 0x82,
+    0x6e, 0xbd, 0x80, 0x55, 0xa6, 0x71, 0xbb, 0xf6, 0xc0, 0x1d, 0x96, 0x69, 0x9b, 0x75, 0x15, 0xae,
+    0x47, 0xa3, 0x19, 0xf3, 0xa2, 0x84, 0x55, 0xb8, 0x97, 0x56, 0x19, 0x11, 0xe3, 0xef, 0x7f, 0xfa,
+    0x83, 0xa1, 0x65, 0x3e, 0xc9, 0xd1, 0xa1, 0xca, 0xbb, 0x2a, 0xf9, 0xb0, 0x41, 0x6d, 0x6b, 0x1a,
+    0xac, 0x58, 0x4f, 0x4a, 0x52, 0x59, 0xbb, 0x90, 0x6f, 0x9e, 0xf8, 0x6e, 0x99, 0x34, 0x3e, 0xe9,
+    0x81, 0x74, 0xf0, 0x3e, 0x63, 0x3d, 0x50, 0xd2, 0x6a, 0x19, 0x82, 0xa4, 0x09, 0x8b, 0x19, 0xcd,
+    0x3a, 0x08, 0x0d, 0x3d, 0xcf, 0x07, 0xf0, 0x04, 0xf8, 0x02, 0x3c, 0xe9, 0x0c, 0x11, 0x48, 0xba,
+    0x64, 0xe0, 0x25, 0x56, 0x25, 0x74, 0xe6, 0x34, 0xd6, 0xa9, 0xbd, 0xd5, 0x2e, 0x35, 0xf6, 0x01,
+    0x38, 0x5a, 0x5c, 0xb2, 0x2d, 0x2c, 0xeb, 0x2b, 0x57, 0x7c, 0xf5, 0xa4, 0xe1, 0x7d, 0xc0, 0x3c,
+    0xd0, 0x39, 0xc4, 0x10, 0x49, 0xa3, 0xc0, 0x77, 0xeb, 0x0e, 0x52, 0x63, 0x32, 0xa0, 0x33, 0x16,
+    0xb4, 0xf8, 0xe6, 0xb0, 0xd9, 0xf5, 0x8e, 0x34, 0xc8, 0x91, 0x25, 0xb0, 0xf9, 0x80, 0xc3, 0x80,
+    0x76, 0x56, 0x71, 0xcc, 0x12, 0x87, 0xa6, 0x15, 0x21, 0x03, 0x96, 0x81, 0xdb, 0xf5, 0x52, 0x44,
+    0x00, 0xbe, 0x61, 0xda, 0xdb, 0xd4, 0xdc, 0xae, 0xe5, 0x70, 0xb5, 0x9c, 0xd5, 0x50, 0x54, 0x91,
+    0x60, 0x7f, 0xa8, 0x75, 0xc0, 0x5b, 0xb9, 0x7b, 0xcd, 0xa2, 0xc0, 0x7d, 0xdc, 0x0e, 0x25, 0x96,
+    0x5d, 0x41, 0x2a, 0xd1, 0xa2, 0xb6, 0xa3, 0x26, 0xb5, 0x3d, 0x7b, 0xf6, 0x4c, 0x2b, 0xac, 0xb0,
+    0x5c, 0x93, 0xa8, 0x18, 0x6f, 0x49, 0x14, 0xa4, 0x4d, 0xa1, 0x50, 0x0f, 0x75, 0x7c, 0xd2, 0xbb,
+    0x4d, 0xd0, 0x8f, 0xf1, 0xa7, 0xce, 0xbd, 0x1b, 0x30, 0x6b, 0xb6, 0x02, 0xb5, 0x57, 0xc1, 0x14,
+    0xc9, 0xc1, 0x94, 0x7a, 0x16, 0x20, 0xf7, 0xe4, 0xc1, 0x61, 0xbf, 0x11, 0x3d, 0xd1, 0x87, 0xc8,
+    0xf0, 0x40, 0xef, 0xb2, 0x23, 0x12, 0x46, 0x21, 0x7b, 0x9c, 0xb3, 0x57, 0xf7, 0x8b, 0x66, 0xeb,
+    0x1e, 0xf5, 0xfb, 0x15, 0x33, 0xac, 0x92, 0x14, 0xed, 0x10, 0x47, 0x7e, 0x19, 0xfd, 0xb8, 0x07,
+    0xa3, 0xf3, 0xfa, 0x88, 0x7c, 0x23, 0x80, 0xca, 0x00, 0x5c, 0x73, 0x3f, 0x25, 0xac, 0xe4, 0xc1,
+    0x8a, 0x4d, 0x66, 0x59, 0xd8, 0x8b, 0x13, 0x1f, 0xec, 0x77, 0xf7, 0x53, 0xef, 0xe1, 0x7a, 0x2e,
+    0x46, 0x0b, 0xcc, 0x3a, 0x60, 0xa7, 0x54, 0x82, 0x90, 0x7f, 0x44, 0x34, 0xfc, 0x4d, 0xa7, 0x07,
+    0x66, 0xb0, 0xc6, 0x95, 0x74, 0x06, 0xa1, 0x82, 0xdb, 0x87, 0x67, 0x33, 0x83, 0xfe, 0x10, 0xe0,
+    0x70, 0x78, 0xd4, 0x25, 0xc3, 0xfd, 0x83, 0x2e, 0xc8, 0x7f, 0x60, 0x8d, 0xab, 0x8b, 0xa5, 0x2b,
+    0xc7, 0x61, 0x29, 0x78, 0x62, 0x79, 0x83, 0x1d, 0x9e, 0xd0, 0xe3, 0x83, 0xc3, 0x71, 0x99, 0xe1,
+    0x86, 0xb9, 0x05, 0xa3, 0x65, 0x0a, 0x83, 0x93, 0x93, 0xfd, 0x93, 0x71, 0x3b, 0xf7, 0x15, 0x82,
+    0x2e, 0x0d, 0xe7, 0x75, 0x4a, 0xae, 0xb3, 0x7f, 0xb8, 0x95, 0x17, 0x31, 0x55, 0xcf, 0x8a, 0x73,
+    0x32, 0xc4, 0xe8, 0x7f, 0x14, 0x2b, 0xb0, 0x67, 0x46, 0xa1, 0xcb, 0x9d, 0xa1, 0x4c, 0xec, 0xc8,
+    0x39, 0x3e, 0x3c, 0x76, 0xb7, 0x69, 0x26, 0x9f, 0xad, 0x67, 0xe8, 0x90, 0x1e, 0x0d, 0x8f, 0x1e,
+    0xa9, 0x9b, 0x5b, 0x9a, 0x84, 0x10, 0x7f, 0x55, 0x52, 0x9e, 0xe7, 0x0c, 0xfa, 0xc7, 0xe3, 0x12,
+    0xcc, 0x35, 0x4c, 0xd5, 0xf3, 0xc2, 0xfa, 0x14, 0x32, 0xf0, 0xdd, 0x79, 0x49, 0x33, 0x9a, 0xad,
+    0x1a, 0x91, 0xcb, 0x0f, 0x31, 0x42, 0x7a, 0xb3, 0x20, 0x72, 0x6e, 0x1a, 0xf0, 0x23, 0xf7, 0xd1,
+    0x56, 0x90, 0x18, 0xee, 0x9e, 0x67, 0x6c, 0x47, 0x89, 0x1d, 0xb6, 0xb2, 0x9a, 0x80, 0x3d, 0xc4,
+    0xcc, 0x8a, 0x1f, 0x1e, 0x30, 0xd7, 0xa5, 0x1b, 0x55, 0x0f, 0x0e, 0x0f, 0x8f, 0x87, 0x07, 0x63,
+    0xdd, 0x5c, 0xcf, 0xab, 0xd9, 0xe9, 0xc4, 0x3d, 0x56, 0x27, 0x1f, 0x0f, 0x07, 0x4e, 0x79, 0x72,
+    0xca, 0x02, 0xc8, 0xd3, 0xb0, 0xaa, 0x8d, 0x57, 0xd9, 0xfb, 0xec, 0x2e, 0x86, 0x42, 0x18, 0x39,
+    0x37, 0x3e, 0x94, 0x9f, 0x89, 0x1d, 0xd2, 0xf8, 0x50, 0x31, 0x41, 0x8e, 0xdc, 0x00, 0x3a, 0x4d,
+    0xc0, 0xdd, 0x6f, 0xc2, 0xec, 0xe1, 0x26, 0xc3, 0x60, 0x7d, 0xfc, 0xef, 0x33, 0x02, 0x78, 0x35,
+    0xc9, 0x6a, 0xd8, 0xa6, 0x84, 0xf4, 0x23, 0x2f, 0x72, 0x56, 0xa9, 0x94, 0x57, 0x7c, 0xa9, 0x88,
+    0x19, 0xad, 0x32, 0xf4, 0xb0, 0x96, 0x7d, 0xa6, 0x29, 0x99, 0xde, 0xac, 0xe5, 0x45, 0x51, 0xd6,
+    0x5a, 0xa9, 0x69, 0xeb, 0x8b, 0x96, 0xf2, 0xa1, 0xad, 0xca, 0xfa, 0xf1, 0x19, 0x98, 0x94, 0x27,
+    0x8b, 0x70, 0x77, 0x6f, 0xb6, 0x90, 0xe2, 0x7e, 0xb7, 0xbe, 0xe7, 0xf7, 0xfc, 0xd0, 0x8b, 0xda,
+    0x64, 0x63, 0xc7, 0xde, 0xbe, 0xe7, 0x7d, 0xb6, 0x54, 0xb5, 0xb5, 0x74, 0x6a, 0xcb, 0x65, 0x87,
+    0x83, 0x67, 0x47, 0xe7, 0xfb, 0x5b, 0xe4, 0x48, 0x21, 0x4f, 0xe2, 0xa0, 0x57, 0x04, 0xdd, 0xb3,
+    0xe3, 0xa3, 0x97, 0xc3, 0x52, 0xd0, 0xc5, 0x34, 0xa1, 0xcb, 0x3c, 0xf3, 0xdd, 0x40, 0x91, 0xc0,
+    0xa0, 0x7a, 0x35, 0xaa, 0xea, 0x7b, 0x5b, 0x8d, 0x2b, 0x48, 0x3b, 0x0b, 0xe6, 0xdc, 0x14, 0x0d,
+    0xa2, 0xb2, 0x2b, 0x2b, 0xa3, 0x7f, 0xb1, 0x64, 0xae, 0x4f, 0x49, 0x47, 0xe9, 0x6d, 0x1c, 0x61,
+    0x49, 0x62, 0x55, 0xac, 0x51, 0x2d, 0x87, 0x9a, 0xea, 0x1c, 0x28, 0x64, 0x54, 0xf2, 0x6a, 0x32,
+    0x57, 0xca, 0xd5, 0x30, 0xe2, 0x95, 0x71, 0xe2, 0xd3, 0xe9, 0x9e, 0xec, 0x70, 0x9d, 0xee, 0x89,
+    0xf6, 0xdb, 0x29, 0x76, 0xa9, 0x64, 0xf3, 0xcb, 0xf5, 0xd7, 0xc4, 0x09, 0x68, 0x9a, 0x4e, 0x8c,
+    0xa2, 0x41, 0x63, 0x6c, 0x9a, 0x61, 0xa7, 0xa2, 0x95, 0x31, 0x2d, 0x2d, 0x7d, 0xba, 0x18, 0x10,
+    0xdf, 0x9d, 0x18, 0x71, 0x12, 0xfd, 0x16, 0x22, 0xf5, 0x2d, 0x5d, 0x32, 0x63, 0xfa, 0x8f, 0xbf,
+    0xfd, 0xe7, 0x7f, 0x91, 0x5a, 0x9f, 0x6d, 0x31, 0xa8, 0x4c, 0x8d, 0xf3, 0xd5, 0xf2, 0x9e, 0x81,
+    0xc1, 0x49, 0xc1, 0x6e, 0x94, 0x42, 0x76, 0x66, 0x4c, 0xd7, 0x03, 0xbb, 0x7f, 0xba, 0x17, 0x2b,
+    0x1c, 0xec, 0xe5, 0x2c, 0x6c, 0x1e, 0x55, 0x98, 0x86, 0x30, 0x33, 0x2a, 0xcb, 0x28, 0x23, 0x0a,
+    0x0f, 0xaa, 0x8c, 0x91, 0xbd, 0x3f, 0x74, 0x2a, 0x60, 0xfe, 0x3f, 0x7e, 0x20, 0x2f, 0xa2, 0x30,
+    0x04, 0x71, 0x98, 0x8b, 0x0a, 0xe3, 0x8f, 0xc9, 0xf7, 0xc5, 0x88, 0x57, 0x97, 0xa3, 0xcd, 0xe3,
+    0x53, 0xa8, 0x71, 0x42, 0xce, 0xb7, 0x1f, 0x3f, 0x77, 0xdd, 0x04, 0x32, 0x1f, 0x63, 0x3a, 0x78,
+    0x36, 0xb4, 0x07, 0x47, 0x27, 0xf6, 0x81, 0x3d, 0x80, 0x91, 0x30, 0xa0, 0xc2, 0xd2, 0x1e, 0xf0,
+    0xa4, 0x08, 0xc1, 0x9f, 0x3d, 0xed, 0xf5, 0xc8, 0x15, 0x0b, 0x21, 0x71, 0x25, 0xbf, 0x46, 0x4f,
+    0x48, 0x49, 0xaf, 0xd7, 0x2c, 0x89, 0x2c, 0xde, 0x85, 0xc6, 0x52, 0x3e, 0xed, 0x4a, 0x3e, 0xd2,
+    0x88, 0xb6, 0x18, 0xa2, 0x58, 0xff, 0x96, 0xd3, 0x7f, 0x49, 0x33, 0x0a, 0xba, 0x1c, 0x6a, 0x46,
+    0x2a, 0x4b, 0x94, 0xfc, 0x51, 0x5d, 0x48, 0xb0, 0xa7, 0x59, 0xa7, 0x90, 0xe3, 0x32, 0x8a, 0x57,
+    0xe8, 0xb5, 0x2e, 0x71, 0xef, 0x42, 0xba, 0xf4, 0x1d, 0x48, 0xb4, 0xef, 0x6a, 0xf2, 0x28, 0xaa,
+    0xd8, 0x49, 0x3b, 0x17, 0xab, 0x0c, 0xf0, 0x1f, 0x6d, 0x23, 0xca, 0xa4, 0x0e, 0x60, 0x3d, 0xc9,
+    0xbb, 0x18, 0xb0, 0x77, 0xe3, 0x2e, 0x80, 0x03, 0x9c, 0x05, 0x05, 0xeb, 0x05, 0x96, 0x5e, 0x81,
+    0x28, 0x87, 0x18, 0x28, 0x15, 0xa6, 0x93, 0xe4, 0x11, 0x52, 0x34, 0xb2, 0xfb, 0x26, 0x72, 0x19,
+    0x68, 0x3c, 0x90, 0x0c, 0xee, 0x62, 0x4d, 0xbd, 0xe9, 0xfe, 0xfe, 0x97, 0x3f, 0xff, 0xcf, 0x7f,
+    0xff, 0x81, 0x5c, 0x80, 0x88, 0x94, 0x93, 0x42, 0xca, 0x0d, 0xf6, 0x13, 0x1b, 0x26, 0x17, 0x72,
+    0x09, 0xa3, 0xc4, 0xf2, 0x06, 0x89, 0x42, 0x54, 0xca, 0x1c, 0xf2, 0x04, 0xf1, 0x1b, 0x29, 0x74,
+    0xac, 0x26, 0x13, 0x46, 0x31, 0x5f, 0x86, 0x3b, 0xc0, 0xc4, 0xc0, 0x8e, 0x8a, 0x31, 0x7d, 0x0e,
+    0x3f, 0x97, 0xb0, 0xbc, 0x73, 0xba, 0x27, 0x5e, 0xef, 0x34, 0x77, 0x49, 0xc3, 0x15, 0x0d, 0x8c,
+    0xe9, 0x1b, 0xfe, 0xfb, 0x51, 0x53, 0xd3, 0x80, 0xb1, 0xd8, 0x98, 0x5e, 0xe1, 0xaf, 0xe6, 0x89,
+    0x10, 0x5e, 0x5c, 0x44, 0xcd, 0x9b, 0x98, 0x70, 0xac, 0x43, 0x26, 0x38, 0x40, 0x8b, 0x1d, 0x93,
+    0xa3, 0x73, 0x2b, 0xfa, 0x37, 0x68, 0xe5, 0xc5, 0x2a, 0x49, 0x78, 0x37, 0x4c, 0xc2, 0x00, 0xd7,
+    0xb1, 0x23, 0x1e, 0xa2, 0x3a, 0x8d, 0x29, 0x2a, 0xaa, 0x00, 0x06, 0x0d, 0xa7, 0xf1, 0xce, 0x28,
+    0x90, 0x65, 0xb0, 0xed, 0x82, 0x83, 0xa7, 0x8b, 0xe8, 0x16, 0xc0, 0xc5, 0x23, 0xd9, 0x82, 0x11,
+    0xcf, 0x4f, 0x96, 0x90, 0xb3, 0x33, 0xb2, 0xa0, 0x29, 0xa1, 0x84, 0x6f, 0x42, 0x0c, 0x33, 0x96,
+    0x8c, 0xce, 0x02, 0x66, 0xed, 0x0e, 0x17, 0x7c, 0x66, 0x8e, 0x16, 0xb9, 0x92, 0x8a, 0x0d, 0x92,
+    0x67, 0x50, 0x8d, 0x20, 0xf2, 0xef, 0x7f, 0x45, 0x57, 0xcc, 0x39, 0x6c, 0x01, 0x91, 0x62, 0xa1,
+    0x73, 0x9f, 0x05, 0xee, 0x3f, 0x0f, 0x2d, 0x74, 0x9b, 0x00, 0xa2, 0x43, 0xd3, 0x82, 0x72, 0xaf,
+    0x94, 0xa3, 0x95, 0xc2, 0x9a, 0x07, 0x49, 0xe0, 0x3b, 0x37, 0xa0, 0x2d, 0xba, 0x66, 0x97, 0xc8,
+    0x7b, 0x8a, 0x31, 0x72, 0x05, 0xdf, 0x14, 0x89, 0x05, 0x81, 0x4f, 0x43, 0x32, 0x71, 0xc6, 0x43,
+    0x9e, 0x0b, 0xfc, 0xf9, 0x04, 0x68, 0x80, 0x9d, 0xf6, 0xf7, 0x92, 0xda, 0x76, 0x40, 0xff, 0x1c,
+    0xaa, 0x49, 0x98, 0x07, 0x5b, 0xdc, 0x02, 0x77, 0x10, 0xd4, 0xcd, 0xaf, 0xc4, 0x57, 0xb9, 0xa3,
+    0x34, 0xa9, 0xa6, 0x81, 0xba, 0x2c, 0x40, 0x15, 0xea, 0x33, 0x3c, 0x03, 0x7b, 0x7d, 0xf6, 0x12,
+    0x49, 0xff, 0xe3, 0x6f, 0x7f, 0xfc, 0x41, 0x1c, 0x8a, 0x11, 0x78, 0xf2, 0x68, 0xe2, 0x45, 0xad,
+    0x5d, 0x62, 0x3e, 0x65, 0x99, 0xd0, 0x96, 0x60, 0x1e, 0xbe, 0x8a, 0x3c, 0xe5, 0xc7, 0x98, 0xb5,
+    0xc9, 0xca, 0xa7, 0xa2, 0x90, 0xa8, 0xcc, 0x29, 0xd2, 0x04, 0xf1, 0xf6, 0x1a, 0x4b, 0xb8, 0xfa,
+    0x59, 0x24, 0xcf, 0x15, 0x20, 0xd5, 0x78, 0x07, 0x70, 0xb7, 0x64, 0x23, 0x65, 0xda, 0x8a, 0x3f,
+    0x31, 0xa6, 0x7d, 0x39, 0x28, 0x55, 0xd6, 0x57, 0x17, 0x54, 0xb9, 0x39, 0x4d, 0x9d, 0xc4, 0x8f,
+    0x15, 0x6c, 0xdc, 0xdb, 0x23, 0x57, 0x19, 0x82, 0x38, 0xc1, 0x63, 0x55, 0x17, 0x8c, 0x46, 0x3a,
+    0x72, 0xb7, 0x24, 0x3c, 0x53, 0x86, 0x22, 0x0b, 0x7b, 0x9e, 0xf0, 0xcb, 0x0b, 0xe8, 0x3c, 0xb5,
+    0x00, 0x18, 0x97, 0x90, 0x89, 0x78, 0x49, 0xb4, 0x54, 0x89, 0xec, 0xd1, 0xd8, 0xdf, 0xe3, 0x27,
+    0xb3, 0xa0, 0x5b, 0x46, 0x68, 0xe8, 0x12, 0x3f, 0x25, 0x0e, 0x85, 0x94, 0xd8, 0x1d, 0xc3, 0x33,
+    0x08, 0x5f, 0x44, 0x2c, 0x98, 0x1c, 0x53, 0xd8, 0x8d, 0xd6, 0x22, 0x9f, 0x01, 0xec, 0x52, 0x89,
+    0x48, 0x57, 0x62, 0xae, 0xad, 0x3e, 0x7d, 0xed, 0x43, 0xb4, 0xad, 0x62, 0xe0, 0x8d, 0x41, 0xb2,
+    0x7b, 0xc5, 0x12, 0x48, 0x07, 0x7b, 0x57, 0x78, 0x38, 0x74, 0xb6, 0x86, 0x9f, 0x82, 0x17, 0xc1,
+    0x00, 0xe3, 0x0f, 0x80, 0x55, 0xc0, 0x0b, 0xec, 0x81, 0x60, 0x3d, 0xa3, 0x92, 0xca, 0x22, 0x12,
+    0x47, 0xe2, 0x15, 0x1f, 0x2f, 0xd9, 0x90, 0x70, 0x0a, 0x38, 0xcd, 0xe8, 0x12, 0xf9, 0x76, 0x01,
+    0x64, 0xbb, 0x04, 0xa8, 0x25, 0x77, 0xc4, 0x48, 0x7c, 0x83, 0x2c, 0x53, 0x95, 0xcc, 0x66, 0x41,
+    0x2e, 0x71, 0xa7, 0x30, 0x17, 0x24, 0x22, 0x9e, 0x3f, 0x1f, 0x8d, 0xa4, 0x20, 0xaf, 0xb0, 0xc2,
+    0x83, 0x35, 0xac, 0x27, 0x4a, 0x17, 0x9c, 0x73, 0x90, 0xbf, 0x21, 0x13, 0x28, 0x84, 0xd4, 0x36,
+    0x04, 0xb8, 0x68, 0x0a, 0x09, 0xcd, 0xb7, 0xcf, 0xdf, 0xbe, 0x3d, 0x7b, 0xfd, 0xaf, 0xbf, 0x7e,
+    0x75, 0xf5, 0xea, 0x9b, 0xd7, 0x67, 0x30, 0x6a, 0x30, 0xe6, 0x2b, 0xbf, 0x90, 0xa6, 0xe1, 0xb6,
+    0xe8, 0x42, 0xaa, 0xc3, 0x36, 0xbe, 0x22, 0xdf, 0xa5, 0xf6, 0xa2, 0x81, 0xda, 0xc5, 0xbb, 0xeb,
+    0xcb, 0x77, 0xd7, 0xb8, 0xe4, 0xb8, 0xc4, 0x10, 0x17, 0x62, 0x42, 0xc2, 0x55, 0x10, 0xd4, 0x5f,
+    0xbc, 0x8e, 0x28, 0x56, 0x7c, 0xf0, 0x1e, 0x94, 0xaa, 0x76, 0x42, 0x70, 0x80, 0xd4, 0xdf, 0x04,
+    0x0a, 0x8d, 0xf5, 0x88, 0xbc, 0xff, 0x40, 0x1e, 0xca, 0xef, 0xa5, 0x46, 0x75, 0xb4, 0x51, 0x0b,
+    0xd7, 0xe0, 0xbf, 0x89, 0xfe, 0x2d, 0xc7, 0x5a, 0x78, 0xf5, 0xfe, 0xc3, 0x78, 0x13, 0x47, 0x01,
+    0xf0, 0xf2, 0x86, 0x21, 0xce, 0x94, 0x14, 0x86, 0x79, 0xf9, 0x15, 0x5f, 0x49, 0x7d, 0x51, 0xc2,
+    0xa5, 0x71, 0x89, 0x46, 0x8e, 0xe4, 0x0a, 0x69, 0x6f, 0x15, 0x8a, 0xa4, 0x6c, 0xb3, 0x46, 0xa5,
+    0x1a, 0x03, 0x27, 0xe9, 0x28, 0x0a, 0xb1, 0x60, 0x81, 0x6c, 0x95, 0x84, 0x95, 0x22, 0xb7, 0xa4,
+    0xb1, 0x2c, 0x59, 0x55, 0x5a, 0x0f, 0x1e, 0xcb, 0x9c, 0x45, 0xc7, 0x2c, 0x7c, 0xc7, 0xb4, 0x6a,
+    0xf0, 0x62, 0x83, 0x2b, 0x86, 0x1d, 0x60, 0x3d, 0x06, 0xe3, 0x31, 0x32, 0x99, 0x92, 0xfc, 0xb3,
+    0xfd, 0xdb, 0x34, 0x0a, 0x3b, 0x56, 0xd3, 0x14, 0x1e, 0xbc, 0x30, 0xfc, 0x5e, 0x0b, 0x88, 0xd2,
+    0xc8, 0x38, 0x68, 0xac, 0x1d, 0x00, 0xc8, 0x77, 0xa9, 0x78, 0x26, 0x27, 0x67, 0x27, 0xbe, 0xa5,
+    0x1f, 0x0d, 0x39, 0x0e, 0x94, 0x5d, 0x1d, 0xcd, 0xdb, 0x07, 0x0d, 0x7f, 0x0e, 0x45, 0xb1, 0x59,
+    0x92, 0x40, 0xa9, 0x01, 0x1c, 0xa2, 0x5b, 0x46, 0x01, 0xb3, 0xf9, 0x83, 0x8e, 0x79, 0x86, 0xbf,
+    0x46, 0x26, 0x04, 0x1c, 0x7e, 0xd0, 0xc9, 0xe7, 0xf9, 0x21, 0x66, 0x00, 0x1d, 0x30, 0x0a, 0x0a,
+    0xa8, 0x75, 0x4c, 0x58, 0x58, 0xed, 0x11, 0xd4, 0x2d, 0x5b, 0xf1, 0x14, 0x8d, 0x79, 0x9f, 0xde,
+    0xfa, 0x21, 0x84, 0xbe, 0xcd, 0x71, 0xe5, 0x2a, 0x5a, 0x25, 0x0e, 0xb3, 0x34, 0xea, 0x4c, 0x33,
+    0x9a, 0x70, 0x5d, 0xc1, 0xf2, 0x3a, 0x0d, 0xe8, 0x1c, 0xa3, 0x5c, 0x9e, 0x6f, 0xe2, 0x82, 0xdd,
+    0x12, 0x65, 0x35, 0xe9, 0x19, 0x02, 0xc6, 0xcc, 0x0a, 0x69, 0x08, 0xff, 0xe7, 0x41, 0x90, 0xc7,
+    0x1c, 0x08, 0x04, 0x4e, 0x62, 0x49, 0xa1, 0xba, 0x08, 0x60, 0xa1, 0x82, 0xb3, 0x3c, 0xa7, 0x77,
+    0xe1, 0x01, 0x4b, 0x35, 0x2b, 0xdb, 0xd4, 0x75, 0xf9, 0xb2, 0xaf, 0x7d, 0xd8, 0xfa, 0xa0, 0xa8,
+    0xef, 0x98, 0x82, 0x2c, 0x1a, 0x01, 0x55, 0x0c, 0xce, 0x20, 0x6a, 0xba, 0xce, 0x2f, 0xaf, 0x2e,
+    0xde, 0x62, 0x7b, 0x23, 0x65, 0x1d, 0x66, 0xa3, 0x4f, 0x58, 0xd5, 0x43, 0xd3, 0x46, 0x92, 0x02,
+    0xb3, 0xeb, 0x24, 0x21, 0xe8, 0xe7, 0xec, 0x1d, 0x7f, 0xa9, 0x25, 0xaf, 0xa7, 0x1f, 0x85, 0x51,
+    0x0c, 0x22, 0x4e, 0xe0, 0x7b, 0x14, 0x4b, 0xed, 0x37, 0x0c, 0x94, 0x8e, 0x56, 0x32, 0x94, 0xc0,
+    0x4f, 0x45, 0xd7, 0xe4, 0x06, 0xca, 0x88, 0x14, 0x8c, 0x25, 0x55, 0x08, 0x63, 0x74, 0xee, 0x03,
+    0x93, 0x0c, 0xc7, 0x20, 0x8b, 0x08, 0x52, 0xd6, 0xba, 0x7e, 0xe5, 0x56, 0x09, 0xfb, 0xd2, 0x3d,
+    0x31, 0x4e, 0x7d, 0x77, 0x6a, 0x8c, 0x84, 0x81, 0xd4, 0x2e, 0x62, 0xee, 0x80, 0xaa, 0xdc, 0x42,
+    0x37, 0x56, 0xfd, 0x7c, 0x1d, 0xf0, 0x7a, 0x0d, 0xac, 0x0b, 0x73, 0xd8, 0x6b, 0xf2, 0xfd, 0xf7,
+    0x1c, 0x03, 0xcb, 0x5d, 0xc2, 0x04, 0x36, 0x69, 0x3e, 0xd4, 0x87, 0x6d, 0x36, 0x94, 0x9b, 0xa3,
+    0xed, 0xe0, 0xe0, 0xfb, 0x07, 0x8b, 0xac, 0xdf, 0xfb, 0xee, 0x07, 0x20, 0x92, 0x3f, 0xc7, 0xaf,
+    0x95, 0xcb, 0x02, 0x50, 0x22, 0x65, 0xac, 0x18, 0x50, 0x7e, 0x29, 0xfc, 0x97, 0x5c, 0xcc, 0xb0,
+    0x7f, 0x63, 0x43, 0xfe, 0xe4, 0xcf, 0xc3, 0x8e, 0x60, 0xa8, 0x2b, 0xa7, 0x74, 0x05, 0xe2, 0xaf,
+    0xb7, 0x06, 0x5d, 0x00, 0x9b, 0xb7, 0x10, 0x39, 0xad, 0x85, 0x9c, 0x5c, 0x47, 0x06, 0xc3, 0x57,
+    0x5f, 0xe5, 0x06, 0x84, 0x1f, 0xee, 0x1d, 0x66, 0x25, 0xe0, 0x37, 0x93, 0x89, 0x6a, 0x33, 0xfb,
+    0xe2, 0xf2, 0xec, 0x6d, 0xfb, 0x82, 0xe5, 0xe0, 0xd4, 0x05, 0x79, 0xb1, 0xf3, 0x58, 0xa5, 0x4d,
+    0x08, 0xfc, 0xb3, 0xc0, 0x3e, 0x65, 0xef, 0xe8, 0x96, 0xf6, 0xeb, 0x2d, 0xd2, 0x56, 0x31, 0xd4,
+    0xcf, 0xa7, 0xe9, 0xf8, 0xc8, 0x5f, 0xa2, 0xd5, 0x8a, 0xcf, 0x28, 0x70, 0x69, 0x41, 0x2d, 0x9a,
+    0x54, 0x52, 0x88, 0x7c, 0xf6, 0xb8, 0xb6, 0x88, 0x22, 0xab, 0x0e, 0xc7, 0x8a, 0x40, 0xd2, 0xc1,
+    0x58, 0x1b, 0xcc, 0x3d, 0x6c, 0xb1, 0x81, 0x42, 0x58, 0x23, 0x7a, 0x2b, 0x57, 0x4e, 0xc0, 0x68,
+    0x52, 0x68, 0x70, 0x33, 0xb4, 0xce, 0x60, 0x73, 0x0a, 0xb1, 0x9d, 0xc5, 0x52, 0x76, 0x50, 0x3d,
+    0xf4, 0x56, 0x36, 0x69, 0x09, 0x8b, 0x9f, 0x71, 0x9b, 0x2e, 0x70, 0xf0, 0x93, 0xf7, 0xc9, 0xad,
+    0xbe, 0x28, 0xf1, 0x96, 0xc3, 0x6a, 0x45, 0xc6, 0x22, 0x73, 0xab, 0x27, 0x04, 0x98, 0x72, 0xf3,
+    0xcc, 0x9f, 0x00, 0x17, 0xd8, 0x6f, 0x10, 0xd9, 0xa6, 0xb2, 0xa7, 0x70, 0x08, 0x14, 0x57, 0x2c,
+    0xb5, 0x29, 0x12, 0xc6, 0xb2, 0x04, 0xb0, 0xe5, 0x9a, 0x3c, 0x05, 0x97, 0xc6, 0xa7, 0xf0, 0xd9,
+    0xd2, 0xa6, 0x70, 0xfa, 0x7c, 0x42, 0x6f, 0x35, 0x31, 0x4a, 0x17, 0x4e, 0xb8, 0xc4, 0x26, 0x5a,
+    0x34, 0xb0, 0x9a, 0x63, 0x35, 0x91, 0xec, 0x14, 0xdf, 0x35, 0x10, 0xdb, 0x0c, 0xc4, 0x55, 0x55,
+    0x09, 0x70, 0x23, 0xa2, 0x0f, 0x5a, 0xd4, 0x35, 0x50, 0xfe, 0x88, 0x8e, 0x62, 0x79, 0xf7, 0x15,
+    0xe0, 0x29, 0x7a, 0xae, 0x2f, 0x45, 0x7b, 0x25, 0xaf, 0xb6, 0x52, 0x48, 0x72, 0x02, 0x70, 0xfa,
+    0x8e, 0x83, 0x96, 0x7f, 0xda, 0x71, 0x6c, 0xa1, 0xf5, 0xaf, 0x2a, 0xe9, 0xbb, 0x65, 0x75, 0xc9,
+    0xba, 0xa2, 0x3c, 0x41, 0x56, 0x34, 0x43, 0x53, 0x3d, 0xc1, 0x46, 0x72, 0x82, 0x5a, 0x93, 0x54,
+    0xa2, 0x2b, 0x81, 0xfd, 0x71, 0x8d, 0x7a, 0xe4, 0x5b, 0xa9, 0x4e, 0xf9, 0x8d, 0x6f, 0x41, 0x95,
+    0xcd, 0x26, 0x72, 0x56, 0x4b, 0xc0, 0x70, 0x7b, 0xce, 0xb2, 0xb3, 0x80, 0xe1, 0xc7, 0x6f, 0xee,
+    0x5e, 0xb9, 0x1d, 0x53, 0x39, 0x22, 0x30, 0x2d, 0x1b, 0x0f, 0xc7, 0x5e, 0xc8, 0x6b, 0x7f, 0x13,
+    0x49, 0xdc, 0xc6, 0x7b, 0xbe, 0x48, 0xd3, 0xac, 0x14, 0xc6, 0xe6, 0x8e, 0x4b, 0xc8, 0xa3, 0x83,
+    0x26, 0xf2, 0xf2, 0x35, 0x5f, 0x01, 0x0f, 0x17, 0x76, 0x25, 0x2b, 0x6a, 0xef, 0x1a, 0x55, 0xe9,
+    0x2c, 0x2b, 0xa4, 0xd7, 0xdf, 0x91, 0x94, 0xd2, 0x30, 0x6c, 0xa2, 0xc7, 0xb5, 0x6a, 0x62, 0x33,
+    0x71, 0x57, 0xfe, 0x36, 0x9d, 0x5e, 0xa0, 0x29, 0x12, 0x92, 0x76, 0x6a, 0xba, 0x68, 0xd3, 0x79,
+    0xab, 0xf0, 0xf3, 0x14, 0xbd, 0xa6, 0x12, 0x84, 0x58, 0xb6, 0xe1, 0x3d, 0x6e, 0x58, 0xc8, 0xac,
+    0xb0, 0x29, 0x27, 0xd9, 0x90, 0xb8, 0x9c, 0x51, 0x00, 0x38, 0x19, 0x2c, 0xda, 0x5a, 0x85, 0xc7,
+    0xb2, 0x1c, 0x51, 0xf3, 0x59, 0x59, 0x0f, 0x5b, 0xfa, 0x5d, 0x51, 0x09, 0xdc, 0x5c, 0xe2, 0xf7,
+    0x92, 0x50, 0x2d, 0x01, 0xe2, 0xb7, 0x59, 0x91, 0xdb, 0x9f, 0x4f, 0xc8, 0x77, 0xfa, 0x0e, 0x52,
+    0xed, 0xe0, 0x63, 0x16, 0x7d, 0x6c, 0x68, 0x94, 0xe9, 0xc7, 0xf3, 0xfe, 0x89, 0x31, 0xfd, 0xf2,
+    0x5e, 0x32, 0x21, 0x4e, 0x1e, 0x51, 0xf9, 0xe6, 0x43, 0x43, 0xdf, 0x52, 0x25, 0xd6, 0xfc, 0x76,
+    0xd3, 0x3e, 0x2a, 0xad, 0x27, 0x0f, 0xfc, 0x61, 0x41, 0xbc, 0x00, 0x10, 0x79, 0xb9, 0x1a, 0x00,
+    0x7f, 0x4d, 0xf1, 0xce, 0x24, 0x5f, 0x8b, 0x87, 0x76, 0x16, 0x9d, 0xfb, 0x1f, 0x99, 0xdb, 0x19,
+    0x58, 0x64, 0x44, 0xcc, 0x5e, 0x0f, 0x39, 0xaa, 0x1f, 0x4b, 0xed, 0xb0, 0x28, 0x36, 0x87, 0x14,
+    0x19, 0xf9, 0xfd, 0xb8, 0x5c, 0xc4, 0x76, 0x82, 0x2d, 0x2a, 0x68, 0x78, 0xf5, 0x5d, 0x65, 0x87,
+    0xaf, 0x02, 0x57, 0x63, 0x38, 0xa8, 0xa7, 0x54, 0x10, 0x10, 0x3e, 0xe0, 0x63, 0xf2, 0xed, 0xf5,
+    0x9b, 0xd7, 0xe0, 0x22, 0xe8, 0x04, 0xbb, 0x84, 0x41, 0x8e, 0xae, 0x12, 0xd6, 0x1f, 0x17, 0x00,
+    0x72, 0x52, 0x11, 0x00, 0xf2, 0x58, 0xaa, 0x25, 0x00, 0xc4, 0x88, 0x1f, 0x1d, 0x00, 0xa9, 0xc8,
+    0x9e, 0xc9, 0xd3, 0xa7, 0xeb, 0xf7, 0x92, 0xd4, 0x27, 0x86, 0x40, 0x73, 0xd7, 0xb9, 0xdc, 0x7d,
+    0xfe, 0xe3, 0x0f, 0xe4, 0xcb, 0x7b, 0xb9, 0xe4, 0xc6, 0xe1, 0xe5, 0x41, 0x9d, 0x49, 0x7e, 0x4e,
+    0x0a, 0x76, 0x1e, 0xf4, 0xfd, 0xe9, 0xc6, 0xd3, 0x9a, 0xd2, 0xf5, 0x5b, 0xa3, 0xdd, 0x51, 0xaf,
+    0xf8, 0xfd, 0x9a, 0x51, 0xd9, 0x61, 0xe5, 0x8d, 0x24, 0xf0, 0x55, 0xae, 0x9d, 0xaf, 0x89, 0x59,
+    0x5c, 0xe1, 0x31, 0x31, 0x0a, 0x36, 0x97, 0x72, 0xcc, 0x07, 0xee, 0xd2, 0xf9, 0xb0, 0x8b, 0xb7,
+    0xfc, 0xfd, 0xc5, 0xf9, 0xf9, 0x2e, 0x5e, 0x1d, 0xef, 0x86, 0x11, 0x5b, 0x7a, 0xef, 0x6d, 0x8d,
+    0x6c, 0x71, 0x9d, 0x4e, 0x3d, 0x9e, 0x60, 0x99, 0xd0, 0x70, 0xa7, 0xd0, 0x3d, 0xe8, 0xb7, 0xcb,
+    0x1b, 0x50, 0x96, 0x31, 0xbd, 0xe6, 0xe5, 0xdc, 0xdb, 0xf6, 0x8e, 0x79, 0xcb, 0x82, 0xe2, 0xce,
+    0xdc, 0x0e, 0xeb, 0xf1, 0x4e, 0x4c, 0xb1, 0xe0, 0xf9, 0xf9, 0xf6, 0x15, 0x7f, 0x42, 0x10, 0x28,
+    0x1f, 0xf1, 0xee, 0x0a, 0x03, 0x90, 0x0c, 0x5d, 0x84, 0x8c, 0xf0, 0x4b, 0x31, 0xbd, 0x2c, 0xf1,
+    0x63, 0x5e, 0x7e, 0xd3, 0xf0, 0x8e, 0xc8, 0x1b, 0xc8, 0x80, 0xb3, 0x32, 0xbc, 0x79, 0xda, 0x87,
+    0xa9, 0x31, 0xee, 0xbe, 0x23, 0x95, 0xc2, 0x7d, 0x3e, 0x44, 0xed, 0x13, 0xf4, 0xbf, 0x1f, 0x10,
+    0xd0, 0x19, 0x1f, 0x4c, 0x0c, 0xdb, 0xb6, 0x0d, 0xf2, 0x60, 0x93, 0xeb, 0x05, 0x76, 0xcf, 0xd3,
+    0x5b, 0xa0, 0xcc, 0x7b, 0x0e, 0xa5, 0xf6, 0x35, 0xbc, 0x83, 0x2a, 0x63, 0x15, 0x60, 0xb3, 0x82,
+    0xe4, 0x15, 0x79, 0x1a, 0x91, 0x30, 0xca, 0x0b, 0x1a, 0xec, 0x5e, 0x87, 0x8c, 0xb9, 0x6a, 0x0f,
+    0x5d, 0xed, 0x80, 0xa1, 0xcb, 0x75, 0x66, 0x58, 0x66, 0xb4, 0x55, 0x3d, 0x72, 0x20, 0x94, 0x1a,
+    0x75, 0x7c, 0x82, 0x64, 0x6f, 0x11, 0xb9, 0x10, 0x0e, 0x97, 0x17, 0x57, 0xd7, 0x66, 0xb7, 0x0e,
+    0x29, 0xfc, 0x42, 0x06, 0x97, 0xd4, 0x94, 0x99, 0x4c, 0xef, 0x1a, 0xf6, 0x23, 0x13, 0xa6, 0xe0,
+    0xdf, 0x37, 0xf9, 0x0e, 0x3f, 0xb2, 0xde, 0xc3, 0x2a, 0xc9, 0x04, 0x05, 0xd4, 0x08, 0xe0, 0xfd,
+    0x93, 0x11, 0xe1, 0x8d, 0xa1, 0x14, 0x14, 0x1e, 0xce, 0x7d, 0xef, 0x4e, 0xb2, 0xfc, 0x64, 0x5b,
+    0xa3, 0xb1, 0x56, 0x94, 0xe9, 0x9b, 0xa1, 0x1c, 0x63, 0x8b, 0x7a, 0x2d, 0xba, 0xb1, 0x40, 0xb5,
+    0x09, 0x14, 0x3a, 0xbc, 0x1d, 0x27, 0x8a, 0xad, 0x6f, 0xaf, 0xaf, 0x2f, 0x39, 0x5e, 0x15, 0xc3,
+    0x04, 0x3c, 0x34, 0xf6, 0x43, 0x79, 0x2f, 0xa3, 0x52, 0x03, 0xee, 0xd6, 0x1d, 0xfd, 0xa9, 0xcb,
+    0x42, 0x19, 0xba, 0xbe, 0xdb, 0x15, 0xfb, 0x84, 0xa6, 0x0b, 0xc5, 0xdd, 0xa4, 0xe4, 0xb5, 0xd8,
+    0x43, 0x1a, 0x91, 0x1c, 0x12, 0x07, 0x04, 0x6f, 0x11, 0x3f, 0x6c, 0xef, 0xb9, 0x2a, 0x77, 0x0b,
+    0x1a, 0x57, 0x11, 0x11, 0xf0, 0x98, 0x5c, 0x76, 0xdb, 0xb2, 0x9b, 0x53, 0xc3, 0x36, 0x27, 0x5f,
+    0xa5, 0xb0, 0x9f, 0xfc, 0x74, 0x1d, 0x78, 0x08, 0xe0, 0x97, 0xe0, 0xf2, 0x99, 0xa8, 0xa9, 0x69,
+    0xc0, 0x92, 0x8c, 0xf4, 0xf0, 0x24, 0x53, 0xb0, 0x8b, 0x91, 0xbb, 0xf6, 0x53, 0x7f, 0x16, 0x30,
+    0xc2, 0xc2, 0x68, 0x35, 0x5f, 0x68, 0xa9, 0xe4, 0xc6, 0x0f, 0xa2, 0x79, 0xc7, 0x2c, 0x26, 0xa3,
+    0xf9, 0x79, 0xc3, 0x7e, 0x09, 0x1b, 0x03, 0x9d, 0xb3, 0x06, 0x2f, 0xe5, 0x7e, 0x5f, 0x6a, 0xc9,
+    0x59, 0x4d, 0xe7, 0x24, 0x2a, 0xbe, 0xea, 0x61, 0xf1, 0xcc, 0xf5, 0xf9, 0x3d, 0x03, 0x74, 0x29,
+    0x71, 0x3b, 0x61, 0x73, 0x2e, 0x26, 0xce, 0x6f, 0xc6, 0x84, 0x92, 0x83, 0xfe, 0x01, 0x40, 0x06,
+    0x20, 0x5a, 0xe9, 0xc6, 0x82, 0x4a, 0x07, 0x2f, 0x2f, 0xe0, 0x15, 0x83, 0x02, 0x3e, 0xf3, 0x0b,
+    0x3c, 0xe0, 0x6c, 0x77, 0xa9, 0xfc, 0x43, 0x3a, 0xfd, 0x41, 0x4d, 0x7e, 0x90, 0xd3, 0x62, 0x65,
+    0xc1, 0xc9, 0xe3, 0xac, 0x1c, 0xdd, 0x80, 0x8b, 0x57, 0x6c, 0x4e, 0x46, 0xfc, 0x6f, 0xd1, 0x90,
+    0x98, 0x38, 0xe9, 0x6a, 0xa6, 0x88, 0x3d, 0x0a, 0xc1, 0xd9, 0x3f, 0x39, 0x96, 0xd5, 0xa5, 0xb4,
+    0x5d, 0x9e, 0xe2, 0x18, 0x8d, 0xfb, 0x86, 0xfc, 0xa6, 0x69, 0x77, 0xb4, 0xa4, 0xae, 0x62, 0x52,
+    0x91, 0xb9, 0xf2, 0xaf, 0x7a, 0x1f, 0x2f, 0x3a, 0xd2, 0x40, 0x44, 0xdc, 0x87, 0x44, 0xf8, 0xe4,
+    0x9f, 0xec, 0x1b, 0x76, 0x37, 0xd6, 0x66, 0xba, 0xe2, 0x35, 0xd6, 0x2b, 0xa2, 0x4e, 0x99, 0x45,
+    0xb0, 0xed, 0x58, 0x0d, 0x11, 0xd4, 0x9e, 0xad, 0xf2, 0x9c, 0x41, 0xa4, 0x9c, 0x32, 0x77, 0x51,
+    0x6e, 0x65, 0x6e, 0xcb, 0xb2, 0xf8, 0x45, 0x62, 0x22, 0x2e, 0x4e, 0xf3, 0x09, 0x58, 0xec, 0xf1,
+    0x63, 0xf6, 0x2f, 0xef, 0x21, 0xb5, 0x31, 0x20, 0x6b, 0x14, 0xac, 0x0a, 0x00, 0x82, 0xa4, 0x90,
+    0x8f, 0x62, 0x2e, 0xcf, 0x0c, 0xcd, 0x87, 0x76, 0xf2, 0xf9, 0x64, 0xce, 0xdd, 0x43, 0x4b, 0x32,
+    0xc4, 0x07, 0xe8, 0x69, 0x7d, 0xa7, 0x89, 0x4d, 0xc2, 0x20, 0xdf, 0xfa, 0xac, 0xca, 0x12, 0x35,
+    0x2b, 0xe6, 0x38, 0xb9, 0xe4, 0xd3, 0x32, 0xf3, 0xa4, 0x93, 0x7f, 0x5f, 0xfa, 0xe1, 0x03, 0x9e,
+    0xa8, 0x17, 0xdf, 0xe9, 0xc7, 0x07, 0xab, 0x55, 0x84, 0x9a, 0xa6, 0x65, 0xc5, 0xaa, 0xea, 0x59,
+    0xde, 0xf5, 0x2a, 0xa9, 0xfb, 0xc1, 0x68, 0xd5, 0xae, 0xf8, 0x93, 0xa4, 0xcd, 0x1c, 0x64, 0xcc,
+    0xc0, 0xbf, 0x1c, 0x56, 0x1e, 0x01, 0x6f, 0x78, 0xb1, 0x89, 0xc5, 0x9b, 0x67, 0x1b, 0xa7, 0xf3,
+    0xc3, 0xcc, 0x94, 0x9b, 0x9a, 0x09, 0x99, 0x1d, 0x66, 0xff, 0x3b, 0x9b, 0xe0, 0x49, 0x13, 0x58,
+    0xb6, 0x77, 0xbe, 0x36, 0xf7, 0xa0, 0x5a, 0x13, 0xd1, 0xed, 0x44, 0x64, 0x3e, 0x0b, 0x54, 0x78,
+    0xb5, 0x64, 0xe7, 0xb7, 0x85, 0x27, 0x79, 0xe4, 0x06, 0x2c, 0x9c, 0x67, 0x0b, 0xf4, 0x58, 0xee,
+    0xaa, 0x88, 0xb4, 0x66, 0x73, 0xa6, 0x5b, 0x39, 0xdf, 0xf2, 0x38, 0x8b, 0x78, 0x4f, 0x03, 0x9b,
+    0x38, 0xd9, 0x58, 0xe9, 0xfc, 0x12, 0x1e, 0x00, 0x1c, 0xd6, 0x97, 0xf8, 0x67, 0x53, 0x2a, 0x1d,
+    0x44, 0xf2, 0x84, 0x61, 0x6f, 0x4f, 0xc0, 0xfe, 0x2d, 0xa4, 0xb2, 0x7c, 0x9f, 0xc0, 0x98, 0x47,
+    0xa8, 0x87, 0xbd, 0x0e, 0x72, 0x0b, 0xcc, 0x9d, 0x13, 0x5c, 0x48, 0x93, 0xa6, 0x28, 0x17, 0xae,
+    0xb4, 0x87, 0x64, 0x0c, 0x76, 0x1f, 0x7e, 0xf3, 0xe0, 0xe1, 0x13, 0xf1, 0x8a, 0xbb, 0xe3, 0x64,
+    0x8b, 0x96, 0xcb, 0x50, 0x66, 0x6d, 0xeb, 0x3b, 0x69, 0x51, 0x0d, 0x4c, 0xc0, 0x17, 0xb3, 0x25,
+    0x72, 0x80, 0x35, 0xde, 0x72, 0xff, 0xef, 0x88, 0xc7, 0x7c, 0xb2, 0xa5, 0x87, 0x49, 0x41, 0x18,
+    0x3b, 0xe9, 0x4a, 0x58, 0x58, 0x42, 0x09, 0xef, 0x0b, 0xbe, 0x3e, 0xe4, 0x4d, 0xbe, 0x71, 0xab,
+    0x57, 0xf2, 0x2c, 0x40, 0x9e, 0xee, 0xc1, 0xac, 0xb4, 0xc3, 0xc9, 0x58, 0xd2, 0x53, 0x1a, 0x7a,
+    0xe8, 0x9a, 0x3d, 0xf5, 0xff, 0x4e, 0x75, 0x20, 0x04, 0xf8, 0x7f, 0x5c, 0x1d, 0x3c, 0x2e, 0xa9,
+    0xe0, 0xb9, 0x65, 0xc7, 0x2c, 0x6e, 0x8d, 0x86, 0x51, 0xc6, 0x03, 0x0a, 0xed, 0x02, 0x3c, 0xf3,
+    0x71, 0x45, 0xa6, 0xb8, 0x35, 0xc7, 0x50, 0x6e, 0xc8, 0x69, 0xce, 0x5d, 0x1c, 0xbc, 0xf2, 0x94,
+    0x2c, 0x3b, 0xa6, 0xb8, 0x3b, 0xc7, 0xf3, 0x37, 0x3e, 0xfa, 0x6b, 0xd3, 0xd2, 0xed, 0xe3, 0xaa,
+    0x1f, 0x71, 0xda, 0x9a, 0xd4, 0xec, 0x47, 0x26, 0xe1, 0xbb, 0x26, 0xe2, 0xf8, 0x2f, 0x57, 0x91,
+    0x38, 0xb4, 0xe0, 0x8c, 0xa0, 0xae, 0xa0, 0x0a, 0x37, 0x1b, 0x6c, 0x28, 0xef, 0xc8, 0xe0, 0x81,
+    0x23, 0x40, 0x97, 0xbc, 0x8a, 0x12, 0x44, 0xc2, 0x5f, 0xed, 0x84, 0x61, 0x3e, 0xda, 0xb1, 0xba,
+    0x64, 0xbf, 0xdf, 0xef, 0x37, 0x90, 0x78, 0x68, 0x39, 0x45, 0x95, 0x57, 0x97, 0xe5, 0xf5, 0xbc,
+    0xd3, 0x3d, 0xf1, 0x57, 0x18, 0xa7, 0x7b, 0xe2, 0x7f, 0x8d, 0xf2, 0xbf, 0xd0, 0xd2, 0x3d, 0x38,
+    0x32, 0x45, 0x00, 0x00,
+};
+
+#endif // DASHBOARD_PAGE_H
@@ -0,0 +1,306 @@
+/*
+ * DashboardParams.cpp
+ *
+ * Parameter table: NVS restore, change tracking, coalesced writes and
+ * the /api/params edits.
+ */
+
+#include "DashboardParams.h"
+#include <math.h>
+
+static const char* const TYPE_NAMES[] = { "float", "int", "bool", "text" };
+
+ParamTableBase::ParamTableBase(DashboardParam* params, uint32_t* saved, ParamValue* pending,
+                               uint8_t capacity) {
+    _params = params;
+    _saved = saved;
+    _pending = pending;
+    _capacity = capacity;
+    _count = 0;
+    _open = false;
+    _dirty = 0;
+    _dirtySince = 0;
+    _writes = 0;
+    _pendingMask = 0;
+    portMUX_TYPE unlocked = portMUX_INITIALIZER_UNLOCKED;
+    _lock = unlocked;
+    _callback = nullptr;
+}
+
+uint8_t ParamTableBase::add(const char* key, const char* label, void* target, ParamType type,
+                            uint8_t flags, uint8_t size, float min, float max) {
+    if (_count >= _capacity || !key || !target || find(key) != PARAM_INVALID) {
+        return PARAM_INVALID;
+    }
+
+    DashboardParam& param = _params[_count];
+    param.key = key;
+    param.label = label ? label : key;
+    param.target = target;
+    param.type = type;
+    param.flags = flags;
+    param.size = size;
+    param.min = min;
+    param.max = max;
+    _saved[_count] = fingerprint(_count);   // Defaults are not a change
+    return _count++;
+}
+
+uint8_t ParamTableBase::addFloat(const char* key, float* value, float min, float max,
+                                 const char* label, uint8_t flags) {
+    return add(key, label, value, PARAM_FLOAT, flags, sizeof(float), min, max);
+}
+
+uint8_t ParamTableBase::addInt(const char* key, int32_t* value, int32_t min, int32_t max,
+                               const char* label, uint8_t flags) {
+    return add(key, label, value, PARAM_INT, flags, sizeof(int32_t), min, max);
+}
+
+uint8_t ParamTableBase::addBool(const char* key, bool* value, uint8_t flags, const char* label) {
+    return add(key, label, value, PARAM_BOOL, flags, sizeof(bool), 0, 1);
+}
+
+uint8_t ParamTableBase::addText(const char* key, char* buffer, uint8_t size) {
+    return add(key, nullptr, buffer, PARAM_TEXT, PARAM_PERSIST, size, 0, 0);
+}
+
+uint8_t ParamTableBase::find(const char* key) const {
+    for (uint8_t id = 0; id < _count; id++) {
+        if (strcmp(_params[id].key, key) == 0) return id;
+    }
+    return PARAM_INVALID;
+}
+
+// Compared with _saved to find changes: the raw bits, or FNV-1a of text
+uint32_t ParamTableBase::fingerprint(uint8_t id) const {
+    const DashboardParam& param = _params[id];
+    uint32_t bits = 0;
+    switch (param.type) {
+        case PARAM_FLOAT:
+        case PARAM_INT:
+            memcpy(&bits, param.target, sizeof(bits));
+            break;
+        case PARAM_BOOL:
+            bits = *(const bool*)param.target ? 1 : 0;
+            break;
+        case PARAM_TEXT: {
+            const char* text = (const char*)param.target;
+            bits = 2166136261UL;
+            for (uint8_t i = 0; i < param.size && text[i]; i++) {
+                bits = (bits ^ (uint8_t)text[i]) * 16777619UL;
+            }
+            break;
+        }
+    }
+    return bits;
+}
+
+// ==================== NVS ====================
+
+bool ParamTableBase::begin(const char* ns) {
+    _open = _preferences.begin(ns, false);
+    if (!_open) {
+        Serial.printf("Params: cannot open NVS namespace \"%s\"\n", ns);
+        return false;
+    }
+
+    for (uint8_t id = 0; id < _count; id++) {
+        restore(id);
+        _saved[id] = fingerprint(id);
+    }
+    _dirty = 0;
+    return true;
+}
+
+// Saved values outside the current limits (e.g. after a firmware update
+// narrowed them) are ignored and the default stays
+void ParamTableBase::restore(uint8_t id) {
+    const DashboardParam& param = _params[id];
+    if (!_preferences.isKey(param.key)) {
+        return;
+    }
+
+    switch (param.type) {
+        case PARAM_FLOAT: {
+            float value = _preferences.getFloat(param.key, NAN);
+            if (!isnan(value) && value >= param.min && value <= param.max) {
+                *(float*)param.target = value;
+            }
+            break;
+        }
+        case PARAM_INT: {
+            int32_t value = _preferences.getInt(param.key, *(int32_t*)param.target);
+            if (value >= param.min && value <= param.max) {
+                *(int32_t*)param.target = value;
+            }
+            break;
+        }
+        case PARAM_BOOL:
+            *(bool*)param.target = _preferences.getBool(param.key, *(bool*)param.target);
+            break;
+        case PARAM_TEXT:
+            _preferences.getString(param.key, (char*)param.target, param.size);
+            break;
+    }
+}
+
+void ParamTableBase::write(uint8_t id) {
+    const DashboardParam& param = _params[id];
+    switch (param.type) {
+        case PARAM_FLOAT:
+            _preferences.putFloat(param.key, *(const float*)param.target);
+            break;
+        case PARAM_INT:
+            _preferences.putInt(param.key, *(const int32_t*)param.target);
+            break;
+        case PARAM_BOOL:
+            _preferences.putBool(param.key, *(const bool*)param.target);
+            break;
+        case PARAM_TEXT:
+            _preferences.putString(param.key, (const char*)param.target);
+            break;
+    }
+    _writes++;
+}
+
+void ParamTableBase::flush() {
+    if (!_open || !_dirty) {
+        return;
+    }
+    for (uint8_t id = 0; id < _count; id++) {
+        if (_dirty & (1UL << id)) {
+            write(id);
+            _saved[id] = fingerprint(id);
+        }
+    }
+    _dirty = 0;
+}
+
+void ParamTableBase::service(uint32_t now) {
+    // Edits from /api/params
+    ParamValue edits[WEBDASHBOARD_MAX_PARAMS];
+    portENTER_CRITICAL(&_lock);
+    uint32_t pending = _pendingMask;
+    _pendingMask = 0;
+    if (pending) {
+        memcpy(edits, _pending, _count * sizeof(ParamValue));
+    }
+    portEXIT_CRITICAL(&_lock);
+
+    for (uint8_t id = 0; pending && id < _count; id++) {
+        if (!(pending & (1UL << id))) continue;
+        const DashboardParam& param = _params[id];
+        switch (param.type) {
+            case PARAM_FLOAT: *(float*)param.target = edits[id].f; break;
+            case PARAM_INT:   *(int32_t*)param.target = edits[id].i; break;
+            case PARAM_BOOL:  *(bool*)param.target = edits[id].b; break;
+            case PARAM_TEXT:  break;
+        }
+        if (_callback) _callback(id);
+    }
+
+    // Dirty = differs from NVS; a value changed back drops out again
+    uint32_t dirty = 0;
+    for (uint8_t id = 0; id < _count; id++) {
+        if (fingerprint(id) != _saved[id]) dirty |= 1UL << id;
+    }
+    if (dirty && !_dirty) {
+        _dirtySince = now;
+    }
+    _dirty = dirty;
+
+    if (_dirty && now - _dirtySince >= DASHBOARD_PARAMS_FLUSH) {
+        flush();
+    }
+}
+
+// ==================== /api/params ====================
+
+bool ParamTableBase::parse(const DashboardParam& param, JsonVariantConst value,
+                           ParamValue& out) const {
+    switch (param.type) {
+        case PARAM_FLOAT: {
+            if (!value.is<float>()) return false;
+            out.f = value.as<float>();
+            return !isnan(out.f) && out.f >= param.min && out.f <= param.max;
+        }
+        case PARAM_INT: {
+            if (!value.is<long>()) return false;
+            long number = value.as<long>();
+            out.i = (int32_t)number;
+            return number >= param.min && number <= param.max;
+        }
+        case PARAM_BOOL:
+            if (value.is<bool>()) {
+                out.b = value.as<bool>();
+                return true;
+            }
+            if (value.is<long>() && (value.as<long>() == 0 || value.as<long>() == 1)) {
+                out.b = value.as<long>() == 1;
+                return true;
+            }
+            return false;
+        default:
+            return false;
+    }
+}
+
+bool ParamTableBase::stage(JsonObjectConst edits) {
+    ParamValue values[WEBDASHBOARD_MAX_PARAMS];
+    uint32_t mask = 0;
+
+    for (JsonPairConst entry : edits) {
+        uint8_t id = find(entry.key().c_str());
+        if (id == PARAM_INVALID || !(_params[id].flags & PARAM_EDITABLE)
+            || !parse(_params[id], entry.value(), values[id])) {
+            return false;
+        }
+        mask |= 1UL << id;
+    }
+    if (!mask) {
+        return false;
+    }
+
+    portENTER_CRITICAL(&_lock);
+    for (uint8_t id = 0; id < _count; id++) {
+        if (mask & (1UL << id)) _pending[id] = values[id];
+    }
+    _pendingMask |= mask;
+    portEXIT_CRITICAL(&_lock);
+    return true;
+}
+
+void ParamTableBase::build(JsonDocument& doc) const {
+    ParamValue pending[WEBDASHBOARD_MAX_PARAMS];
+    portENTER_CRITICAL(&_lock);
+    uint32_t mask = _pendingMask;
+    memcpy(pending, _pending, _count * sizeof(ParamValue));
+    portEXIT_CRITICAL(&_lock);
+
+    JsonArray list = doc.createNestedArray("params");
+    for (uint8_t id = 0; id < _count; id++) {
+        const DashboardParam& param = _params[id];
+        if (!(param.flags & PARAM_EDITABLE) || param.type == PARAM_TEXT) continue;
+
+        bool edited = mask & (1UL << id);
+        JsonObject entry = list.createNestedObject();
+        entry["key"] = param.key;
+        entry["label"] = param.label;
+        entry["type"] = TYPE_NAMES[param.type];
+        switch (param.type) {
+            case PARAM_FLOAT:
+                entry["value"] = edited ? pending[id].f : *(const float*)param.target;
+                break;
+            case PARAM_INT:
+                entry["value"] = edited ? pending[id].i : *(const int32_t*)param.target;
+                break;
+            default:
+                entry["value"] = edited ? pending[id].b : *(const bool*)param.target;
+                break;
+        }
+        if (param.type != PARAM_BOOL) {
+            entry["min"] = param.min;
+            entry["max"] = param.max;
+        }
+    }
+}
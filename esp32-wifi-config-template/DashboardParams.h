@@ -0,0 +1,163 @@
+/*
+ * DashboardParams.h
+ *
+ * Settings that survive a restart, stored in NVS (Preferences), some of
+ * them tunable from the dashboard.
+ *
+ *   float onThreshold = 2000;          // Defaults as usual
+ *   bool relayState = false;
+ *   ParamTable<8> params;
+ *
+ *   params.addFloat("on", &onThreshold, 0, 4095, "Relay on above");
+ *   params.addBool("relay", &relayState, PARAM_PERSIST);   // Not shown
+ *   params.begin();                    // Restore, before dashboard.begin()
+ *   dashboard.setParams(params);
+ *
+ * The table points at your own variables; keep using them as before.
+ * Nothing has to be marked: every loop() the dashboard compares each
+ * variable with the value last written (raw bits, or a hash for text)
+ * and so keeps the dirty set in RAM. Dirty entries are written together
+ * once the first of them has waited DASHBOARD_PARAMS_FLUSH ms, so a
+ * burst of changes (a user clicking through modes) costs one write per
+ * key instead of one per click. flush() writes immediately; the
+ * dashboard calls it before the /api/reset restart.
+ *
+ * begin() restores every key found in NVS (values outside [min, max]
+ * are ignored), so the variables hold their saved values before the
+ * first publish. It only reads, which takes well under a millisecond
+ * per key.
+ *
+ * PARAM_EDITABLE entries (the default for numbers) are listed by GET
+ * /api/params and changed by POST /api/params. An edit is validated by
+ * the handler and applied from loop(), like any other command, then
+ * onParamChange() is called.
+ *
+ * Keys are NVS keys: at most 15 characters. Text parameters are
+ * persisted but not editable from the page.
+ */
+
+#ifndef DASHBOARD_PARAMS_H
+#define DASHBOARD_PARAMS_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <Preferences.h>
+
+#define DASHBOARD_PARAMS_FLUSH 10000    // ms a change may wait before it is written
+#define DASHBOARD_PARAMS_NAMESPACE "dashboard"
+#define PARAM_INVALID 0xFF
+
+#ifndef WEBDASHBOARD_MAX_PARAMS
+#define WEBDASHBOARD_MAX_PARAMS 16
+#endif
+
+static_assert(WEBDASHBOARD_MAX_PARAMS <= 32, "Dirty sets are 32-bit masks");
+
+enum ParamType : uint8_t {
+    PARAM_FLOAT,
+    PARAM_INT,
+    PARAM_BOOL,
+    PARAM_TEXT
+};
+
+enum ParamFlags : uint8_t {
+    PARAM_PERSIST  = 0x00,      // Saved and restored only
+    PARAM_EDITABLE = 0x01       // Also listed and writable at /api/params
+};
+
+struct DashboardParam {
+    const char* key;            // NVS key and JSON name
+    const char* label;          // Shown on the page (nullptr = key)
+    void* target;               // float / int32_t / bool / char[size]
+    ParamType type;
+    uint8_t flags;
+    uint8_t size;               // PARAM_TEXT: buffer size
+    float min;
+    float max;
+};
+
+// A pending edit from /api/params
+union ParamValue {
+    float f;
+    int32_t i;
+    bool b;
+};
+
+typedef void (*ParamCallback)(uint8_t id);
+
+class ParamTableBase {
+public:
+    uint8_t addFloat(const char* key, float* value, float min, float max,
+                     const char* label = nullptr, uint8_t flags = PARAM_EDITABLE);
+    uint8_t addInt(const char* key, int32_t* value, int32_t min, int32_t max,
+                   const char* label = nullptr, uint8_t flags = PARAM_EDITABLE);
+    uint8_t addBool(const char* key, bool* value, uint8_t flags = PARAM_PERSIST,
+                    const char* label = nullptr);
+    uint8_t addText(const char* key, char* buffer, uint8_t size);
+
+    // Open the NVS namespace and restore the saved values
+    bool begin(const char* ns = DASHBOARD_PARAMS_NAMESPACE);
+
+    // Write the dirty entries now (blocks for the NVS writes)
+    void flush();
+
+    // From loop(): apply pending edits, track changes, flush when due
+    void service(uint32_t now);
+
+    // Called from loop() after an edit from the page was applied
+    void onChange(ParamCallback callback) { _callback = callback; }
+
+    // Handler side (any task): validate and queue edits, all or nothing
+    bool stage(JsonObjectConst edits);
+
+    // GET /api/params listing (pending edits shown with their new value)
+    void build(JsonDocument& doc) const;
+
+    uint8_t count() const { return _count; }
+    uint8_t find(const char* key) const;
+    uint32_t dirty() const { return _dirty; }
+    uint32_t writes() const { return _writes; }     // NVS writes since boot
+
+protected:
+    ParamTableBase(DashboardParam* params, uint32_t* saved, ParamValue* pending,
+                   uint8_t capacity);
+
+private:
+    DashboardParam* _params;
+    uint32_t* _saved;           // Bits (or text hash) as last written
+    ParamValue* _pending;
+    uint8_t _capacity;
+    uint8_t _count;
+
+    Preferences _preferences;
+    bool _open;
+    uint32_t _dirty;
+    uint32_t _dirtySince;       // millis() when _dirty became non-zero
+    uint32_t _writes;
+
+    uint32_t _pendingMask;      // Shared with the handler under _lock
+    mutable portMUX_TYPE _lock;
+    ParamCallback _callback;
+
+    uint8_t add(const char* key, const char* label, void* target, ParamType type,
+                uint8_t flags, uint8_t size, float min, float max);
+    uint32_t fingerprint(uint8_t id) const;
+    bool parse(const DashboardParam& param, JsonVariantConst value, ParamValue& out) const;
+    void restore(uint8_t id);
+    void write(uint8_t id);
+};
+
+// Parameter table with room for N entries
+template <uint8_t N>
+class ParamTable : public ParamTableBase {
+public:
+    ParamTable() : ParamTableBase(_storage, _savedStorage, _pendingStorage, N) {}
+
+private:
+    static_assert(N <= WEBDASHBOARD_MAX_PARAMS, "Raise WEBDASHBOARD_MAX_PARAMS");
+    DashboardParam _storage[N];
+    uint32_t _savedStorage[N];
+    ParamValue _pendingStorage[N];
+};
+
+#endif // DASHBOARD_PARAMS_H
@@ -0,0 +1,70 @@
+/*
+ * DashboardPower.cpp
+ *
+ * CPU clock, light sleep and WiFi modem sleep control.
+ */
+
+#include "DashboardPower.h"
+#include <WiFi.h>
+#include <esp_wifi.h>
+#include <esp_idf_version.h>
+
+#if CONFIG_PM_ENABLE
+#include <esp_pm.h>
+
+// The config struct is per target before IDF 5
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+typedef esp_pm_config_t DashboardPmConfig;
+#elif CONFIG_IDF_TARGET_ESP32S2
+typedef esp_pm_config_esp32s2_t DashboardPmConfig;
+#elif CONFIG_IDF_TARGET_ESP32S3
+typedef esp_pm_config_esp32s3_t DashboardPmConfig;
+#elif CONFIG_IDF_TARGET_ESP32C3
+typedef esp_pm_config_esp32c3_t DashboardPmConfig;
+#else
+typedef esp_pm_config_esp32_t DashboardPmConfig;
+#endif
+
+static bool configurePm(int maxMhz, int minMhz, bool lightSleep) {
+    DashboardPmConfig config = {};
+    config.max_freq_mhz = maxMhz;
+    config.min_freq_mhz = minMhz;
+    config.light_sleep_enable = lightSleep;
+    return esp_pm_configure(&config) == ESP_OK;
+}
+#endif // CONFIG_PM_ENABLE
+
+uint8_t DashboardPower::apply(DashboardPowerMode mode) {
+    bool save = mode == POWER_SAVE;
+    uint8_t features = 0;
+    bool managed = false;
+
+#if CONFIG_PM_ENABLE
+    // Light sleep needs the tickless idle hook in the FreeRTOS build
+    bool lightSleep = false;
+#if CONFIG_FREERTOS_USE_TICKLESS_IDLE
+    lightSleep = save;
+#endif
+    managed = configurePm(DASHBOARD_CPU_MAX_MHZ,
+                          save ? DASHBOARD_CPU_MIN_MHZ : DASHBOARD_CPU_MAX_MHZ, lightSleep);
+    if (managed && save) {
+        features |= POWER_DFS;
+        if (lightSleep) features |= POWER_LIGHT_SLEEP;
+    }
+#endif
+
+    if (!managed) {
+        // No power management in this build: a fixed, lower clock
+        setCpuFrequencyMhz(save ? DASHBOARD_CPU_SAVE_MHZ : DASHBOARD_CPU_MAX_MHZ);
+        if (save) features |= POWER_CLOCKED_DOWN;
+    }
+
+    // Modem sleep only exists for the station interface
+    if (WiFi.getMode() & WIFI_STA) {
+        if (esp_wifi_set_ps(save ? WIFI_PS_MIN_MODEM : WIFI_PS_NONE) == ESP_OK && save) {
+            features |= POWER_MODEM_SLEEP;
+        }
+    }
+
+    return features;
+}
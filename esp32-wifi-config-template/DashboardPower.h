@@ -0,0 +1,52 @@
+/*
+ * DashboardPower.h
+ *
+ * Power management for WebDashboard projects.
+ *
+ * POWER_SAVE enables whatever the firmware supports, without taking
+ * the soft-AP down:
+ *
+ *   - Dynamic frequency scaling: the CPU runs at DASHBOARD_CPU_MAX_MHZ
+ *     while busy and drops to DASHBOARD_CPU_MIN_MHZ when every task is
+ *     blocked (needs CONFIG_PM_ENABLE; otherwise the CPU is simply
+ *     clocked down to DASHBOARD_CPU_SAVE_MHZ)
+ *   - Automatic light sleep between scheduler deadlines (needs
+ *     CONFIG_FREERTOS_USE_TICKLESS_IDLE, i.e. a custom sdkconfig)
+ *   - WiFi modem sleep when connected as a station; the radio wakes
+ *     for every DTIM beacon, so incoming packets are still received
+ *
+ * A soft-AP has to send beacons, so its radio never sleeps and the
+ * WiFi driver keeps light sleep from starting while the AP is up; DFS
+ * is what saves current in that case. Sleep only happens while loop()
+ * blocks, so use DashboardScheduler rather than busy loops.
+ */
+
+#ifndef DASHBOARD_POWER_H
+#define DASHBOARD_POWER_H
+
+#include <Arduino.h>
+
+#define DASHBOARD_CPU_MAX_MHZ 240   // Busy (and POWER_PERFORMANCE)
+#define DASHBOARD_CPU_MIN_MHZ 40    // Idle with DFS (XTAL frequency)
+#define DASHBOARD_CPU_SAVE_MHZ 80   // Fixed clock without DFS (WiFi minimum)
+
+enum DashboardPowerMode : uint8_t {
+    POWER_PERFORMANCE,          // Full clock, no sleep
+    POWER_SAVE                  // DFS, light sleep and modem sleep
+};
+
+// Features DashboardPower::apply() managed to enable
+enum DashboardPowerFeatures : uint8_t {
+    POWER_DFS         = 0x01,
+    POWER_LIGHT_SLEEP = 0x02,
+    POWER_MODEM_SLEEP = 0x04,
+    POWER_CLOCKED_DOWN = 0x08
+};
+
+class DashboardPower {
+public:
+    // Apply a mode; returns the DashboardPowerFeatures now active
+    static uint8_t apply(DashboardPowerMode mode);
+};
+
+#endif // DASHBOARD_POWER_H
@@ -0,0 +1,267 @@
+/*
+ * DashboardRequest.cpp
+ *
+ * Backend-specific glue for DashboardRequest.
+ */
+
+#include "DashboardRequest.h"
+
+// Request headers the handlers look at
+static const char* COLLECTED_HEADERS[] = {
+    "If-None-Match",
+    "Accept"
+};
+static const size_t COLLECTED_HEADER_COUNT = sizeof(COLLECTED_HEADERS) / sizeof(COLLECTED_HEADERS[0]);
+
+DashboardRequest::DashboardRequest(DashboardNativeRequest* native, char* buffer,
+                                   size_t bufferSize) {
+    _native = native;
+    _buffer = buffer;
+    _bufferSize = bufferSize;
+    _headerCount = 0;
+}
+
+// Both backends have the same argument API
+bool DashboardRequest::hasArg(const char* name) {
+    return _native->hasArg(name);
+}
+
+String DashboardRequest::arg(const char* name) {
+    return _native->arg(name);
+}
+
+void DashboardRequest::send(int code, const char* contentType, const String& body) {
+    send(code, contentType, body.c_str());
+}
+
+bool DashboardRequest::wantsMsgPack() {
+    if (hasArg("fmt")) {
+        return arg("fmt") == "bin";
+    }
+    return header("Accept").indexOf("msgpack") >= 0;   // application/(x-)msgpack
+}
+
+void DashboardRequest::sendJson(int code, const JsonDocument& doc) {
+    sendSerialized(code, doc, false);
+}
+
+void DashboardRequest::sendMsgPack(int code, const JsonDocument& doc) {
+    sendSerialized(code, doc, true);
+}
+
+void DashboardRequest::sendDocument(int code, const JsonDocument& doc) {
+    // Caches must keep the two representations apart
+    sendHeader("Vary", "Accept");
+    sendSerialized(code, doc, wantsMsgPack());
+}
+
+void DashboardRequest::sendHeader(const char* name, const char* value) {
+    if (_headerCount < DASHBOARD_MAX_HEADERS) {
+        _headerNames[_headerCount] = name;
+        _headerValues[_headerCount] = value;
+        _headerCount++;
+    }
+}
+
+#if WEBDASHBOARD_ASYNC
+
+// ==================== ASYNC BACKEND ====================
+
+void DashboardRequest::collectHeaders(DashboardServer* server) {
+    // ESPAsyncWebServer keeps all request headers
+}
+
+String DashboardRequest::header(const char* name) {
+    AsyncWebHeader* header = _native->getHeader(name);
+    return header ? header->value() : String();
+}
+
+uint32_t DashboardRequest::remoteAddress() {
+    AsyncClient* client = _native->client();
+    return client ? (uint32_t)client->remoteIP() : 0;
+}
+
+void DashboardRequest::onClose(std::function<void()> callback) {
+    _native->onDisconnect(callback);
+}
+
+bool DashboardRequest::readJson(JsonDocument& doc) {
+    // Collected by the route's body handler
+    const char* body = static_cast<const char*>(_native->_tempObject);
+    return body && !deserializeJson(doc, body);
+}
+
+// Attach pending headers and send
+void DashboardRequest::sendResponse(AsyncWebServerResponse* response) {
+    for (uint8_t i = 0; i < _headerCount; i++) {
+        response->addHeader(_headerNames[i], _headerValues[i]);
+    }
+    _native->send(response);
+}
+
+void DashboardRequest::send(int code, const char* contentType, const char* body) {
+    sendResponse(_native->beginResponse(code, contentType, body));
+}
+
+void DashboardRequest::sendSerialized(int code, const JsonDocument& doc, bool msgpack) {
+    // Serialized straight into the response's own buffer
+    AsyncResponseStream* response = _native->beginResponseStream(
+        msgpack ? "application/msgpack" : "application/json");
+    response->setCode(code);
+    if (msgpack) {
+        serializeMsgPack(doc, *response);
+    } else {
+        serializeJson(doc, *response);
+    }
+    sendResponse(response);
+}
+
+void DashboardRequest::send_P(int code, const char* contentType, PGM_P content) {
+    sendResponse(_native->beginResponse_P(code, contentType, content));
+}
+
+void DashboardRequest::send_P(int code, const char* contentType, const uint8_t* content, size_t length) {
+    sendResponse(_native->beginResponse_P(code, contentType, content, length));
+}
+
+#else
+
+// ==================== WEBSERVER BACKEND ====================
+
+void DashboardRequest::collectHeaders(DashboardServer* server) {
+    server->collectHeaders(COLLECTED_HEADERS, COLLECTED_HEADER_COUNT);
+}
+
+String DashboardRequest::header(const char* name) {
+    return _native->header(name);
+}
+
+uint32_t DashboardRequest::remoteAddress() {
+    return (uint32_t)_native->client().remoteIP();
+}
+
+bool DashboardRequest::readJson(JsonDocument& doc) {
+    // WebServer stores a non-form body as the "plain" argument
+    if (!_native->hasArg("plain")) {
+        return false;
+    }
+    String body = _native->arg("plain");
+    return body.length() <= DASHBOARD_BODY_MAX && !deserializeJson(doc, body);
+}
+
+#define DASHBOARD_LENGTH_UNKNOWN ((size_t)-1)
+
+static const char* reasonPhrase(int code) {
+    switch (code) {
+        case 200: return "OK";
+        case 304: return "Not Modified";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 429: return "Too Many Requests";
+        case 500: return "Internal Server Error";
+        case 503: return "Service Unavailable";
+        default:  return "";
+    }
+}
+
+// Status line + headers; returns 0 if they do not fit. Without a
+// length the body simply ends when the connection closes.
+size_t DashboardRequest::formatHead(char* out, size_t size, int code, const char* contentType,
+                                    size_t length) {
+    int n = snprintf(out, size,
+                     "HTTP/1.1 %d %s\r\n"
+                     "Content-Type: %s\r\n"
+                     "Connection: close\r\n",
+                     code, reasonPhrase(code), contentType);
+    if (length != DASHBOARD_LENGTH_UNKNOWN && n > 0 && (size_t)n < size) {
+        n += snprintf(out + n, size - n, "Content-Length: %u\r\n", (unsigned)length);
+    }
+    for (uint8_t i = 0; i < _headerCount && n > 0 && (size_t)n < size; i++) {
+        n += snprintf(out + n, size - n, "%s: %s\r\n", _headerNames[i], _headerValues[i]);
+    }
+    if (n > 0 && (size_t)n < size) {
+        n += snprintf(out + n, size - n, "\r\n");
+    }
+    return (n > 0 && (size_t)n < size) ? n : 0;
+}
+
+// The handler writes the whole response itself; WebServer sees a
+// handled request with nothing left to send and just closes the socket
+void DashboardRequest::sendRaw(int code, const char* contentType, const uint8_t* body,
+                               size_t length) {
+    char head[256];
+    size_t headLen = formatHead(head, sizeof(head), code, contentType, length);
+    if (headLen == 0) {
+        return;
+    }
+
+    WiFiClient client = _native->client();
+    client.setNoDelay(true);
+    client.write((const uint8_t*)head, headLen);
+    if (length > 0) {
+        client.write(body, length);
+    }
+}
+
+bool DashboardRequest::beginStream(int code, const char* contentType, WiFiClient& client) {
+    char head[256];
+    size_t headLen = formatHead(head, sizeof(head), code, contentType, DASHBOARD_LENGTH_UNKNOWN);
+    if (headLen == 0) {
+        return false;
+    }
+
+    client = _native->client();
+    client.setNoDelay(true);
+    return client.write((const uint8_t*)head, headLen) == headLen;
+}
+
+void DashboardRequest::send(int code, const char* contentType, const char* body) {
+    sendRaw(code, contentType, (const uint8_t*)body, strlen(body));
+}
+
+void DashboardRequest::send_P(int code, const char* contentType, PGM_P content) {
+    // Flash is memory-mapped on the ESP32, so it can be written as-is
+    sendRaw(code, contentType, (const uint8_t*)content, strlen_P(content));
+}
+
+void DashboardRequest::send_P(int code, const char* contentType, const uint8_t* content, size_t length) {
+    sendRaw(code, contentType, content, length);
+}
+
+void DashboardRequest::sendSerialized(int code, const JsonDocument& doc, bool msgpack) {
+    const char* contentType = msgpack ? "application/msgpack" : "application/json";
+    size_t length = msgpack ? measureMsgPack(doc) : measureJson(doc);
+
+    WiFiClient client = _native->client();
+    client.setNoDelay(true);
+
+    // Head and body in one buffer: one write, one TCP segment
+    size_t headLen = _buffer ? formatHead(_buffer, _bufferSize, code, contentType, length) : 0;
+    if (headLen > 0 && headLen + length < _bufferSize) {
+        if (msgpack) {
+            serializeMsgPack(doc, _buffer + headLen, _bufferSize - headLen);
+        } else {
+            serializeJson(doc, _buffer + headLen, _bufferSize - headLen);
+        }
+        client.write((const uint8_t*)_buffer, headLen + length);
+        return;
+    }
+
+    // Too big for the buffer: stream it
+    char head[256];
+    headLen = formatHead(head, sizeof(head), code, contentType, length);
+    if (headLen > 0) {
+        client.write((const uint8_t*)head, headLen);
+        if (msgpack) {
+            serializeMsgPack(doc, client);
+        } else {
+            serializeJson(doc, client);
+        }
+    }
+}
+
+WiFiClient DashboardRequest::client() {
+    return _native->client();
+}
+
+#endif // WEBDASHBOARD_ASYNC
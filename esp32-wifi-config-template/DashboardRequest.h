@@ -0,0 +1,172 @@
+/*
+ * DashboardRequest.h
+ *
+ * Thin wrapper around the HTTP server backend used by WebDashboard.
+ * Handlers talk to a DashboardRequest instead of the server directly,
+ * so the same handler code runs on both backends:
+ *
+ *   - WebServer (default)       - polled from loop() via handleClient()
+ *   - ESPAsyncWebServer         - event-driven, runs on the AsyncTCP task
+ *
+ * Select the async backend with the build flag -DWEBDASHBOARD_ASYNC=1
+ * (see [env:esp32dev-async] in platformio.ini). It needs the
+ * AsyncTCP and ESP Async WebServer libraries.
+ *
+ * Responses on the WebServer backend bypass WebServer::send(): the
+ * status line, headers and body are formatted into a caller-provided
+ * buffer and written to the socket in one go (Content-Length is known
+ * up front), so no String is allocated per response. JSON that does not
+ * fit the buffer is streamed to the socket with serializeJson().
+ * The async backend still allocates its own response objects.
+ *
+ * sendDocument() negotiates the wire format: MessagePack for clients
+ * that ask for it (?fmt=bin or Accept: application/msgpack), else JSON.
+ *
+ * sendChunked() streams a body of unknown length piece by piece from a
+ * filler function, so large responses never need one big buffer.
+ */
+
+#ifndef DASHBOARD_REQUEST_H
+#define DASHBOARD_REQUEST_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+#ifndef WEBDASHBOARD_ASYNC
+#define WEBDASHBOARD_ASYNC 0
+#endif
+
+#if WEBDASHBOARD_ASYNC
+#include <AsyncTCP.h>
+#include <ESPAsyncWebServer.h>
+typedef AsyncWebServer DashboardServer;
+typedef AsyncWebServerRequest DashboardNativeRequest;
+#else
+#include <WebServer.h>
+typedef WebServer DashboardServer;
+typedef WebServer DashboardNativeRequest;
+#endif
+
+#define DASHBOARD_MAX_HEADERS 4     // Extra response headers per request
+#define DASHBOARD_BODY_MAX 512      // Largest JSON request body (readJson())
+
+class DashboardRequest {
+public:
+    // buffer: scratch space for building responses (WebServer backend),
+    // only used for the lifetime of this request
+    DashboardRequest(DashboardNativeRequest* native, char* buffer = nullptr,
+                     size_t bufferSize = 0);
+
+    // Request headers to record (WebServer backend only keeps the
+    // headers it was told about); call once after creating the server
+    static void collectHeaders(DashboardServer* server);
+
+    // Query/form arguments
+    bool hasArg(const char* name);
+    String arg(const char* name);
+
+    // Request headers (only those listed in collectHeaders())
+    String header(const char* name);
+
+    // Client IPv4 address (as IPAddress converts it), 0 if unknown
+    uint32_t remoteAddress();
+
+#if WEBDASHBOARD_ASYNC
+    // Called when the request's socket has closed (response sent or not)
+    void onClose(std::function<void()> callback);
+#endif
+
+    // Parse a JSON request body (routes added with addPostRoute())
+    bool readJson(JsonDocument& doc);
+
+    // True if the client asked for MessagePack instead of JSON
+    bool wantsMsgPack();
+
+    // Add a response header, sent with the next send*() call.
+    // name and value must stay valid until then (use literals).
+    void sendHeader(const char* name, const char* value);
+
+    // Responses
+    void send(int code, const char* contentType, const char* body);
+    void send(int code, const char* contentType, const String& body);
+    void sendJson(int code, const JsonDocument& doc);
+    void sendMsgPack(int code, const JsonDocument& doc);
+    void sendDocument(int code, const JsonDocument& doc);   // Either, see wantsMsgPack()
+    void send_P(int code, const char* contentType, PGM_P content);
+    void send_P(int code, const char* contentType, const uint8_t* content, size_t length);
+
+    // Streamed response: filler(cursor, buffer, size) writes the next
+    // piece of the body (at most size bytes) and returns its length, or
+    // 0 when done. size is at least DASHBOARD_CHUNK_MIN. The cursor is
+    // copied into the response, because the async backend calls the
+    // filler after the handler has returned.
+    template <typename Cursor>
+    void sendChunked(int code, const char* contentType,
+                     size_t (*filler)(Cursor& cursor, char* buffer, size_t size),
+                     const Cursor& cursor);
+
+#if !WEBDASHBOARD_ASYNC
+    // Socket of the current request (to keep it open for streaming)
+    WiFiClient client();
+#endif
+
+private:
+    DashboardNativeRequest* _native;
+    char* _buffer;
+    size_t _bufferSize;
+
+    const char* _headerNames[DASHBOARD_MAX_HEADERS];
+    const char* _headerValues[DASHBOARD_MAX_HEADERS];
+    uint8_t _headerCount;
+
+    void sendSerialized(int code, const JsonDocument& doc, bool msgpack);
+
+#if WEBDASHBOARD_ASYNC
+    void sendResponse(AsyncWebServerResponse* response);
+#else
+    size_t formatHead(char* out, size_t size, int code, const char* contentType, size_t length);
+    void sendRaw(int code, const char* contentType, const uint8_t* body, size_t length);
+    bool beginStream(int code, const char* contentType, WiFiClient& client);
+#endif
+};
+
+#define DASHBOARD_CHUNK_SIZE 256    // Streaming buffer if none was provided
+#define DASHBOARD_CHUNK_MIN 128     // Smallest piece a filler is asked for
+
+template <typename Cursor>
+void DashboardRequest::sendChunked(int code, const char* contentType,
+                                   size_t (*filler)(Cursor& cursor, char* buffer, size_t size),
+                                   const Cursor& cursor) {
+#if WEBDASHBOARD_ASYNC
+    // Pulled by the AsyncTCP task as the socket drains
+    Cursor state = cursor;
+    AsyncWebServerResponse* response = _native->beginChunkedResponse(contentType,
+        [filler, state](uint8_t* buffer, size_t maxLen, size_t index) mutable -> size_t {
+            if (maxLen < DASHBOARD_CHUNK_MIN) {
+                return RESPONSE_TRY_AGAIN;  // Wait for more send window
+            }
+            return filler(state, (char*)buffer, maxLen);
+        });
+    response->setCode(code);
+    sendResponse(response);
+#else
+    WiFiClient client;
+    if (!beginStream(code, contentType, client)) {
+        return;
+    }
+
+    char chunk[DASHBOARD_CHUNK_SIZE];
+    char* buffer = _buffer ? _buffer : chunk;
+    size_t size = _buffer ? _bufferSize : sizeof(chunk);
+
+    Cursor state = cursor;
+    size_t length;
+    while ((length = filler(state, buffer, size)) > 0) {
+        if (client.write((const uint8_t*)buffer, length) != length) {
+            break;              // Client went away
+        }
+    }
+#endif
+}
+
+#endif // DASHBOARD_REQUEST_H
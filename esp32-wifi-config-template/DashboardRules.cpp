@@ -0,0 +1,319 @@
+/*
+ * DashboardRules.cpp
+ *
+ * Rule evaluation (hysteresis, minimum and maximum times) and the
+ * /api/rules edits.
+ */
+
+#include "DashboardRules.h"
+#include <math.h>
+
+// Fields a RuleEdit sets
+enum RuleField : uint8_t {
+    RULE_FIELD_THRESHOLD  = 0x01,
+    RULE_FIELD_HYSTERESIS = 0x02,
+    RULE_FIELD_MIN_ON     = 0x04,
+    RULE_FIELD_MIN_OFF    = 0x08,
+    RULE_FIELD_MAX_ON     = 0x10,
+    RULE_FIELD_ENABLED    = 0x20
+};
+
+static const char* const COMPARE_NAMES[] = { "above", "below" };
+
+RuleTableBase::RuleTableBase(DashboardRule* rules, RuleEdit* edits, uint8_t capacity) {
+    _rules = rules;
+    _edits = edits;
+    _capacity = capacity;
+    _count = 0;
+    _active = true;
+    _recheck = 0;
+    _callback = nullptr;
+    _switches = 0;
+    _trips = 0;
+    _pendingMask = 0;
+    portMUX_TYPE unlocked = portMUX_INITIALIZER_UNLOCKED;
+    _lock = unlocked;
+}
+
+int8_t RuleTableBase::add(uint8_t input, RuleCompare compare, float threshold, float hysteresis,
+                          uint8_t output) {
+    if (_count >= _capacity || input >= WEBDASHBOARD_MAX_CHANNELS
+        || output >= WEBDASHBOARD_MAX_CHANNELS || compare > RULE_BELOW
+        || isnan(threshold) || !(hysteresis >= 0)) {
+        return -1;
+    }
+
+    DashboardRule& rule = _rules[_count];
+    memset(&rule, 0, sizeof(rule));
+    rule.input = input;
+    rule.output = output;
+    rule.compare = compare;
+    rule.enabled = true;
+    rule.threshold = threshold;
+    rule.hysteresis = hysteresis;
+    rule.maxOn = DASHBOARD_RELAY_MAX_ON_TIME;
+    _recheck |= 1UL << _count;
+    return _count++;
+}
+
+void RuleTableBase::setTiming(uint8_t rule, uint32_t minOnMs, uint32_t minOffMs, uint32_t maxOnMs) {
+    if (rule >= _count) {
+        return;
+    }
+    _rules[rule].minOn = minOnMs;
+    _rules[rule].minOff = minOffMs;
+    _rules[rule].maxOn = maxOnMs;
+    _recheck |= 1UL << rule;
+}
+
+void RuleTableBase::setEnabled(uint8_t rule, bool enabled) {
+    if (rule >= _count) {
+        return;
+    }
+    _rules[rule].enabled = enabled;
+    _recheck |= 1UL << rule;
+}
+
+void RuleTableBase::recheck(uint8_t rule) {
+    if (rule < _count) {
+        _recheck |= 1UL << rule;
+    }
+}
+
+void RuleTableBase::setActive(bool active) {
+    if (active != _active) {
+        _active = active;
+        _recheck = 0xFFFFFFFFUL;
+    }
+}
+
+// ==================== EVALUATION ====================
+
+void RuleTableBase::service(ChannelTableBase& channels, uint32_t now) {
+    applyEdits();
+
+    uint32_t changed = channels.changed();
+    for (uint8_t i = 0; i < _count; i++) {
+        DashboardRule& rule = _rules[i];
+        uint32_t watched = (1UL << rule.input) | (1UL << rule.output);
+        bool due = rule.timed && (int32_t)(now - rule.due) >= 0;
+        if ((changed & watched) || (_recheck & (1UL << i)) || due) {
+            evaluate(rule, channels, now);
+        }
+    }
+    _recheck = 0;
+}
+
+void RuleTableBase::evaluate(DashboardRule& rule, ChannelTableBase& channels, uint32_t now) {
+    if (!channels.isOutput(rule.output)) {
+        return;
+    }
+
+    // Switched by someone else (a button, a restored state)
+    bool on = channels.state(rule.output);
+    if (on != rule.on) {
+        rule.on = on;
+        rule.since = now;
+    }
+    rule.timed = false;
+
+    // Safety limit first, in any mode
+    if (rule.on && rule.maxOn && now - rule.since >= rule.maxOn) {
+        Serial.printf("Rule: channel %u on for %lu ms, switched off\n", (unsigned)rule.output,
+                      (unsigned long)(now - rule.since));
+        rule.tripped = true;
+        _trips = _trips + 1;
+        change(rule, channels, false, now);
+        return;
+    }
+    if (rule.on && rule.maxOn) {
+        schedule(rule, rule.since + rule.maxOn);
+    }
+    if (!_active || !rule.enabled || !channels.valid(rule.input)) {
+        return;
+    }
+
+    // The band is crossed from the side the output is on
+    float value = channels.value(rule.input);
+    bool want;
+    if (isnan(value)) {
+        want = false;
+    } else if (rule.compare == RULE_ABOVE) {
+        want = value > (rule.on ? rule.threshold - rule.hysteresis : rule.threshold);
+    } else {
+        want = value < (rule.on ? rule.threshold + rule.hysteresis : rule.threshold);
+    }
+    if (rule.tripped) {
+        if (!want) rule.tripped = false;
+        want = false;
+    }
+    if (want == rule.on) {
+        return;
+    }
+
+    uint32_t hold = rule.on ? rule.minOn : rule.minOff;
+    if (now - rule.since < hold) {
+        schedule(rule, rule.since + hold);  // Look again when it may switch
+        return;
+    }
+    change(rule, channels, want, now);
+}
+
+void RuleTableBase::change(DashboardRule& rule, ChannelTableBase& channels, bool on, uint32_t now) {
+    rule.on = on;
+    rule.since = now;
+    rule.timed = false;
+    if (on && rule.maxOn) {
+        schedule(rule, now + rule.maxOn);
+    }
+    channels.setState(rule.output, on);
+    _switches = _switches + 1;
+    if (_callback) {
+        _callback(rule.output, on);
+    }
+}
+
+void RuleTableBase::schedule(DashboardRule& rule, uint32_t at) {
+    if (!rule.timed || (int32_t)(at - rule.due) < 0) {
+        rule.due = at;
+        rule.timed = true;
+    }
+}
+
+// ==================== /api/rules ====================
+
+void RuleTableBase::applyEdits() {
+    RuleEdit edits[WEBDASHBOARD_MAX_RULES];
+    portENTER_CRITICAL(&_lock);
+    uint32_t pending = _pendingMask;
+    _pendingMask = 0;
+    if (pending) {
+        memcpy(edits, _edits, _count * sizeof(RuleEdit));
+    }
+    portEXIT_CRITICAL(&_lock);
+
+    for (uint8_t i = 0; pending && i < _count; i++) {
+        if (!(pending & (1UL << i))) continue;
+        DashboardRule& rule = _rules[i];
+        const RuleEdit& edit = edits[i];
+        if (edit.fields & RULE_FIELD_THRESHOLD) rule.threshold = edit.threshold;
+        if (edit.fields & RULE_FIELD_HYSTERESIS) rule.hysteresis = edit.hysteresis;
+        if (edit.fields & RULE_FIELD_MIN_ON) rule.minOn = edit.minOn;
+        if (edit.fields & RULE_FIELD_MIN_OFF) rule.minOff = edit.minOff;
+        if (edit.fields & RULE_FIELD_MAX_ON) rule.maxOn = edit.maxOn;
+        if (edit.fields & RULE_FIELD_ENABLED) rule.enabled = edit.enabled;
+    }
+    _recheck |= pending;
+}
+
+// A pending edit merges with what the rule has, so build() can show it
+static void mergeRuleEdit(RuleEdit& into, const RuleEdit& edit) {
+    if (edit.fields & RULE_FIELD_THRESHOLD) into.threshold = edit.threshold;
+    if (edit.fields & RULE_FIELD_HYSTERESIS) into.hysteresis = edit.hysteresis;
+    if (edit.fields & RULE_FIELD_MIN_ON) into.minOn = edit.minOn;
+    if (edit.fields & RULE_FIELD_MIN_OFF) into.minOff = edit.minOff;
+    if (edit.fields & RULE_FIELD_MAX_ON) into.maxOn = edit.maxOn;
+    if (edit.fields & RULE_FIELD_ENABLED) into.enabled = edit.enabled;
+    into.fields |= edit.fields;
+}
+
+static bool parseRuleTime(JsonVariantConst value, uint32_t& out) {
+    if (!value.is<long>() || value.as<long>() < 0) return false;
+    out = (uint32_t)value.as<long>();
+    return true;
+}
+
+bool RuleTableBase::stage(JsonObjectConst edits) {
+    RuleEdit staged[WEBDASHBOARD_MAX_RULES];
+    uint32_t mask = 0;
+
+    for (JsonPairConst entry : edits) {
+        char* end;
+        long index = strtol(entry.key().c_str(), &end, 10);
+        JsonObjectConst fields = entry.value().as<JsonObjectConst>();
+        if (*end != '\0' || end == entry.key().c_str() || index < 0 || index >= _count
+            || fields.isNull() || (mask & (1UL << index))) {
+            return false;
+        }
+
+        RuleEdit& edit = staged[index];
+        memset(&edit, 0, sizeof(edit));
+        for (JsonPairConst field : fields) {
+            const char* key = field.key().c_str();
+            JsonVariantConst value = field.value();
+            if (strcmp(key, "threshold") == 0 && value.is<float>() && !isnan(value.as<float>())) {
+                edit.threshold = value.as<float>();
+                edit.fields |= RULE_FIELD_THRESHOLD;
+            } else if (strcmp(key, "hysteresis") == 0 && value.is<float>() && value.as<float>() >= 0) {
+                edit.hysteresis = value.as<float>();
+                edit.fields |= RULE_FIELD_HYSTERESIS;
+            } else if (strcmp(key, "minOn") == 0 && parseRuleTime(value, edit.minOn)) {
+                edit.fields |= RULE_FIELD_MIN_ON;
+            } else if (strcmp(key, "minOff") == 0 && parseRuleTime(value, edit.minOff)) {
+                edit.fields |= RULE_FIELD_MIN_OFF;
+            } else if (strcmp(key, "maxOn") == 0 && parseRuleTime(value, edit.maxOn)) {
+                edit.fields |= RULE_FIELD_MAX_ON;
+            } else if (strcmp(key, "enabled") == 0 && value.is<bool>()) {
+                edit.enabled = value.as<bool>();
+                edit.fields |= RULE_FIELD_ENABLED;
+            } else {
+                return false;
+            }
+        }
+        if (!edit.fields) {
+            return false;
+        }
+        mask |= 1UL << index;
+    }
+    if (!mask) {
+        return false;
+    }
+
+    portENTER_CRITICAL(&_lock);
+    for (uint8_t i = 0; i < _count; i++) {
+        if (!(mask & (1UL << i))) continue;
+        if (!(_pendingMask & (1UL << i))) _edits[i].fields = 0;
+        mergeRuleEdit(_edits[i], staged[i]);
+    }
+    _pendingMask |= mask;
+    portEXIT_CRITICAL(&_lock);
+    return true;
+}
+
+void RuleTableBase::build(JsonDocument& doc) const {
+    RuleEdit pending[WEBDASHBOARD_MAX_RULES];
+    portENTER_CRITICAL(&_lock);
+    uint32_t mask = _pendingMask;
+    memcpy(pending, _edits, _count * sizeof(RuleEdit));
+    portEXIT_CRITICAL(&_lock);
+
+    doc["active"] = _active;
+    JsonArray list = doc.createNestedArray("rules");
+    for (uint8_t i = 0; i < _count; i++) {
+        const DashboardRule& rule = _rules[i];
+        RuleEdit shown;
+        shown.fields = 0;
+        shown.enabled = rule.enabled;
+        shown.threshold = rule.threshold;
+        shown.hysteresis = rule.hysteresis;
+        shown.minOn = rule.minOn;
+        shown.minOff = rule.minOff;
+        shown.maxOn = rule.maxOn;
+        if (mask & (1UL << i)) {
+            mergeRuleEdit(shown, pending[i]);
+        }
+
+        JsonObject entry = list.createNestedObject();
+        entry["input"] = rule.input;
+        entry["compare"] = COMPARE_NAMES[rule.compare];
+        entry["threshold"] = shown.threshold;
+        entry["hysteresis"] = shown.hysteresis;
+        entry["output"] = rule.output;
+        entry["minOn"] = shown.minOn;
+        entry["minOff"] = shown.minOff;
+        entry["maxOn"] = shown.maxOn;
+        entry["enabled"] = shown.enabled;
+        entry["on"] = rule.on;
+        entry["tripped"] = rule.tripped;
+    }
+}
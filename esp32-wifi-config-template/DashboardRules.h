@@ -0,0 +1,171 @@
+/*
+ * DashboardRules.h
+ *
+ * Auto-mode control as a table instead of if/else in the sketch. A rule
+ * switches an output channel when an input channel crosses a threshold,
+ * with hysteresis and minimum on/off times:
+ *
+ *   RuleTable<4> rules;
+ *
+ *   // Relay on above 2000, off again below 1500; on for 5 s at least
+ *   int8_t relayRule = rules.add(chSensor, RULE_ABOVE, 2000, 500, chRelay);
+ *   rules.setTiming(relayRule, 5000, 0);
+ *   rules.onSwitch(setOutput);         // Drive the pin: (channel, state)
+ *   dashboard.setRules(rules);         // Evaluated by publish()
+ *
+ * A rule is evaluated when its input or output channel changed (the
+ * table's dirty bits, so the channel deadband applies), when a minimum
+ * time it waited for has passed, or after an edit; not on every loop.
+ * A switch sets the output channel and calls the onSwitch() callback.
+ *
+ * maxOn (DASHBOARD_RELAY_MAX_ON_TIME by default, 0 = no limit) is a
+ * safety limit: an output that has been on that long is switched off
+ * however it was switched on, also while the rules are inactive (manual
+ * mode). The rule then stays off until its condition has cleared.
+ *
+ * An input that reads NAN (a failed sensor, see DashboardSensors.h)
+ * counts as condition false, so the output goes off.
+ *
+ * GET /api/rules lists the rules; POST /api/rules changes threshold,
+ * hysteresis, times and enabled, applied by the next publish(). To keep
+ * edits across restarts, register the fields with a ParamTable; it writes
+ * them directly, so have the rule evaluated again after an edit:
+ *
+ *   params.addFloat("relayOn", &rules.rule(relayRule).threshold, 0, 4095);
+ *   params.onChange([](uint8_t id) { rules.recheck(relayRule); });
+ *
+ * Everything except stage() and build() belongs to the publishing task.
+ */
+
+#ifndef DASHBOARD_RULES_H
+#define DASHBOARD_RULES_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "DashboardChannels.h"
+
+// Default maxOn of a rule (RELAY_MAX_ON_TIME in config.h.example)
+#ifndef DASHBOARD_RELAY_MAX_ON_TIME
+#define DASHBOARD_RELAY_MAX_ON_TIME 60000   // ms, 0 = no limit
+#endif
+
+#ifndef WEBDASHBOARD_MAX_RULES
+#define WEBDASHBOARD_MAX_RULES 8
+#endif
+
+static_assert(WEBDASHBOARD_MAX_RULES <= 32, "Rule masks are 32-bit");
+
+#define DASHBOARD_RULES_DOC (64 + WEBDASHBOARD_MAX_RULES * 224)
+
+enum RuleCompare : uint8_t {
+    RULE_ABOVE,                 // On while input > threshold (off below threshold - hysteresis)
+    RULE_BELOW                  // On while input < threshold (off above threshold + hysteresis)
+};
+
+struct DashboardRule {
+    uint8_t input;              // Channel compared
+    uint8_t output;             // Output channel switched
+    uint8_t compare;            // RuleCompare
+    bool enabled;
+    float threshold;
+    float hysteresis;           // >= 0
+    uint32_t minOn;             // ms an output stays on at least
+    uint32_t minOff;            // ms it stays off at least (counted from boot at first)
+    uint32_t maxOn;             // ms after which it is forced off, 0 = never
+
+    bool on;                    // Output state as last seen
+    bool tripped;               // Forced off by maxOn, until the condition clears
+    bool timed;                 // 'due' is set
+    uint32_t since;             // millis() of the last switch
+    uint32_t due;               // millis() of the next timed evaluation
+};
+
+// Pending edit from /api/rules
+struct RuleEdit {
+    uint8_t fields;             // RuleField bits
+    bool enabled;
+    float threshold;
+    float hysteresis;
+    uint32_t minOn;
+    uint32_t minOff;
+    uint32_t maxOn;
+};
+
+typedef void (*RuleCallback)(uint8_t output, bool state);
+
+class RuleTableBase {
+public:
+    // Returns the rule index, -1 if full or an argument is invalid
+    int8_t add(uint8_t input, RuleCompare compare, float threshold, float hysteresis,
+               uint8_t output);
+    void setTiming(uint8_t rule, uint32_t minOnMs, uint32_t minOffMs,
+                   uint32_t maxOnMs = DASHBOARD_RELAY_MAX_ON_TIME);
+    void setEnabled(uint8_t rule, bool enabled);
+
+    // Evaluate the rule at the next service(), e.g. after its fields were
+    // written through rule()
+    void recheck(uint8_t rule);
+
+    // Fields, e.g. to register them as parameters (valid ids only)
+    DashboardRule& rule(uint8_t id) { return _rules[id]; }
+
+    // Rules only switch while active (e.g. in auto mode); maxOn is
+    // enforced either way
+    void setActive(bool active);
+    bool active() const { return _active; }
+
+    // Called after the rule switched the channel
+    void onSwitch(RuleCallback callback) { _callback = callback; }
+
+    // From the publishing task before the channels are taken (publish()
+    // does it): evaluate what changed or is due
+    void service(ChannelTableBase& channels, uint32_t now);
+
+    // Handler side (any task): validate and queue edits, all or nothing.
+    // {"<index>":{"threshold":..,"hysteresis":..,"minOn":..,"minOff":..,
+    // "maxOn":..,"enabled":..}}
+    bool stage(JsonObjectConst edits);
+
+    // GET /api/rules listing
+    void build(JsonDocument& doc) const;
+
+    uint8_t count() const { return _count; }
+    uint32_t switches() const { return _switches; }
+    uint32_t trips() const { return _trips; }       // maxOn cut-offs
+
+protected:
+    RuleTableBase(DashboardRule* rules, RuleEdit* edits, uint8_t capacity);
+
+private:
+    DashboardRule* _rules;
+    RuleEdit* _edits;
+    uint8_t _capacity;
+    uint8_t _count;
+    bool _active;
+    uint32_t _recheck;          // Rules to evaluate regardless of changes
+    RuleCallback _callback;
+    volatile uint32_t _switches;
+    volatile uint32_t _trips;
+
+    uint32_t _pendingMask;      // Shared with the handler under _lock
+    mutable portMUX_TYPE _lock;
+
+    void applyEdits();
+    void evaluate(DashboardRule& rule, ChannelTableBase& channels, uint32_t now);
+    void change(DashboardRule& rule, ChannelTableBase& channels, bool on, uint32_t now);
+    static void schedule(DashboardRule& rule, uint32_t at);
+};
+
+template <uint8_t N>
+class RuleTable : public RuleTableBase {
+    static_assert(N > 0 && N <= WEBDASHBOARD_MAX_RULES, "RuleTable capacity must be 1..WEBDASHBOARD_MAX_RULES");
+
+public:
+    RuleTable() : RuleTableBase(_storage, _editStorage, N) {}
+
+private:
+    DashboardRule _storage[N];
+    RuleEdit _editStorage[N];
+};
+
+#endif // DASHBOARD_RULES_H
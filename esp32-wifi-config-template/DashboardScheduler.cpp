@@ -0,0 +1,185 @@
+/*
+ * DashboardScheduler.cpp
+ *
+ * Min-heap scheduler implementation.
+ */
+
+#include "DashboardScheduler.h"
+
+// Wrap-safe "a is earlier than b" for millis() timestamps
+static bool before(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) < 0;
+}
+
+DashboardScheduler::DashboardScheduler() {
+    _count = 0;
+    _overruns = 0;
+    _owner = nullptr;
+    portMUX_TYPE unlocked = portMUX_INITIALIZER_UNLOCKED;
+    _lock = unlocked;
+}
+
+int8_t DashboardScheduler::every(uint32_t periodMs, SchedulerCallback callback,
+                                 uint32_t firstDelayMs) {
+    return add(periodMs, callback, nullptr, nullptr, firstDelayMs);
+}
+
+int8_t DashboardScheduler::every(uint32_t periodMs, SchedulerMethod method, void* context,
+                                 uint32_t firstDelayMs) {
+    return add(periodMs, nullptr, method, context, firstDelayMs);
+}
+
+int8_t DashboardScheduler::add(uint32_t periodMs, SchedulerCallback callback,
+                               SchedulerMethod method, void* context, uint32_t firstDelayMs) {
+    if (!callback && !method) {
+        return SCHEDULER_INVALID;
+    }
+
+    portENTER_CRITICAL(&_lock);
+    if (_count >= DASHBOARD_SCHEDULER_TASKS) {
+        portEXIT_CRITICAL(&_lock);
+        return SCHEDULER_INVALID;
+    }
+
+    // Ids are handed out in order and never reused
+    int8_t id = _count;
+    Entry& entry = _heap[_count];
+    entry.due = millis() + firstDelayMs;
+    entry.deadline = entry.due;
+    entry.period = periodMs > 0 ? periodMs : 1;
+    entry.callback = callback;
+    entry.method = method;
+    entry.context = context;
+    entry.id = id;
+    siftUp(_count++);
+    portEXIT_CRITICAL(&_lock);
+
+    if (_owner) {
+        xTaskNotifyGive(_owner);    // May be due before the current sleep ends
+    }
+    return id;
+}
+
+void DashboardScheduler::setPeriod(int8_t id, uint32_t periodMs) {
+    bool earlier = false;
+
+    portENTER_CRITICAL(&_lock);
+    int8_t index = find(id);
+    if (index >= 0) {
+        Entry& entry = _heap[index];
+        entry.period = periodMs > 0 ? periodMs : 1;
+
+        // Shorter: do not wait out the rest of the old period
+        uint32_t deadline = millis() + entry.period;
+        if (before(deadline, entry.deadline)) {
+            entry.deadline = deadline;
+            if (before(deadline, entry.due)) {
+                entry.due = deadline;
+                siftUp(index);
+                earlier = true;
+            }
+        }
+    }
+    portEXIT_CRITICAL(&_lock);
+
+    if (earlier && _owner) {
+        xTaskNotifyGive(_owner);
+    }
+}
+
+void DashboardScheduler::wake(int8_t id, uint32_t delayMs) {
+    bool earlier = false;
+
+    portENTER_CRITICAL(&_lock);
+    int8_t index = find(id);
+    uint32_t due = millis() + delayMs;
+    if (index >= 0 && before(due, _heap[index].due)) {
+        _heap[index].due = due;
+        siftUp(index);
+        earlier = true;
+    }
+    portEXIT_CRITICAL(&_lock);
+
+    if (earlier && _owner) {
+        xTaskNotifyGive(_owner);
+    }
+}
+
+void DashboardScheduler::run(uint32_t maxSleepMs) {
+    _owner = xTaskGetCurrentTaskHandle();
+
+    uint32_t sleepMs = maxSleepMs;
+    for (;;) {
+        portENTER_CRITICAL(&_lock);
+        uint32_t now = millis();
+        if (_count == 0 || before(now, _heap[0].due)) {
+            if (_count > 0 && _heap[0].due - now < sleepMs) {
+                sleepMs = _heap[0].due - now;
+            }
+            portEXIT_CRITICAL(&_lock);
+            break;
+        }
+
+        // Next run: the next periodic deadline. Woken early, the grid
+        // stays as it is; more than a period late, skip the missed runs.
+        Entry& entry = _heap[0];
+        if (!before(now, entry.deadline)) {
+            uint32_t missed = (now - entry.deadline) / entry.period;
+            _overruns += missed;
+            entry.deadline += (missed + 1) * entry.period;
+        }
+        entry.due = entry.deadline;
+
+        SchedulerCallback callback = entry.callback;
+        SchedulerMethod method = entry.method;
+        void* context = entry.context;
+        siftDown(0);
+        portEXIT_CRITICAL(&_lock);
+
+        if (callback) {
+            callback();
+        } else {
+            method(context);
+        }
+    }
+
+    // A wake() since the check above has already given the notification,
+    // so this returns at once instead of missing it
+    TickType_t ticks = (sleepMs + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS;
+    ulTaskNotifyTake(pdTRUE, ticks);
+}
+
+int8_t DashboardScheduler::find(int8_t id) const {
+    for (uint8_t i = 0; i < _count; i++) {
+        if (_heap[i].id == id) return i;
+    }
+    return -1;
+}
+
+void DashboardScheduler::swap(uint8_t a, uint8_t b) {
+    Entry entry = _heap[a];
+    _heap[a] = _heap[b];
+    _heap[b] = entry;
+}
+
+void DashboardScheduler::siftUp(uint8_t index) {
+    while (index > 0) {
+        uint8_t parent = (index - 1) / 2;
+        if (!before(_heap[index].due, _heap[parent].due)) break;
+        swap(index, parent);
+        index = parent;
+    }
+}
+
+void DashboardScheduler::siftDown(uint8_t index) {
+    for (;;) {
+        uint8_t first = index;
+        uint8_t left = 2 * index + 1;
+        uint8_t right = left + 1;
+        if (left < _count && before(_heap[left].due, _heap[first].due)) first = left;
+        if (right < _count && before(_heap[right].due, _heap[first].due)) first = right;
+        if (first == index) break;
+        swap(index, first);
+        index = first;
+    }
+}
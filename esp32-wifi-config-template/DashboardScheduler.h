@@ -0,0 +1,93 @@
+/*
+ * DashboardScheduler.h
+ *
+ * Small cooperative scheduler for periodic work in loop().
+ *
+ * Tasks are kept in a min-heap ordered by deadline. run() executes the
+ * tasks that are due and then blocks the calling task until the next
+ * deadline, so loop() neither spins nor sleeps a fixed delay(10):
+ *
+ *   DashboardScheduler scheduler;
+ *
+ *   void setup() {
+ *       dashboard.begin();
+ *       dashboard.attach(scheduler);       // Serves requests + callbacks
+ *       scheduler.every(500, readSensors);
+ *       scheduler.every(100, updateDashboardData);
+ *   }
+ *
+ *   void loop() {
+ *       scheduler.run();
+ *   }
+ *
+ * Periods are kept on a fixed grid (deadline += period), so they do not
+ * drift with the run time of a task. A task that falls more than one
+ * period behind skips the missed runs (counted by overruns()).
+ *
+ * Other tasks can pull a task forward with wake(), e.g. when a command
+ * arrives from the server task. Callbacks always run on the task that
+ * calls run().
+ */
+
+#ifndef DASHBOARD_SCHEDULER_H
+#define DASHBOARD_SCHEDULER_H
+
+#include <Arduino.h>
+
+#define DASHBOARD_SCHEDULER_TASKS 8     // Max periodic tasks
+#define SCHEDULER_INVALID -1            // Returned by every() when full
+
+typedef void (*SchedulerCallback)();
+typedef void (*SchedulerMethod)(void* context);
+
+class DashboardScheduler {
+public:
+    DashboardScheduler();
+
+    // Run callback every periodMs, the first time after firstDelayMs.
+    // Returns the task id, or SCHEDULER_INVALID if the table is full.
+    int8_t every(uint32_t periodMs, SchedulerCallback callback, uint32_t firstDelayMs = 0);
+    int8_t every(uint32_t periodMs, SchedulerMethod method, void* context,
+                 uint32_t firstDelayMs = 0);
+
+    // Change the period of a task. A longer period takes effect after its
+    // next run; a shorter one also pulls the next run in to now + periodMs
+    // if that is sooner. Safe from any task.
+    void setPeriod(int8_t id, uint32_t periodMs);
+
+    // Run task id within delayMs, ahead of its period if needed; its
+    // periodic deadlines stay where they are. Safe from any task.
+    void wake(int8_t id, uint32_t delayMs = 0);
+
+    // Execute due tasks, then sleep until the next deadline, a wake(),
+    // or maxSleepMs, whichever comes first
+    void run(uint32_t maxSleepMs = 1000);
+
+    uint32_t overruns() const { return _overruns; }
+
+private:
+    struct Entry {
+        uint32_t due;           // Next run
+        uint32_t deadline;      // Next periodic deadline (>= due)
+        uint32_t period;
+        SchedulerCallback callback;
+        SchedulerMethod method;
+        void* context;
+        int8_t id;
+    };
+
+    Entry _heap[DASHBOARD_SCHEDULER_TASKS];  // _heap[0] is due first
+    uint8_t _count;
+    uint32_t _overruns;
+    TaskHandle_t _owner;        // Task blocked in run()
+    portMUX_TYPE _lock;         // wake() may come from another task
+
+    int8_t add(uint32_t periodMs, SchedulerCallback callback, SchedulerMethod method,
+               void* context, uint32_t firstDelayMs);
+    int8_t find(int8_t id) const;
+    void siftUp(uint8_t index);
+    void siftDown(uint8_t index);
+    void swap(uint8_t a, uint8_t b);
+};
+
+#endif // DASHBOARD_SCHEDULER_H
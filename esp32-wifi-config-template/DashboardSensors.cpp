@@ -0,0 +1,293 @@
+/*
+ * DashboardSensors.cpp
+ *
+ * Sensor table scheduling, the I2C worker task and the SHT3x driver.
+ */
+
+#include "DashboardSensors.h"
+
+#define I2C_TASK_STACK 3072
+#define SHT3X_MEASURE_MS 16         // High repeatability: 15.5 ms max
+
+// ==================== SENSOR TABLE ====================
+
+SensorTableBase::SensorTableBase(SensorSlot* slots, uint8_t capacity) {
+    _slots = slots;
+    _capacity = capacity;
+    _count = 0;
+    _channels = nullptr;
+    _totalReads = 0;
+    _totalFailures = 0;
+}
+
+int8_t SensorTableBase::add(SensorDriver& driver, uint32_t periodMs, uint8_t channel0,
+                            uint8_t channel1, uint8_t channel2, uint8_t channel3) {
+    if (_count >= _capacity) {
+        return -1;
+    }
+
+    SensorSlot& slot = _slots[_count];
+    memset(&slot, 0, sizeof(slot));
+    slot.driver = &driver;
+    slot.period = periodMs < driver.minInterval() ? driver.minInterval() : periodMs;
+    if (slot.period == 0) slot.period = 1;
+    slot.channels[0] = channel0;
+    slot.channels[1] = channel1;
+    slot.channels[2] = channel2;
+    slot.channels[3] = channel3;
+    for (uint8_t i = 0; i < DASHBOARD_SENSOR_VALUES; i++) {
+        slot.values[i] = NAN;
+    }
+    slot.error = "";
+    return _count++;
+}
+
+void SensorTableBase::begin(ChannelTableBase* channels) {
+    _channels = channels;
+    uint32_t now = millis();
+    for (uint8_t i = 0; i < _count; i++) {
+        SensorSlot& slot = _slots[i];
+        if (!slot.driver->begin()) {
+            Serial.printf("Sensor %s: not found\n", slot.driver->name());
+        }
+        // Parts like the DHT want a moment after power-up
+        slot.due = now + slot.driver->minInterval();
+    }
+}
+
+void SensorTableBase::service(uint32_t now) {
+    for (uint8_t i = 0; i < _count; i++) {
+        SensorSlot& slot = _slots[i];
+        SensorDriver* driver = slot.driver;
+
+        if (slot.busy) {
+            float values[DASHBOARD_SENSOR_VALUES];
+            SensorStatus status = driver->poll(values);
+            if (status == SENSOR_BUSY && now - slot.started < DASHBOARD_SENSOR_TIMEOUT) {
+                continue;
+            }
+            if (status == SENSOR_BUSY) {
+                driver->cancel();
+                slot.error = "timeout";
+            } else if (status == SENSOR_FAILED) {
+                slot.error = driver->error();
+            }
+            finish(slot, status, values);
+            continue;
+        }
+
+        if ((int32_t)(now - slot.due) < 0) {
+            continue;
+        }
+        // Fixed rate, but no catching up after a stall
+        slot.due += slot.period;
+        if ((int32_t)(now - slot.due) >= 0) {
+            slot.due = now + slot.period;
+        }
+        if (driver->start()) {
+            slot.busy = true;
+            slot.started = now;
+        } else {
+            slot.error = driver->error();
+            finish(slot, SENSOR_FAILED, nullptr);
+        }
+    }
+}
+
+void SensorTableBase::finish(SensorSlot& slot, SensorStatus status, const float* values) {
+    slot.busy = false;
+    slot.reads++;
+    _totalReads = _totalReads + 1;
+
+    uint8_t count = slot.driver->valueCount();
+    if (count > DASHBOARD_SENSOR_VALUES) count = DASHBOARD_SENSOR_VALUES;
+    if (status == SENSOR_OK) {
+        slot.streak = 0;
+        memcpy(slot.values, values, count * sizeof(float));
+    } else {
+        slot.failures++;
+        _totalFailures = _totalFailures + 1;
+        if (slot.streak < 0xFFFF) slot.streak++;
+        if (slot.streak < DASHBOARD_SENSOR_STALE) {
+            return;             // Keep showing the last good reading
+        }
+        for (uint8_t k = 0; k < count; k++) {
+            slot.values[k] = NAN;
+        }
+    }
+
+    if (_channels) {
+        for (uint8_t k = 0; k < count; k++) {
+            if (slot.channels[k] != CHANNEL_INVALID) {
+                _channels->setValue(slot.channels[k], slot.values[k]);
+            }
+        }
+    }
+}
+
+float SensorTableBase::value(uint8_t sensor, uint8_t index) const {
+    if (sensor >= _count || index >= DASHBOARD_SENSOR_VALUES) {
+        return NAN;
+    }
+    return _slots[sensor].values[index];
+}
+
+bool SensorTableBase::ok(uint8_t sensor) const {
+    return sensor < _count && _slots[sensor].reads > 0 && _slots[sensor].streak == 0;
+}
+
+uint32_t SensorTableBase::reads(uint8_t sensor) const {
+    return sensor < _count ? _slots[sensor].reads : 0;
+}
+
+uint32_t SensorTableBase::failures(uint8_t sensor) const {
+    return sensor < _count ? _slots[sensor].failures : 0;
+}
+
+const char* SensorTableBase::lastError(uint8_t sensor) const {
+    return sensor < _count ? _slots[sensor].error : "";
+}
+
+// ==================== I2C WORKER ====================
+
+I2cBus::I2cBus(TwoWire& wire) {
+    _wire = &wire;
+    _queue = nullptr;
+    _task = nullptr;
+    _errors = 0;
+}
+
+bool I2cBus::begin(int sda, int scl, uint32_t frequency, BaseType_t core, UBaseType_t priority) {
+    if (_task) {
+        return true;
+    }
+    if (!_wire->begin(sda, scl, frequency)) {
+        Serial.println("I2C: bus failed to start");
+        return false;
+    }
+    _queue = xQueueCreate(DASHBOARD_I2C_QUEUE, sizeof(I2cTransaction*));
+    xTaskCreatePinnedToCore(taskMain, "i2c", I2C_TASK_STACK, this, priority, &_task, core);
+    return true;
+}
+
+bool I2cBus::submit(I2cTransaction& transaction) {
+    if (!_queue || transaction.status == I2C_PENDING
+        || transaction.writeLength > DASHBOARD_I2C_DATA || transaction.readLength > DASHBOARD_I2C_DATA) {
+        return false;
+    }
+    transaction.status = I2C_PENDING;
+    I2cTransaction* pointer = &transaction;
+    if (xQueueSend(_queue, &pointer, 0) != pdTRUE) {
+        transaction.status = I2C_FAILED;
+        return false;
+    }
+    return true;
+}
+
+void I2cBus::taskMain(void* arg) {
+    I2cBus* bus = static_cast<I2cBus*>(arg);
+    I2cTransaction* transaction;
+    for (;;) {
+        if (xQueueReceive(bus->_queue, &transaction, portMAX_DELAY) == pdTRUE) {
+            bus->run(*transaction);
+        }
+    }
+}
+
+// Write, then read with a repeated start
+void I2cBus::run(I2cTransaction& transaction) {
+    bool ok = true;
+    if (transaction.writeLength > 0) {
+        _wire->beginTransmission(transaction.address);
+        _wire->write(transaction.data, transaction.writeLength);
+        ok = _wire->endTransmission(transaction.readLength == 0) == 0;
+    }
+    if (ok && transaction.readLength > 0) {
+        uint8_t got = _wire->requestFrom(transaction.address, transaction.readLength);
+        ok = got == transaction.readLength;
+        for (uint8_t i = 0; i < got && i < DASHBOARD_I2C_DATA; i++) {
+            transaction.data[i] = _wire->read();
+        }
+    }
+    if (!ok) {
+        _errors = _errors + 1;
+    }
+    transaction.status = ok ? I2C_DONE : I2C_FAILED;
+}
+
+// ==================== SHT3x ====================
+
+Sht3xSensor::Sht3xSensor(I2cBus& bus, uint8_t address) {
+    _bus = &bus;
+    _address = address;
+    _phase = 0;
+    _commanded = 0;
+    memset(&_transaction, 0, sizeof(_transaction));
+    _error = "";
+}
+
+// CRC-8, polynomial 0x31, init 0xFF (datasheet 4.12)
+static uint8_t sht3xCrc(const uint8_t* data) {
+    uint8_t crc = 0xFF;
+    for (uint8_t i = 0; i < 2; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = crc & 0x80 ? (crc << 1) ^ 0x31 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+bool Sht3xSensor::start() {
+    // Single shot, high repeatability, no clock stretching
+    _transaction.address = _address;
+    _transaction.writeLength = 2;
+    _transaction.readLength = 0;
+    _transaction.data[0] = 0x24;
+    _transaction.data[1] = 0x00;
+    if (!_bus->submit(_transaction)) {
+        _error = "bus busy";
+        return false;
+    }
+    _phase = 1;
+    _commanded = millis();
+    return true;
+}
+
+SensorStatus Sht3xSensor::poll(float* values) {
+    if (_transaction.status == I2C_PENDING) {
+        return SENSOR_BUSY;
+    }
+    if (_transaction.status == I2C_FAILED) {
+        _phase = 0;
+        _error = "no ACK";
+        return SENSOR_FAILED;
+    }
+
+    if (_phase == 1) {
+        if (millis() - _commanded < SHT3X_MEASURE_MS) {
+            return SENSOR_BUSY;
+        }
+        _transaction.writeLength = 0;
+        _transaction.readLength = 6;
+        if (!_bus->submit(_transaction)) {
+            _phase = 0;
+            _error = "bus busy";
+            return SENSOR_FAILED;
+        }
+        _phase = 2;
+        return SENSOR_BUSY;
+    }
+
+    _phase = 0;
+    const uint8_t* data = _transaction.data;
+    if (sht3xCrc(data) != data[2] || sht3xCrc(data + 3) != data[5]) {
+        _error = "checksum";
+        return SENSOR_FAILED;
+    }
+    uint16_t rawTemperature = (uint16_t)(data[0] << 8 | data[1]);
+    uint16_t rawHumidity = (uint16_t)(data[3] << 8 | data[4]);
+    values[0] = -45.0f + 175.0f * rawTemperature / 65535.0f;
+    values[1] = 100.0f * rawHumidity / 65535.0f;
+    return SENSOR_OK;
+}
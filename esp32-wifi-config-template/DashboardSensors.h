@@ -0,0 +1,210 @@
+/*
+ * DashboardSensors.h
+ *
+ * Sensors that are read without stalling loop(). A SensorDriver starts
+ * a transaction and is polled until it is over; the hardware does the
+ * waiting (RMT capture for a DHT, see DashboardDht.h; a worker task for
+ * I2C, see I2cBus below). A SensorTable runs the drivers on their
+ * periods and writes the results into the channel table:
+ *
+ *   SensorTable<4> sensors;
+ *   DhtSensor dht(4, DHT_MODEL_22);
+ *
+ *   sensors.add(dht, 2000, chTemperature, chHumidity);
+ *   sensors.begin(&channels);
+ *
+ *   void updateDashboardData() {
+ *       sensors.service(millis());     // Before publish()
+ *       dashboard.publish(systemInfo);
+ *   }
+ *
+ * A failed read is counted, never turned into a value: the channel
+ * keeps the last good reading, and after DASHBOARD_SENSOR_STALE
+ * failures in a row it becomes NAN (shown as "--", null in JSON).
+ * reads(), failures() and lastError() tell what happened; with
+ * dashboard.setSensors() the totals are also in /api/metrics.
+ *
+ * service() and the getters belong to the publishing task, like the
+ * channel table.
+ */
+
+#ifndef DASHBOARD_SENSORS_H
+#define DASHBOARD_SENSORS_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "DashboardChannels.h"
+
+#define DASHBOARD_SENSOR_VALUES 4       // Most values one driver reports
+#define DASHBOARD_SENSOR_TIMEOUT 1000   // ms a read may take before it failed
+#define DASHBOARD_SENSOR_STALE 3        // Failures in a row before the values are NAN
+#define DASHBOARD_I2C_QUEUE 8           // Transactions waiting for the bus
+#define DASHBOARD_I2C_DATA 16           // Bytes per transaction (write, then read)
+
+enum SensorStatus : uint8_t {
+    SENSOR_BUSY,                // Transaction still running
+    SENSOR_OK,                  // Values filled in
+    SENSOR_FAILED               // See error()
+};
+
+// ==================== DRIVER INTERFACE ====================
+
+class SensorDriver {
+public:
+    virtual ~SensorDriver() {}
+
+    virtual const char* name() const = 0;
+    virtual uint8_t valueCount() const = 0;         // <= DASHBOARD_SENSOR_VALUES
+    virtual uint32_t minInterval() const { return 0; }  // Shortest ms between reads
+
+    // Once, from SensorTable::begin()
+    virtual bool begin() = 0;
+    // Start a read; must not wait for it. false = could not start.
+    virtual bool start() = 0;
+    // SENSOR_BUSY until the read is over, then SENSOR_OK with 'values'
+    // filled in or SENSOR_FAILED
+    virtual SensorStatus poll(float* values) = 0;
+    // The read took too long: give up on it
+    virtual void cancel() {}
+    // Why the last read failed
+    virtual const char* error() const { return "failed"; }
+};
+
+// ==================== SENSOR TABLE ====================
+
+struct SensorSlot {
+    SensorDriver* driver;
+    uint32_t period;
+    uint32_t due;               // millis() of the next start
+    uint32_t started;           // ... of the running read
+    bool busy;
+    uint8_t channels[DASHBOARD_SENSOR_VALUES];  // CHANNEL_INVALID = not shown
+    float values[DASHBOARD_SENSOR_VALUES];      // Last good reading (NAN = none)
+    uint32_t reads;
+    uint32_t failures;
+    uint16_t streak;            // Failures in a row
+    const char* error;          // Of the last failure
+};
+
+class SensorTableBase {
+public:
+    // Read 'driver' every periodMs (at least its minInterval()); value k
+    // goes to channel k of the list. Returns the sensor index, -1 if full.
+    int8_t add(SensorDriver& driver, uint32_t periodMs,
+               uint8_t channel0 = CHANNEL_INVALID, uint8_t channel1 = CHANNEL_INVALID,
+               uint8_t channel2 = CHANNEL_INVALID, uint8_t channel3 = CHANNEL_INVALID);
+
+    // Start the drivers; results go to 'channels' (optional)
+    void begin(ChannelTableBase* channels = nullptr);
+
+    // Start reads that are due and collect the finished ones
+    void service(uint32_t now);
+
+    // Last good value 'index' of a sensor, NAN when stale or never read
+    float value(uint8_t sensor, uint8_t index) const;
+    bool ok(uint8_t sensor) const;      // Last read succeeded
+
+    uint32_t reads(uint8_t sensor) const;
+    uint32_t failures(uint8_t sensor) const;
+    const char* lastError(uint8_t sensor) const;
+
+    // Over all sensors (read by the server for /api/metrics)
+    uint32_t totalReads() const { return _totalReads; }
+    uint32_t totalFailures() const { return _totalFailures; }
+
+    uint8_t count() const { return _count; }
+
+protected:
+    SensorTableBase(SensorSlot* slots, uint8_t capacity);
+
+private:
+    SensorSlot* _slots;
+    uint8_t _capacity;
+    uint8_t _count;
+    ChannelTableBase* _channels;
+    volatile uint32_t _totalReads;
+    volatile uint32_t _totalFailures;
+
+    void finish(SensorSlot& slot, SensorStatus status, const float* values);
+};
+
+template <uint8_t N>
+class SensorTable : public SensorTableBase {
+    static_assert(N > 0, "SensorTable needs room for a sensor");
+
+public:
+    SensorTable() : SensorTableBase(_storage, N) {}
+
+private:
+    SensorSlot _storage[N];
+};
+
+// ==================== I2C WORKER ====================
+
+enum I2cStatus : uint8_t {
+    I2C_IDLE,
+    I2C_PENDING,                // Queued or on the bus
+    I2C_DONE,
+    I2C_FAILED                  // No ACK, or fewer bytes than asked for
+};
+
+// One write and/or read; data holds the bytes to write, then the bytes read
+struct I2cTransaction {
+    uint8_t address;
+    uint8_t writeLength;
+    uint8_t readLength;
+    uint8_t data[DASHBOARD_I2C_DATA];
+    volatile uint8_t status;    // I2cStatus, set last by the worker
+};
+
+// Owns a Wire bus on its own task; drivers queue transactions and poll
+// their status, so a slow or stuck device never blocks the caller
+class I2cBus {
+public:
+    explicit I2cBus(TwoWire& wire = Wire);
+
+    bool begin(int sda = -1, int scl = -1, uint32_t frequency = 100000,
+               BaseType_t core = 1, UBaseType_t priority = 2);
+
+    // Queue a transaction (it must stay valid until it is not PENDING)
+    bool submit(I2cTransaction& transaction);
+
+    uint32_t errors() const { return _errors; }
+
+private:
+    TwoWire* _wire;
+    QueueHandle_t _queue;
+    TaskHandle_t _task;
+    volatile uint32_t _errors;
+
+    static void taskMain(void* arg);
+    void run(I2cTransaction& transaction);
+};
+
+// ==================== SHT3x ====================
+
+// Sensirion SHT30/31/35 on an I2cBus: temperature (°C) and humidity (%)
+class Sht3xSensor : public SensorDriver {
+public:
+    explicit Sht3xSensor(I2cBus& bus, uint8_t address = 0x44);
+
+    const char* name() const { return "sht3x"; }
+    uint8_t valueCount() const { return 2; }
+    uint32_t minInterval() const { return 100; }
+
+    bool begin() { return true; }
+    bool start();
+    SensorStatus poll(float* values);
+    void cancel() { _phase = 0; }
+    const char* error() const { return _error; }
+
+private:
+    I2cBus* _bus;
+    uint8_t _address;
+    uint8_t _phase;             // 0 = idle, 1 = measuring, 2 = reading
+    uint32_t _commanded;        // millis() of the measure command
+    I2cTransaction _transaction;
+    const char* _error;
+};
+
+#endif // DASHBOARD_SENSORS_H
@@ -0,0 +1,75 @@
+/*
+ * DashboardSnapshot.h
+ *
+ * Lock-free single-writer / multi-reader snapshot (seqlock over a
+ * double buffer).
+ *
+ * The writer (your loop()) commits a complete copy with publish().
+ * Readers (web server task, AsyncTCP task, ...) get the latest fully
+ * written copy with read(). Neither side takes a lock:
+ *
+ *   - publish() always writes the slot that readers are NOT using, so
+ *     it never waits.
+ *   - read() only retries if the writer published twice while the copy
+ *     was in progress, so it never spins on a preempted writer (safe
+ *     even when reader and writer share a core).
+ *
+ * Only ONE task may call publish(). T must be trivially copyable and
+ * should not hold pointers into memory the writer later reuses.
+ */
+
+#ifndef DASHBOARD_SNAPSHOT_H
+#define DASHBOARD_SNAPSHOT_H
+
+#include <stdint.h>
+#include <atomic>
+
+template <typename T>
+class DashboardSnapshot {
+public:
+    DashboardSnapshot() : _seq(0) {
+        _slots[0] = T();
+        _slots[1] = T();
+    }
+
+    // Commit a complete copy (single writer only)
+    void publish(const T& value) {
+        uint32_t seq = _seq.load(std::memory_order_relaxed);
+
+        // Odd sequence = write in progress into the slot after the latest
+        _seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        _slots[((seq >> 1) + 1) & 1] = value;
+
+        _seq.store(seq + 2, std::memory_order_release);
+    }
+
+    // Copy the latest complete value into out; returns its version
+    uint32_t read(T& out) const {
+        for (;;) {
+            uint32_t seq = _seq.load(std::memory_order_acquire);
+            uint32_t version = seq >> 1;
+
+            out = _slots[version & 1];
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            // The slot we copied is rewritten from sequence 2*version+3 on
+            uint32_t now = _seq.load(std::memory_order_relaxed);
+            if (now - (version << 1) < 3) {
+                return version;
+            }
+        }
+    }
+
+    // Number of publish() calls completed so far
+    uint32_t version() const {
+        return _seq.load(std::memory_order_acquire) >> 1;
+    }
+
+private:
+    T _slots[2];
+    std::atomic<uint32_t> _seq;
+};
+
+#endif // DASHBOARD_SNAPSHOT_H
@@ -0,0 +1,81 @@
+/*
+ * DashboardStation.cpp
+ *
+ * Non-blocking STA join and backoff reconnect.
+ */
+
+#include "DashboardStation.h"
+#include <esp_wifi.h>
+
+DashboardStation::DashboardStation() {
+    _ssid = nullptr;
+    _retryTimer = nullptr;
+    _connected = false;
+    _backoff = DASHBOARD_STA_BACKOFF_MIN;
+    _reconnects = 0;
+}
+
+void DashboardStation::begin(const char* ssid, const char* password, const char* hostname) {
+    if (!ssid || started()) {
+        return;
+    }
+    _ssid = ssid;
+
+    esp_timer_create_args_t timer = {};
+    timer.callback = retry;
+    timer.arg = this;
+    timer.name = "sta_retry";
+    esp_timer_create(&timer, &_retryTimer);
+
+    // Runs on the WiFi event task
+    WiFi.onEvent([this](arduino_event_id_t event, arduino_event_info_t info) {
+        onEvent(event);
+    });
+
+    WiFi.setAutoReconnect(false);
+    if (hostname) {
+        WiFi.setHostname(hostname);
+    }
+    WiFi.begin(ssid, password);     // Returns at once; events follow
+
+    Serial.printf("STA: joining \"%s\"\n", ssid);
+}
+
+void DashboardStation::onEvent(arduino_event_id_t event) {
+    switch (event) {
+        case ARDUINO_EVENT_WIFI_STA_GOT_IP:
+            _connected = true;
+            _backoff = DASHBOARD_STA_BACKOFF_MIN;
+            Serial.print("STA: connected, IP ");
+            Serial.println(WiFi.localIP());
+            break;
+        case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+        case ARDUINO_EVENT_WIFI_STA_LOST_IP:
+            _connected = false;
+            scheduleRetry();
+            break;
+        default:
+            break;
+    }
+}
+
+void DashboardStation::scheduleRetry() {
+    // A failed attempt can report more than one event; keep the pending retry
+    if (!_retryTimer || esp_timer_is_active(_retryTimer)) {
+        return;
+    }
+
+    uint32_t delayMs = _backoff + esp_random() % (_backoff / 4 + 1);
+    if (esp_timer_start_once(_retryTimer, (uint64_t)delayMs * 1000) == ESP_OK) {
+        Serial.printf("STA: retry in %lu ms\n", (unsigned long)delayMs);
+        _backoff = _backoff * 2 > DASHBOARD_STA_BACKOFF_MAX ? DASHBOARD_STA_BACKOFF_MAX
+                                                            : _backoff * 2;
+    }
+}
+
+// esp_timer task: start the next attempt (returns at once)
+void DashboardStation::retry(void* arg) {
+    DashboardStation* station = static_cast<DashboardStation*>(arg);
+    station->_reconnects++;
+    esp_wifi_connect();
+}
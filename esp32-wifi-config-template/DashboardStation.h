@@ -0,0 +1,54 @@
+/*
+ * DashboardStation.h
+ *
+ * Station (STA) side of the dashboard's WiFi: joins an existing network
+ * without blocking and keeps rejoining it with exponential backoff.
+ *
+ * begin() only starts the first attempt and returns. Everything after
+ * that runs off loop(): the WiFi event task notices disconnects and arms
+ * a one-shot esp_timer, whose callback starts the next attempt. The
+ * delay doubles from DASHBOARD_STA_BACKOFF_MIN up to
+ * DASHBOARD_STA_BACKOFF_MAX (plus up to 25% jitter, so a plant full of
+ * boards does not hammer the access point in lockstep after an outage)
+ * and drops back to the minimum once an address is obtained.
+ *
+ * The core's own auto-reconnect is switched off so the two do not race.
+ */
+
+#ifndef DASHBOARD_STATION_H
+#define DASHBOARD_STATION_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <esp_timer.h>
+
+#define DASHBOARD_STA_BACKOFF_MIN 1000      // ms before the first retry
+#define DASHBOARD_STA_BACKOFF_MAX 60000     // ms, upper bound of the backoff
+
+class DashboardStation {
+public:
+    DashboardStation();
+
+    // Start joining ssid (WiFi.mode() must already include STA)
+    void begin(const char* ssid, const char* password, const char* hostname);
+
+    bool started() const { return _ssid != nullptr; }
+    bool connected() const { return _connected; }
+    IPAddress localIP() const { return WiFi.localIP(); }
+
+    uint32_t reconnects() const { return _reconnects; }     // Retries since boot
+    uint32_t backoff() const { return _backoff; }           // Next retry delay (ms)
+
+private:
+    const char* _ssid;
+    esp_timer_handle_t _retryTimer;
+    volatile bool _connected;
+    uint32_t _backoff;
+    volatile uint32_t _reconnects;
+
+    void onEvent(arduino_event_id_t event);
+    void scheduleRetry();
+    static void retry(void* arg);
+};
+
+#endif // DASHBOARD_STATION_H
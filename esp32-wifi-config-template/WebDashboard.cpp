@@ -5,362 +5,66 @@
  */
 
 #include "WebDashboard.h"
+#include <esp_wifi.h>
+#include <ESPmDNS.h>
+#include <math.h>
 
 // ==================== HTML PAGE ====================
-const char HTML_PAGE[] PROGMEM = R"rawliteral(
-<!DOCTYPE html>
-<html>
-<head>
-    <meta charset="UTF-8">
-    <meta name="viewport" content="width=device-width, initial-scale=1.0">
-    <title>ESP32 Dashboard</title>
-    <style>
-        * { margin: 0; padding: 0; box-sizing: border-box; }
-        body {
-            font-family: -apple-system, BlinkMacSystemFont, 'Segoe UI', Roboto, Arial, sans-serif;
-            background: linear-gradient(135deg, #667eea 0%, #764ba2 100%);
-            min-height: 100vh;
-            padding: 20px;
-            color: #333;
-        }
-        .container {
-            max-width: 800px;
-            margin: 0 auto;
-            background: white;
-            border-radius: 16px;
-            box-shadow: 0 20px 60px rgba(0,0,0,0.3);
-            overflow: hidden;
-        }
-        header {
-            background: linear-gradient(135deg, #667eea 0%, #764ba2 100%);
-            color: white;
-            padding: 30px;
-            text-align: center;
-        }
-        h1 { font-size: 28px; margin-bottom: 5px; }
-        .subtitle { opacity: 0.9; font-size: 14px; }
-        .content { padding: 30px; }
-        .section {
-            background: #f8f9fa;
-            border-radius: 12px;
-            padding: 20px;
-            margin-bottom: 20px;
-        }
-        .section h2 {
-            font-size: 18px;
-            margin-bottom: 15px;
-            color: #667eea;
-            display: flex;
-            align-items: center;
-        }
-        .section h2::before {
-            content: "●";
-            margin-right: 10px;
-            font-size: 12px;
-        }
-        .value-display {
-            display: grid;
-            grid-template-columns: repeat(auto-fit, minmax(200px, 1fr));
-            gap: 15px;
-            margin-bottom: 15px;
-        }
-        .value-box {
-            background: white;
-            padding: 15px;
-            border-radius: 8px;
-            border-left: 4px solid #667eea;
-        }
-        .value-label {
-            font-size: 12px;
-            color: #666;
-            text-transform: uppercase;
-            letter-spacing: 0.5px;
-            margin-bottom: 5px;
-        }
-        .value-number {
-            font-size: 32px;
-            font-weight: bold;
-            color: #333;
-        }
-        .value-unit {
-            font-size: 16px;
-            color: #999;
-            margin-left: 5px;
-        }
-        .controls {
-            display: flex;
-            flex-wrap: wrap;
-            gap: 10px;
-        }
-        button {
-            flex: 1;
-            min-width: 150px;
-            padding: 12px 24px;
-            border: none;
-            border-radius: 8px;
-            font-size: 14px;
-            font-weight: 600;
-            cursor: pointer;
-            transition: all 0.3s ease;
-        }
-        .btn-primary {
-            background: linear-gradient(135deg, #667eea 0%, #764ba2 100%);
-            color: white;
-        }
-        .btn-primary:hover { transform: translateY(-2px); box-shadow: 0 4px 12px rgba(102, 126, 234, 0.4); }
-        .btn-success { background: #28a745; color: white; }
-        .btn-success:hover { background: #218838; transform: translateY(-2px); }
-        .btn-danger { background: #dc3545; color: white; }
-        .btn-danger:hover { background: #c82333; transform: translateY(-2px); }
-        .btn-secondary { background: #6c757d; color: white; }
-        .btn-secondary:hover { background: #5a6268; transform: translateY(-2px); }
-        .btn-warning { background: #ffc107; color: #333; }
-        .btn-warning:hover { background: #e0a800; transform: translateY(-2px); }
-        .status {
-            display: inline-block;
-            padding: 4px 12px;
-            border-radius: 20px;
-            font-size: 12px;
-            font-weight: 600;
-            text-transform: uppercase;
-        }
-        .status-on { background: #d4edda; color: #155724; }
-        .status-off { background: #f8d7da; color: #721c24; }
-        select, input[type="text"] {
-            width: 100%;
-            padding: 10px;
-            border: 2px solid #e0e0e0;
-            border-radius: 8px;
-            font-size: 14px;
-            margin-bottom: 10px;
-        }
-        select:focus, input:focus {
-            outline: none;
-            border-color: #667eea;
-        }
-        footer {
-            background: #f8f9fa;
-            padding: 20px;
-            text-align: center;
-            font-size: 12px;
-            color: #666;
-            border-top: 1px solid #e0e0e0;
-        }
-        .wifi-info {
-            background: #e7f3ff;
-            padding: 15px;
-            border-radius: 8px;
-            margin-bottom: 20px;
-            border-left: 4px solid #2196F3;
-        }
-        .wifi-info strong { color: #1976D2; }
-        @media (max-width: 600px) {
-            .value-display { grid-template-columns: 1fr; }
-            button { min-width: 100%; }
-        }
-    </style>
-</head>
-<body>
-    <div class="container">
-        <header>
-            <h1 id="projectName">🔧 ESP32 Dashboard</h1>
-            <p class="subtitle" id="version">v1.0</p>
-        </header>
-
-        <div class="content">
-            <div class="wifi-info">
-                <strong>📡 Connected</strong> | <strong>IP:</strong> <span id="ipAddress">192.168.4.1</span>
-            </div>
-
-            <!-- Sensor Values -->
-            <div class="section" id="sensorSection">
-                <h2>📊 Sensor Data</h2>
-                <div class="value-display" id="sensorValues">
-                    <!-- Populated dynamically -->
-                </div>
-            </div>
-
-            <!-- Output Controls -->
-            <div class="section" id="output1Section" style="display:none;">
-                <h2>💡 <span id="output1Label">Output 1</span></h2>
-                <p style="margin-bottom: 15px;">
-                    Status: <span class="status" id="output1Status">OFF</span>
-                </p>
-                <div class="controls">
-                    <button class="btn-success" onclick="setOutput1(true)">Turn ON</button>
-                    <button class="btn-danger" onclick="setOutput1(false)">Turn OFF</button>
-                </div>
-            </div>
-
-            <div class="section" id="output2Section" style="display:none;">
-                <h2>⚡ <span id="output2Label">Output 2</span></h2>
-                <p style="margin-bottom: 15px;">
-                    Status: <span class="status" id="output2Status">OFF</span>
-                </p>
-                <div class="controls">
-                    <button class="btn-success" onclick="setOutput2(true)">Turn ON</button>
-                    <button class="btn-danger" onclick="setOutput2(false)">Turn OFF</button>
-                </div>
-            </div>
-
-            <!-- Mode Selection -->
-            <div class="section">
-                <h2>⚙️ Operation Mode</h2>
-                <select id="modeSelect" onchange="changeMode()">
-                    <option value="auto">Automatic</option>
-                    <option value="manual">Manual</option>
-                    <option value="sleep">Sleep</option>
-                </select>
-                <p style="margin-top: 10px; font-size: 14px; color: #666;">
-                    Current: <strong id="currentMode">auto</strong>
-                </p>
-            </div>
-
-            <!-- System Actions -->
-            <div class="section">
-                <h2>🔄 System</h2>
-                <div class="controls">
-                    <button class="btn-primary" onclick="refreshData()">Refresh Data</button>
-                    <button class="btn-warning" onclick="blinkLED()">💡 Blink LED</button>
-                    <button class="btn-secondary" onclick="resetSystem()">Reset ESP32</button>
-                </div>
-            </div>
-        </div>
-
-        <footer>
-            <span id="footerText">ESP32 Dashboard</span> | Uptime: <span id="uptime">0</span>s
-        </footer>
-    </div>
-
-    <script>
-        // Auto-refresh every 2 seconds
-        setInterval(refreshData, 2000);
-        refreshData();
-
-        function refreshData() {
-            fetch('/api/status')
-                .then(response => response.json())
-                .then(data => {
-                    // Update sensor values
-                    updateSensorDisplay(data.sensors);
-
-                    // Update outputs
-                    if (data.outputs) {
-                        updateOutput('output1', data.outputs.output1, data.outputs.label1, data.outputs.show1);
-                        updateOutput('output2', data.outputs.output2, data.outputs.label2, data.outputs.show2);
-                    }
-
-                    // Update system info
-                    if (data.system) {
-                        document.getElementById('projectName').textContent = data.system.name || 'ESP32 Dashboard';
-                        document.getElementById('version').textContent = data.system.version || 'v1.0';
-                        document.getElementById('uptime').textContent = data.system.uptime || 0;
-                        document.getElementById('currentMode').textContent = data.system.mode || 'auto';
-                        document.getElementById('modeSelect').value = data.system.mode || 'auto';
-                    }
-                })
-                .catch(error => console.error('Error:', error));
-        }
+// Gzipped page + ETag, generated from web/dashboard.html by
+// tools/build_html.py (runs automatically as a PlatformIO pre-script).
+#include "DashboardPage.h"
 
-        function updateSensorDisplay(sensors) {
-            if (!sensors) return;
-
-            let html = '';
-            if (sensors.show1) {
-                html += `
-                    <div class="value-box">
-                        <div class="value-label">${sensors.label1}</div>
-                        <div>
-                            <span class="value-number">${sensors.value1.toFixed(1)}</span>
-                            <span class="value-unit">${sensors.unit1}</span>
-                        </div>
-                    </div>
-                `;
-            }
-            if (sensors.show2) {
-                html += `
-                    <div class="value-box">
-                        <div class="value-label">${sensors.label2}</div>
-                        <div>
-                            <span class="value-number">${sensors.value2.toFixed(1)}</span>
-                            <span class="value-unit">${sensors.unit2}</span>
-                        </div>
-                    </div>
-                `;
-            }
-            if (sensors.show3) {
-                html += `
-                    <div class="value-box">
-                        <div class="value-label">${sensors.label3}</div>
-                        <div>
-                            <span class="value-number">${sensors.value3.toFixed(1)}</span>
-                            <span class="value-unit">${sensors.unit3}</span>
-                        </div>
-                    </div>
-                `;
-            }
+#if WEBDASHBOARD_LEGACY
+// Channel ids of the built-in table behind SensorData/OutputStates
+#define LEGACY_SENSOR_CHANNEL 0     // value1..value3 -> ids 0..2
+#define LEGACY_OUTPUT_CHANNEL 3     // output1..output2 -> ids 3..4
+#endif
 
-            document.getElementById('sensorValues').innerHTML = html;
-        }
+#if WEBDASHBOARD_METRICS
+// Commands are recorded under their own type
+static_assert((int)METRICS_CONTROL == (int)CMD_CONTROL, "MetricsCommand must follow DashboardCommandType");
+#endif
 
-        function updateOutput(id, state, label, show) {
-            const section = document.getElementById(id + 'Section');
-            const status = document.getElementById(id + 'Status');
-            const labelEl = document.getElementById(id + 'Label');
-
-            if (show) {
-                section.style.display = 'block';
-                labelEl.textContent = label || id;
-                status.textContent = state ? 'ON' : 'OFF';
-                status.className = state ? 'status status-on' : 'status status-off';
-            } else {
-                section.style.display = 'none';
-            }
-        }
-
-        function setOutput1(state) {
-            fetch('/api/output1?state=' + (state ? '1' : '0'))
-                .then(response => response.json())
-                .then(data => { if (data.success) refreshData(); });
-        }
+// ==================== ROUTE TABLE ====================
 
-        function setOutput2(state) {
-            fetch('/api/output2?state=' + (state ? '1' : '0'))
-                .then(response => response.json())
-                .then(data => { if (data.success) refreshData(); });
-        }
+enum RouteFlags : uint8_t {
+    ROUTE_GET     = 0x00,
+    ROUTE_POST    = 0x01,        // Body collected first (addPostRoute)
+    ROUTE_FLEET   = 0x02,        // Only with setFleet()
+    ROUTE_PARAMS  = 0x04,        // ... setParams()
+    ROUTE_RULES   = 0x08,        // ... setRules()
+    ROUTE_CONTROL = 0x10         // Changes something: admitted first
+};
 
-        function changeMode() {
-            const mode = document.getElementById('modeSelect').value;
-            fetch('/api/mode?mode=' + mode)
-                .then(response => response.json())
-                .then(data => { if (data.success) refreshData(); });
-        }
-
-        function blinkLED() {
-            fetch('/api/custom')
-                .then(response => response.json())
-                .then(data => {
-                    // Don't show alert - LED blink is visible enough
-                    console.log('LED blink:', data.message);
-                    refreshData();
-                });
-        }
-
-        function resetSystem() {
-            if (confirm('Reset the system?')) {
-                fetch('/api/reset')
-                    .then(response => response.json())
-                    .then(data => {
-                        alert('System resetting...');
-                        setTimeout(() => location.reload(), 3000);
-                    });
-            }
-        }
-    </script>
-</body>
-</html>
-)rawliteral";
+// Registered in this order. A POST route goes before the GET route of
+// the same path, which matches any method.
+const WebDashboard::RouteEntry WebDashboard::ROUTES[] = {
+    { "/",             &WebDashboard::handleRoot,          ROUTE_GET },
+    { "/api/status",   &WebDashboard::handleStatus,        ROUTE_GET },
+    { "/api/meta",     &WebDashboard::handleMeta,          ROUTE_GET },
+    { "/api/values",   &WebDashboard::handleValues,        ROUTE_GET },
+    { "/api/history",  &WebDashboard::handleHistory,       ROUTE_GET },
+    { "/api/output",   &WebDashboard::handleOutput,        ROUTE_GET | ROUTE_CONTROL },
+    { "/api/control",  &WebDashboard::handleControl,       ROUTE_POST | ROUTE_CONTROL },
+#if WEBDASHBOARD_LEGACY
+    { "/api/output1",  &WebDashboard::handleOutputN<0>,    ROUTE_GET | ROUTE_CONTROL },
+    { "/api/output2",  &WebDashboard::handleOutputN<1>,    ROUTE_GET | ROUTE_CONTROL },
+#endif
+    { "/api/mode",     &WebDashboard::handleMode,          ROUTE_GET | ROUTE_CONTROL },
+    { "/api/reset",    &WebDashboard::handleReset,         ROUTE_GET | ROUTE_CONTROL },
+    { "/api/custom",   &WebDashboard::handleCustom,        ROUTE_GET | ROUTE_CONTROL },
+#if WEBDASHBOARD_METRICS
+    { "/api/metrics",  &WebDashboard::handleMetrics,       ROUTE_GET },
+#endif
+    { "/api/fleet",    &WebDashboard::handleFleet,         ROUTE_GET | ROUTE_FLEET },
+    { "/api/params",   &WebDashboard::handleParamsUpdate,  ROUTE_POST | ROUTE_PARAMS | ROUTE_CONTROL },
+    { "/api/params",   &WebDashboard::handleParams,        ROUTE_GET | ROUTE_PARAMS },
+    { "/api/rules",    &WebDashboard::handleRulesUpdate,   ROUTE_POST | ROUTE_RULES | ROUTE_CONTROL },
+    { "/api/rules",    &WebDashboard::handleRules,         ROUTE_GET | ROUTE_RULES },
+#if !WEBDASHBOARD_ASYNC
+    { "/api/events",   &WebDashboard::handleEvents,        ROUTE_GET },
+#endif
+};
 
 // ==================== CONSTRUCTOR ====================
 
@@ -368,15 +72,69 @@ WebDashboard::WebDashboard(const char* ssid, const char* password) {
     _ssid = ssid;
     _password = password;
     _server = nullptr;
+    _started = false;
+    _commandQueue = nullptr;
+
+    // No deferred actions yet
+    memset(_deferred, 0, sizeof(_deferred));
+    portMUX_TYPE unlocked = portMUX_INITIALIZER_UNLOCKED;
+    _deferLock = unlocked;
+    _scheduler = nullptr;
+    _schedulerTask = SCHEDULER_INVALID;
+    _powerMode = POWER_PERFORMANCE;
+
+    // Server runs from loop() unless useServerTask() is called
+    _useTask = false;
+    _taskCore = 0;
+    _taskPriority = 1;
+    _taskStackSize = 8192;
+    _serverTask = nullptr;
+
+    // No data until the first publish
+    memset(&_staged, 0, sizeof(_staged));
+    memset(&_pushed, 0, sizeof(_pushed));
+    _pushedVersion = 0;
+    _lastEventCheck = 0;
+    memset(&_statusCache, 0, sizeof(_statusCache));
+    memset(&_valuesCache, 0, sizeof(_valuesCache));
+    _cacheHits = 0;
+#if WEBDASHBOARD_ASYNC
+    _inFlight = 0;
+#endif
+    _staged.metaVersion = 1;
+    _bootId = 0;
 
-    // Initialize data pointers to nullptr
-    _sensorData = nullptr;
-    _outputStates = nullptr;
-    _systemInfo = nullptr;
+    // No channel table until setChannels() or a legacy publish()
+    _channels = nullptr;
+    _stagedTable = nullptr;
+    _stagedTableMeta = 0;
+    _history = nullptr;
+    _log = nullptr;
+    _fleet = nullptr;
+    _params = nullptr;
+    _sensors = nullptr;
+    _rules = nullptr;
+#if WEBDASHBOARD_MQTT
+    _mqtt = nullptr;
+#endif
+    _hostname[0] = '\0';
+
+#if WEBDASHBOARD_LEGACY
+    // Legacy layout, every channel hidden until its struct is published
+    for (uint8_t i = 0; i < 3; i++) {
+        _legacyChannels.add(nullptr, "", CHANNEL_HIDDEN);
+    }
+    for (uint8_t i = 0; i < 2; i++) {
+        _legacyChannels.addOutput(nullptr, CHANNEL_HIDDEN);
+    }
+#endif
 
     // Initialize callbacks to nullptr
+    _outputCallback = nullptr;
+#if WEBDASHBOARD_LEGACY
     _output1Callback = nullptr;
     _output2Callback = nullptr;
+#endif
     _modeCallback = nullptr;
     _resetCallback = nullptr;
     _customCallback = nullptr;
@@ -384,59 +142,456 @@ WebDashboard::WebDashboard(const char* ssid, const char* password) {
 
 // ==================== PUBLIC METHODS ====================
 
-void WebDashboard::begin() {
+void WebDashboard::useServerTask(BaseType_t core, UBaseType_t priority, uint32_t stackSize) {
+    _useTask = true;
+    _taskCore = core;
+    _taskPriority = priority;
+    _taskStackSize = stackSize;
+}
+
+void WebDashboard::begin(const DashboardConfig& config) {
+    _config = config;
+
+#if WEBDASHBOARD_ASYNC
+    // Handlers run on the AsyncTCP task; the server task is not needed
+    _useTask = false;
+    bool queueCommands = true;
+#else
+    bool queueCommands = _useTask;
+#endif
+    if (queueCommands) {
+        // Handlers run outside loop(); callbacks are handed to loop()
+        _commandQueue = xQueueCreate(DASHBOARD_COMMAND_QUEUE, sizeof(DashboardCommand));
+    }
+
+    _bootId = (uint32_t)random(0x7fffffff);
+
+    // Deferred: WiFi, the log and the server come up on their own task,
+    // so the sketch's control runs meanwhile (DashboardBoot.h)
+    bool deferred = _config.deferStart
+        && xTaskCreatePinnedToCore(startupTaskMain, "dashboard-up", DASHBOARD_STARTUP_STACK,
+                                   this, _taskPriority, nullptr, _taskCore) == pdPASS;
+    if (!deferred) {
+        if (_config.deferStart) {
+            Serial.println("Startup task not created, starting now");
+        }
+        start();
+    }
+    DashboardBoot::mark(BOOT_BEGIN);
+    if (!deferred) {
+        printBoot();            // Only now does the line have the begin stage
+    }
+}
+
+void WebDashboard::startupTaskMain(void* arg) {
+    WebDashboard* dashboard = static_cast<WebDashboard*>(arg);
+    dashboard->start();
+    dashboard->printBoot();
+    vTaskDelete(nullptr);
+}
+
+void WebDashboard::printBoot() {
+    DashboardBoot::print(Serial);
+    Serial.println();
+}
+
+void WebDashboard::start() {
+    startWifi();
+    DashboardBoot::mark(BOOT_WIFI);
+
+    if (_log) {
+        _log->begin(_taskCore, _taskPriority);
+    }
+
+    // Sockets for the stations that may join
+    _admission.begin(_config.maxConnections);
+
+    // Create web server
+    _server = new DashboardServer(80);
+    DashboardRequest::collectHeaders(_server);
+
+    // Setup routes
+    for (const RouteEntry& entry : ROUTES) {
+        if (!routeWanted(entry.flags)) continue;
+        if (entry.flags & ROUTE_POST) {
+            addPostRoute(entry);
+        } else {
+            addRoute(entry);
+        }
+    }
+
+    // Push stream (the WebServer backend serves it as a route)
+    _events.begin(_server, "/api/events");
+
+    // Start server
+    _server->begin();
+    DashboardBoot::mark(BOOT_SERVER);
+#if WEBDASHBOARD_ASYNC
+    Serial.println("Web server started (async)!");
+#else
+    if (_useTask) {
+        xTaskCreatePinnedToCore(serverTaskMain, "dashboard", _taskStackSize,
+                                this, _taskPriority, &_serverTask, _taskCore);
+        Serial.printf("Web server started (task on core %d)!\n", (int)_taskCore);
+    } else {
+        Serial.println("Web server started!");
+    }
+#endif
+    _started = true;            // loop() may use the server from now on
+
+    // A mode set meanwhile (e.g. a restored sleep mode)
+    if (_powerMode != POWER_PERFORMANCE) {
+        applyPowerMode();
+    }
+}
+
+void WebDashboard::setFleet(FleetBase& fleet) {
+    _fleet = &fleet;
+}
+
+void WebDashboard::setParams(ParamTableBase& params) {
+    _params = &params;
+}
+
+void WebDashboard::setSensors(SensorTableBase& sensors) {
+    _sensors = &sensors;
+}
+
+void WebDashboard::setRules(RuleTableBase& rules) {
+    _rules = &rules;
+}
+
+#if WEBDASHBOARD_MQTT
+void WebDashboard::setMqtt(DashboardMqtt& mqtt) {
+    _mqtt = &mqtt;
+}
+#endif
+
+// Interfaces per _config.wifiMode, then mDNS. Nothing here waits for
+// the station to join.
+void WebDashboard::startWifi() {
+    DashboardWifiMode mode = _config.wifiMode;
+    if (mode != DASHBOARD_AP && !_config.staSsid) {
+        Serial.println("STA: no staSsid, starting the soft-AP only");
+        mode = _config.wifiMode = DASHBOARD_AP;
+    }
+
+    if (_config.hostname) {
+        strlcpy(_hostname, _config.hostname, sizeof(_hostname));
+    } else {
+        uint8_t mac[6];
+        WiFi.macAddress(mac);
+        snprintf(_hostname, sizeof(_hostname), "dashboard-%02x%02x%02x", mac[3], mac[4], mac[5]);
+    }
+
+    WiFi.mode(mode == DASHBOARD_AP ? WIFI_AP : (mode == DASHBOARD_STA ? WIFI_STA : WIFI_AP_STA));
+    if (mode != DASHBOARD_STA) {
+        startAccessPoint();
+    }
+    if (mode != DASHBOARD_AP) {
+        _station.begin(_config.staSsid, _config.staPassword, _hostname);
+    }
+    startMdns();
+
+    if (_fleet) {
+        _fleet->begin(_taskCore, _taskPriority);
+    }
+#if WEBDASHBOARD_MQTT
+    if (_mqtt) {
+        _mqtt->begin(_hostname, _taskCore, _taskPriority);
+    }
+#endif
+}
+
+// <hostname>.local, plus a _dashboard._tcp record that aggregators
+// browse for (mDNS follows the station address as it comes and goes)
+void WebDashboard::startMdns() {
+    if (!MDNS.begin(_hostname)) {
+        Serial.println("mDNS failed to start");
+        return;
+    }
+    MDNS.addService("http", "tcp", 80);
+    MDNS.addService("dashboard", "tcp", 80);
+    MDNS.addServiceTxt("dashboard", "tcp", "values", "/api/values");
+    Serial.printf("mDNS: http://%s.local\n", _hostname);
+}
+
+static uint16_t clampSetting(uint16_t value, uint16_t low, uint16_t high) {
+    return value < low ? low : (value > high ? high : value);
+}
+
+// Soft-AP with the settings from _config (out-of-range values are
+// clamped, so a bad build flag cannot keep the AP from starting)
+void WebDashboard::startAccessPoint() {
     Serial.println("\n=== Starting WiFi Access Point ===");
 
-    // Start WiFi AP
+    _config.channel = clampSetting(_config.channel, 1, 13);
+    _config.maxConnections = clampSetting(_config.maxConnections, 1, 10);
+    _config.beaconInterval = clampSetting(_config.beaconInterval, 100, 60000);
+    _config.refreshInterval = clampSetting(_config.refreshInterval, 250, 60000);
+
     IPAddress local_IP(192, 168, 4, 1);
     IPAddress gateway(192, 168, 4, 1);
     IPAddress subnet(255, 255, 255, 0);
 
     WiFi.softAPConfig(local_IP, gateway, subnet);
-    WiFi.softAP(_ssid, _password);
+    WiFi.softAP(_ssid, _password, _config.channel, _config.hidden, _config.maxConnections);
+    WiFi.setTxPower(_config.txPower);
+
+    // Not a softAP() parameter: patch the running AP configuration
+    wifi_config_t ap;
+    if (esp_wifi_get_config(WIFI_IF_AP, &ap) == ESP_OK
+        && ap.ap.beacon_interval != _config.beaconInterval) {
+        ap.ap.beacon_interval = _config.beaconInterval;
+        esp_wifi_set_config(WIFI_IF_AP, &ap);
+    }
 
     IPAddress IP = WiFi.softAPIP();
     Serial.print("AP SSID: ");
     Serial.println(_ssid);
     Serial.print("AP IP: ");
     Serial.println(IP);
+    Serial.printf("Channel %u, max %u stations, beacon %u TU, TX power %.2f dBm\n",
+                  (unsigned)_config.channel, (unsigned)_config.maxConnections,
+                  (unsigned)_config.beaconInterval, (int)_config.txPower / 4.0f);
     Serial.println("Open browser to: http://192.168.4.1");
+}
 
-    // Create web server
-    _server = new WebServer(80);
+void WebDashboard::loop() {
+#if WEBDASHBOARD_METRICS
+    _metrics.recordLoop();
+#endif
 
-    // Setup routes
-    _server->on("/", [this]() { this->handleRoot(); });
-    _server->on("/api/status", [this]() { this->handleStatus(); });
-    _server->on("/api/output1", [this]() { this->handleOutput1(); });
-    _server->on("/api/output2", [this]() { this->handleOutput2(); });
-    _server->on("/api/mode", [this]() { this->handleMode(); });
-    _server->on("/api/reset", [this]() { this->handleReset(); });
-    _server->on("/api/custom", [this]() { this->handleCustom(); });
+    // Requests served off loop() only queue commands; run them here
+    DashboardCommand command;
+    while (_commandQueue && xQueueReceive(_commandQueue, &command, 0) == pdTRUE) {
+        execute(command);
+    }
+    runDeferred();
+    if (_params) {
+        _params->service(millis());
+    }
 
-    // Start server
-    _server->begin();
-    Serial.println("Web server started!\n");
-}
+    DashboardBoot::mark(BOOT_LOOP);
+    if (!_started) {
+        return;                 // Still coming up (start())
+    }
 
-void WebDashboard::loop() {
-    if (_server) {
+#if WEBDASHBOARD_ASYNC
+    serviceEvents();
+#else
+    if (!_useTask) {
+#if WEBDASHBOARD_METRICS
+        uint32_t start = DashboardMetrics::cycles();
+        _server->handleClient();
+        _metrics.recordPoll(start);
+#else
         _server->handleClient();
+#endif
+        serviceEvents();
     }
+#endif
+}
+
+void WebDashboard::attach(DashboardScheduler& scheduler) {
+    _schedulerTask = scheduler.every(loopInterval(), schedulerLoop, this);
+    _scheduler = &scheduler;
+}
+
+// How often the scheduler runs loop(). WebServer is polled from loop();
+// otherwise loop() only has queued commands, deferred actions and the
+// push stream, and is woken for the first two.
+uint32_t WebDashboard::loopInterval() {
+#if !WEBDASHBOARD_ASYNC
+    if (!_useTask) {
+        return _powerMode == POWER_SAVE ? DASHBOARD_POLL_INTERVAL_SAVE : DASHBOARD_POLL_INTERVAL;
+    }
+#endif
+    return DASHBOARD_EVENT_INTERVAL;
+}
+
+void WebDashboard::setPowerMode(DashboardPowerMode mode) {
+    _powerMode = mode;
+
+    // Longer sleeps between polls of the (polled) WebServer
+    if (_scheduler) {
+        _scheduler->setPeriod(_schedulerTask, loopInterval());
+    }
+
+    // Clock and modem sleep must not change during WiFi init, and modem
+    // sleep needs the interfaces: start() applies the mode when done
+    if (!_started) {
+        Serial.printf("Power: %s once WiFi is up\n", mode == POWER_SAVE ? "save" : "performance");
+        return;
+    }
+    applyPowerMode();
+}
+
+void WebDashboard::applyPowerMode() {
+    DashboardPowerMode mode = _powerMode;
+    uint8_t features = DashboardPower::apply(mode);
+    Serial.printf("Power: %s (dfs=%d light sleep=%d modem sleep=%d cpu=%luMHz)\n",
+                  mode == POWER_SAVE ? "save" : "performance",
+                  (features & POWER_DFS) != 0, (features & POWER_LIGHT_SLEEP) != 0,
+                  (features & POWER_MODEM_SLEEP) != 0, (unsigned long)getCpuFrequencyMhz());
+}
+
+void WebDashboard::schedulerLoop(void* context) {
+    static_cast<WebDashboard*>(context)->loop();
+}
+
+void WebDashboard::setChannels(ChannelTableBase& channels) {
+    _channels = &channels;
+}
+
+void WebDashboard::setHistory(HistoryBase& history) {
+    _history = &history;
+}
+
+void WebDashboard::setLog(DashboardLog& log) {
+    _log = &log;
+}
+
+void WebDashboard::publish(const SystemInfo& info) {
+    // Rules see this round's changes and may switch outputs in it
+    if (_rules && _channels) {
+        _rules->service(*_channels, millis());
+    }
+    bool changed = stageChannels();
+    changed |= setSystemInfo(info);
+    commit(changed);
+}
+
+#if WEBDASHBOARD_LEGACY
+void WebDashboard::publish(const SensorData& sensors, const OutputStates& outputs,
+                           const SystemInfo& info) {
+    stageLegacySensors(sensors);
+    stageLegacyOutputs(outputs);
+    publish(info);
 }
 
 void WebDashboard::updateSensorData(SensorData* data) {
-    _sensorData = data;
+    stageLegacySensors(*data);
+    commit(stageChannels());
 }
 
 void WebDashboard::updateOutputStates(OutputStates* states) {
-    _outputStates = states;
+    stageLegacyOutputs(*states);
+    commit(stageChannels());
 }
+#endif
 
 void WebDashboard::updateSystemInfo(SystemInfo* info) {
-    _systemInfo = info;
+    commit(setSystemInfo(*info));
+}
+
+// Hand the staged state to the server if it changed (so the push stream
+// stays quiet otherwise), and to the history if it is due
+void WebDashboard::commit(bool changed) {
+    if (changed) {
+        _state.publish(_staged);
+#if WEBDASHBOARD_MQTT
+        if (_mqtt) {
+            _mqtt->offer(_staged.channels, _staged.count, _staged.mode);
+        }
+#endif
+    }
+    if (_history) {
+        _history->record(_staged.channels, _staged.count, millis());
+    }
+    if (_log) {
+        _log->record(_staged.channels, _staged.count, millis());
+    }
 }
 
+// Copy the channels the table marked as changed (all of them after a
+// metadata change); returns whether anything did. Metadata is only
+// versioned when the table reports a change, so values can be published
+// at any rate.
+bool WebDashboard::stageChannels() {
+    if (!_channels) {
+        return false;
+    }
+
+    uint32_t changed = _channels->takeChanged();
+    bool all = false;
+    if (_channels != _stagedTable || _channels->metaVersion() != _stagedTableMeta) {
+        _stagedTable = _channels;
+        _stagedTableMeta = _channels->metaVersion();
+        _staged.metaVersion++;
+        all = true;
+    }
+    if (!all && changed == 0) {
+        return false;
+    }
+
+    _staged.count = _channels->count();
+    for (uint8_t id = 0; id < _staged.count; id++) {
+        if (all || (changed & (1UL << id))) {
+            _staged.channels[id] = _channels->channel(id);
+        }
+    }
+    return true;
+}
+
+#if WEBDASHBOARD_LEGACY
+void WebDashboard::stageLegacySensors(const SensorData& sensors) {
+    const float values[] = { sensors.value1, sensors.value2, sensors.value3 };
+    const char* labels[] = { sensors.label1, sensors.label2, sensors.label3 };
+    const char* units[] = { sensors.unit1, sensors.unit2, sensors.unit3 };
+    const bool show[] = { sensors.showValue1, sensors.showValue2, sensors.showValue3 };
+
+    for (uint8_t i = 0; i < 3; i++) {
+        uint8_t id = LEGACY_SENSOR_CHANNEL + i;
+        _legacyChannels.setLabel(id, labels[i]);
+        _legacyChannels.setUnit(id, units[i]);
+        _legacyChannels.setVisible(id, show[i]);
+        _legacyChannels.setValue(id, values[i]);
+    }
+    _channels = &_legacyChannels;
+}
+
+void WebDashboard::stageLegacyOutputs(const OutputStates& outputs) {
+    const bool states[] = { outputs.output1, outputs.output2 };
+    const char* labels[] = { outputs.label1, outputs.label2 };
+    const bool show[] = { outputs.showOutput1, outputs.showOutput2 };
+
+    for (uint8_t i = 0; i < 2; i++) {
+        uint8_t id = LEGACY_OUTPUT_CHANNEL + i;
+        _legacyChannels.setLabel(id, labels[i]);
+        _legacyChannels.setVisible(id, show[i]);
+        _legacyChannels.setState(id, states[i]);
+    }
+    _channels = &_legacyChannels;
+}
+#endif
+
+// Returns whether anything shown on the dashboard changed
+bool WebDashboard::setSystemInfo(const SystemInfo& info) {
+    bool changed = false;
+    if (!_staged.hasSystem || _staged.system.projectName != info.projectName
+        || _staged.system.version != info.version) {
+        _staged.metaVersion++;
+        changed = true;
+    }
+    const char* mode = info.mode ? info.mode : "";
+    if (changed || _staged.system.uptime != info.uptime
+        || strncmp(_staged.mode, mode, sizeof(_staged.mode) - 1) != 0) {
+        _staged.system = info;
+        // The mode string may be reassigned by the app; keep our own copy
+        strlcpy(_staged.mode, mode, sizeof(_staged.mode));
+        _staged.system.mode = nullptr;
+        _staged.hasSystem = true;
+        changed = true;
+    }
+    return changed;
+}
+
+void WebDashboard::onOutputChange(ChannelCallback callback) {
+    _outputCallback = callback;
+}
+
+#if WEBDASHBOARD_LEGACY
 void WebDashboard::onOutput1Change(OutputCallback callback) {
     _output1Callback = callback;
 }
@@ -444,6 +599,7 @@ void WebDashboard::onOutput1Change(OutputCallback callback) {
 void WebDashboard::onOutput2Change(OutputCallback callback) {
     _output2Callback = callback;
 }
+#endif
 
 void WebDashboard::onModeChange(ModeCallback callback) {
     _modeCallback = callback;
@@ -457,130 +613,1010 @@ void WebDashboard::onCustomAction(ActionCallback callback) {
     _customCallback = callback;
 }
 
+bool WebDashboard::defer(ActionCallback action, uint32_t delayMs) {
+    if (!action) {
+        return false;
+    }
+
+    bool queued = false;
+    portENTER_CRITICAL(&_deferLock);
+    for (uint8_t i = 0; i < DASHBOARD_DEFERRED_MAX; i++) {
+        if (!_deferred[i].action) {
+            _deferred[i].action = action;
+            _deferred[i].due = millis() + delayMs;
+            queued = true;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&_deferLock);
+
+    if (queued && _scheduler) {
+        _scheduler->wake(_schedulerTask, delayMs);
+    }
+    return queued;
+}
+
 IPAddress WebDashboard::getIP() {
-    return WiFi.softAPIP();
+    if (!_started) {
+        return IPAddress();
+    }
+    return _station.connected() ? _station.localIP() : WiFi.softAPIP();
 }
 
-// ==================== PRIVATE HANDLERS ====================
+// ==================== DEFERRED ACTIONS ====================
+
+void WebDashboard::runDeferred() {
+    // Take every due action under the lock, run them without it (they
+    // may defer() their next step)
+    ActionCallback due[DASHBOARD_DEFERRED_MAX];
+    uint8_t count = 0;
+    uint32_t now = millis();
+
+    portENTER_CRITICAL(&_deferLock);
+    for (uint8_t i = 0; i < DASHBOARD_DEFERRED_MAX; i++) {
+        if (_deferred[i].action && (int32_t)(now - _deferred[i].due) >= 0) {
+            due[count++] = _deferred[i].action;
+            _deferred[i].action = nullptr;
+        }
+    }
+    portEXIT_CRITICAL(&_deferLock);
+
+    for (uint8_t i = 0; i < count; i++) {
+#if WEBDASHBOARD_METRICS
+        uint32_t start = DashboardMetrics::cycles();
+        due[i]();
+        _metrics.recordCommand(METRICS_DEFERRED, start);
+#else
+        due[i]();
+#endif
+    }
+}
+
+static void restartDevice() {
+    ESP.restart();
+}
+
+// ==================== SERVER TASK ====================
+
+#if !WEBDASHBOARD_ASYNC
+void WebDashboard::serverTaskMain(void* arg) {
+    WebDashboard* dashboard = static_cast<WebDashboard*>(arg);
+    for (;;) {
+#if WEBDASHBOARD_METRICS
+        uint32_t start = DashboardMetrics::cycles();
+        dashboard->_server->handleClient();
+        dashboard->_metrics.recordPoll(start);
+#else
+        dashboard->_server->handleClient();
+#endif
+        dashboard->serviceEvents();
+        // Idle a tick between polls so lower priority tasks still run
+        vTaskDelay(1);
+    }
+}
+#endif
+
+// ==================== PUSH STREAM ====================
+
+void WebDashboard::serviceEvents() {
+    unsigned long now = millis();
+    if (now - _lastEventCheck < DASHBOARD_EVENT_INTERVAL) {
+        return;
+    }
+    _lastEventCheck = now;
+
+    bool resync = _events.takeResync();
+    if (_events.count() == 0) {
+        return;
+    }
 
-void WebDashboard::handleRoot() {
-    _server->send_P(200, "text/html", HTML_PAGE);
-}
-
-void WebDashboard::handleStatus() {
-    StaticJsonDocument<512> doc;
-
-    // Add sensor data
-    if (_sensorData) {
-        JsonObject sensors = doc.createNestedObject("sensors");
-        sensors["value1"] = _sensorData->value1;
-        sensors["value2"] = _sensorData->value2;
-        sensors["value3"] = _sensorData->value3;
-        sensors["label1"] = _sensorData->label1;
-        sensors["label2"] = _sensorData->label2;
-        sensors["label3"] = _sensorData->label3;
-        sensors["unit1"] = _sensorData->unit1;
-        sensors["unit2"] = _sensorData->unit2;
-        sensors["unit3"] = _sensorData->unit3;
-        sensors["show1"] = _sensorData->showValue1;
-        sensors["show2"] = _sensorData->showValue2;
-        sensors["show3"] = _sensorData->showValue3;
-    }
-
-    // Add output states
-    if (_outputStates) {
-        JsonObject outputs = doc.createNestedObject("outputs");
-        outputs["output1"] = _outputStates->output1;
-        outputs["output2"] = _outputStates->output2;
-        outputs["label1"] = _outputStates->label1;
-        outputs["label2"] = _outputStates->label2;
-        outputs["show1"] = _outputStates->showOutput1;
-        outputs["show2"] = _outputStates->showOutput2;
+    uint32_t version = _state.version();
+    if (!resync && version == _pushedVersion) {
+        return;
+    }
+
+    DashboardState state;
+    _pushedVersion = _state.read(state);
+
+    StaticJsonDocument<DASHBOARD_VALUES_DOC> doc;
+    const char* event = "update";
+    if (resync) {
+        // Someone just connected: bring every client to the same values
+        buildValues(doc, state);
+        event = "values";
+    } else if (!buildUpdate(doc, state, _pushed)) {
+        return;
+    }
+    _pushed = state;
+
+    // Same task as the (WebServer) handlers, so _txBuffer is free
+    if (serializeJson(doc, _txBuffer, sizeof(_txBuffer)) > 0) {
+        _events.send(event, _txBuffer, _pushedVersion);
+    }
+}
+
+// JSON keys as constants. ArduinoJson keeps a const char* key as a
+// pointer, so a response neither formats nor copies its keys.
+enum StatusKey : uint8_t {
+    KEY_VALUE,
+    KEY_LABEL,
+    KEY_UNIT,
+    KEY_SHOW,
+    KEY_OUTPUT
+};
+
+#define STATUS_KEYS_OF(n) { "value" #n, "label" #n, "unit" #n, "show" #n, "output" #n }
+// Rows in steps of 8, only as many as WEBDASHBOARD_MAX_CHANNELS needs
+static const char* const STATUS_KEYS[][5] = {
+    STATUS_KEYS_OF(1),  STATUS_KEYS_OF(2),  STATUS_KEYS_OF(3),  STATUS_KEYS_OF(4),
+    STATUS_KEYS_OF(5),  STATUS_KEYS_OF(6),  STATUS_KEYS_OF(7),  STATUS_KEYS_OF(8),
+#if WEBDASHBOARD_MAX_CHANNELS > 8
+    STATUS_KEYS_OF(9),  STATUS_KEYS_OF(10), STATUS_KEYS_OF(11), STATUS_KEYS_OF(12),
+    STATUS_KEYS_OF(13), STATUS_KEYS_OF(14), STATUS_KEYS_OF(15), STATUS_KEYS_OF(16),
+#endif
+#if WEBDASHBOARD_MAX_CHANNELS > 16
+    STATUS_KEYS_OF(17), STATUS_KEYS_OF(18), STATUS_KEYS_OF(19), STATUS_KEYS_OF(20),
+    STATUS_KEYS_OF(21), STATUS_KEYS_OF(22), STATUS_KEYS_OF(23), STATUS_KEYS_OF(24),
+#endif
+#if WEBDASHBOARD_MAX_CHANNELS > 24
+    STATUS_KEYS_OF(25), STATUS_KEYS_OF(26), STATUS_KEYS_OF(27), STATUS_KEYS_OF(28),
+    STATUS_KEYS_OF(29), STATUS_KEYS_OF(30), STATUS_KEYS_OF(31), STATUS_KEYS_OF(32)
+#endif
+};
+
+// Channel ids as the keys of an update's "c" object
+static const char* const CHANNEL_KEYS[] = {
+    "0",  "1",  "2",  "3",  "4",  "5",  "6",  "7",
+#if WEBDASHBOARD_MAX_CHANNELS > 8
+    "8",  "9",  "10", "11", "12", "13", "14", "15",
+#endif
+#if WEBDASHBOARD_MAX_CHANNELS > 16
+    "16", "17", "18", "19", "20", "21", "22", "23",
+#endif
+#if WEBDASHBOARD_MAX_CHANNELS > 24
+    "24", "25", "26", "27", "28", "29", "30", "31"
+#endif
+};
+
+static_assert(sizeof(STATUS_KEYS) / sizeof(STATUS_KEYS[0]) >= WEBDASHBOARD_MAX_CHANNELS
+              && sizeof(CHANNEL_KEYS) / sizeof(CHANNEL_KEYS[0]) >= WEBDASHBOARD_MAX_CHANNELS,
+              "A key for every channel");
+
+// Original layout: the n-th input channel is sensors.valueN/labelN/
+// unitN/showN, the n-th output channel outputs.outputN/labelN/showN
+void WebDashboard::buildStatus(JsonDocument& doc, const DashboardState& state) {
+    JsonObject sensors;
+    JsonObject outputs;
+    uint8_t sensorCount = 0;
+    uint8_t outputCount = 0;
+
+    for (uint8_t id = 0; id < state.count; id++) {
+        const DashboardChannel& channel = state.channels[id];
+        bool show = channel.flags & CHANNEL_VISIBLE;
+
+        if (channel.flags & CHANNEL_OUTPUT) {
+            if (outputs.isNull()) outputs = doc.createNestedObject("outputs");
+            const char* const* keys = STATUS_KEYS[outputCount++];
+            outputs[keys[KEY_OUTPUT]] = channel.value != 0;
+            outputs[keys[KEY_LABEL]] = channel.label;
+            outputs[keys[KEY_SHOW]] = show;
+        } else {
+            if (sensors.isNull()) sensors = doc.createNestedObject("sensors");
+            const char* const* keys = STATUS_KEYS[sensorCount++];
+            sensors[keys[KEY_VALUE]] = channel.value;
+            sensors[keys[KEY_LABEL]] = channel.label;
+            sensors[keys[KEY_UNIT]] = channel.unit;
+            sensors[keys[KEY_SHOW]] = show;
+        }
     }
 
     // Add system info
-    if (_systemInfo) {
+    if (state.hasSystem) {
         JsonObject system = doc.createNestedObject("system");
-        system["name"] = _systemInfo->projectName;
-        system["version"] = _systemInfo->version;
-        system["mode"] = _systemInfo->mode;
-        system["uptime"] = _systemInfo->uptime;
+        system["name"] = state.system.projectName;
+        system["version"] = state.system.version;
+        system["mode"] = (const char*)state.mode;
+        system["uptime"] = state.system.uptime;
     }
+}
 
-    String response;
-    serializeJson(doc, response);
-    _server->send(200, "application/json", response);
+// Static part: fetched once by the page and cached. Every channel is
+// listed (hidden ones too) so ids match the indexes of /api/values "v"
+void WebDashboard::buildMeta(JsonDocument& doc, const DashboardState& state) {
+    JsonArray channels = doc.createNestedArray("channels");
+    for (uint8_t id = 0; id < state.count; id++) {
+        const DashboardChannel& channel = state.channels[id];
+        JsonObject entry = channels.createNestedObject();
+        entry["id"] = id;
+        entry["label"] = channel.label;
+        entry["unit"] = channel.unit;
+        entry["flags"] = channel.flags;
+    }
+
+    if (state.hasSystem) {
+        JsonObject system = doc.createNestedObject("system");
+        system["name"] = state.system.projectName;
+        system["version"] = state.system.version;
+    }
+
+    doc["mv"] = state.metaVersion;
+    doc["ri"] = _config.refreshInterval;
+    doc["host"] = (const char*)_hostname;
+}
+
+// Dynamic part, flat and short keys:
+//   v = channel values by id (outputs are 0/1), m = mode, u = uptime,
+//   mv = metadata version (refetch /api/meta when it changes)
+void WebDashboard::buildValues(JsonDocument& doc, const DashboardState& state) {
+    JsonArray values = doc.createNestedArray("v");
+    for (uint8_t id = 0; id < state.count; id++) {
+        values.add(state.channels[id].value);
+    }
+    if (state.hasSystem) {
+        doc["m"] = (const char*)state.mode;
+        doc["u"] = state.system.uptime;
+    }
+    doc["mv"] = state.metaVersion;
 }
 
-void WebDashboard::handleOutput1() {
-    if (_server->hasArg("state") && _output1Callback) {
-        bool state = _server->arg("state") == "1";
-        _output1Callback(state);
+// A failed sensor stays NAN; NAN != NAN would resend it on every push
+static bool sameValue(float a, float b) {
+    return a == b || (isnan(a) && isnan(b));
+}
 
-        StaticJsonDocument<64> doc;
-        doc["success"] = true;
-        String response;
-        serializeJson(doc, response);
-        _server->send(200, "application/json", response);
+// Only the values that differ from what the clients already have:
+// "c" maps channel id -> value, the other keys are those of /api/values
+bool WebDashboard::buildUpdate(JsonDocument& doc, const DashboardState& now,
+                               const DashboardState& last) {
+    JsonObject changed;
+    bool all = now.count != last.count;
+
+    for (uint8_t id = 0; id < now.count; id++) {
+        if (!all && sameValue(now.channels[id].value, last.channels[id].value)) continue;
+        if (changed.isNull()) changed = doc.createNestedObject("c");
+        changed[CHANNEL_KEYS[id]] = now.channels[id].value;
+    }
+    if (now.hasSystem) {
+        bool all = !last.hasSystem;
+        if (all || strcmp(now.mode, last.mode) != 0) doc["m"] = (const char*)now.mode;
+        if (all || now.system.uptime != last.system.uptime) doc["u"] = now.system.uptime;
+    }
+    if (now.metaVersion != last.metaVersion) {
+        doc["mv"] = now.metaVersion;
+    }
+
+    return doc.size() > 0;
+}
+
+// ==================== ROUTING ====================
+
+bool WebDashboard::routeWanted(uint8_t flags) const {
+    return (!(flags & ROUTE_FLEET) || _fleet)
+        && (!(flags & ROUTE_PARAMS) || _params)
+        && (!(flags & ROUTE_RULES) || _rules);
+}
+
+void WebDashboard::addRoute(const RouteEntry& entry) {
+    const RouteEntry* route = &entry;
+    uint8_t slot = routeSlot(entry.path);
+#if WEBDASHBOARD_ASYNC
+    _server->on(entry.path, HTTP_ANY, [this, route, slot](AsyncWebServerRequest* native) {
+        DashboardRequest request(native);
+        serve(request, *route, slot);
+    });
+#else
+    _server->on(entry.path, [this, route, slot]() {
+        // Requests are served one at a time, so they share _txBuffer
+        DashboardRequest request(_server, _txBuffer, sizeof(_txBuffer));
+        serve(request, *route, slot);
+    });
+#endif
+}
+
+// Metrics histogram of a route (unused without WEBDASHBOARD_METRICS)
+uint8_t WebDashboard::routeSlot(const char* path) {
+#if WEBDASHBOARD_METRICS
+    return _metrics.addRoute(path);
+#else
+    return 0;
+#endif
+}
+
+void WebDashboard::serve(DashboardRequest& request, const RouteEntry& entry, uint8_t route) {
+    if (!admit(request, entry.flags & ROUTE_CONTROL)) {
+        return;
+    }
+    if (entry.flags & ROUTE_CONTROL) {
+        // The change reaches _state at a later publish(): end the time
+        // window only, so the entry is served until the version moves and
+        // the first poll after that rebuilds
+        _statusCache.at = millis() - DASHBOARD_STATUS_CACHE_MS;
+        _valuesCache.at = _statusCache.at;
+    }
+
+#if WEBDASHBOARD_METRICS
+    uint32_t start = DashboardMetrics::cycles();
+    (this->*entry.handler)(request);
+    _metrics.recordRoute(route, start);
+#else
+    (this->*entry.handler)(request);
+#endif
+    DashboardBoot::mark(BOOT_FIRST_REQUEST);
+}
+
+// Socket limit and per-client rate (DashboardAdmission.h); answers the
+// request itself when it is refused
+bool WebDashboard::admit(DashboardRequest& request, bool control) {
+#if WEBDASHBOARD_ASYNC
+    uint8_t open = _inFlight + _events.count();
+#else
+    uint8_t open = _events.count();     // Requests are served one at a time
+#endif
+    AdmissionResult result = _admission.admit(request.remoteAddress(), control, open, millis());
+    if (result == ADMIT_LIMITED) {
+        request.sendHeader("Retry-After", "1");
+        request.send(429, "application/json", "{\"error\":\"Too many requests\"}");
+        return false;
+    }
+    if (result == ADMIT_BUSY) {
+        request.sendHeader("Retry-After", "2");
+        request.send(503, "application/json", "{\"error\":\"Busy\"}");
+        return false;
+    }
+
+#if WEBDASHBOARD_ASYNC
+    // Admitted requests hold their socket until the response is sent
+    _inFlight = _inFlight + 1;
+    request.onClose([this]() { _inFlight = _inFlight - 1; });
+#endif
+    return true;
+}
+
+#if WEBDASHBOARD_ASYNC
+void WebDashboard::addPostRoute(const RouteEntry& entry) {
+    // The body arrives in pieces before the request handler runs; collect
+    // it in _tempObject, which the request frees when it is destroyed
+    const RouteEntry* route = &entry;
+    uint8_t slot = routeSlot(entry.path);
+    _server->on(entry.path, HTTP_POST, [this, route, slot](AsyncWebServerRequest* native) {
+        DashboardRequest request(native);
+        serve(request, *route, slot);
+    }, nullptr, [](AsyncWebServerRequest* native, uint8_t* data, size_t len,
+                   size_t index, size_t total) {
+        if (total > DASHBOARD_BODY_MAX) {
+            return;                 // No body: the handler answers 400
+        }
+        if (index == 0) {
+            native->_tempObject = malloc(total + 1);
+        }
+        char* body = static_cast<char*>(native->_tempObject);
+        if (body && index + len <= total) {
+            memcpy(body + index, data, len);
+            body[index + len] = '\0';
+        }
+    });
+}
+#else
+void WebDashboard::addPostRoute(const RouteEntry& entry) {
+    // WebServer keeps the body itself (the "plain" argument)
+    const RouteEntry* route = &entry;
+    uint8_t slot = routeSlot(entry.path);
+    _server->on(entry.path, HTTP_POST, [this, route, slot]() {
+        DashboardRequest request(_server, _txBuffer, sizeof(_txBuffer));
+        serve(request, *route, slot);
+    });
+}
+#endif
+
+bool WebDashboard::dispatch(const DashboardCommand& command) {
+    if (_commandQueue) {
+        if (xQueueSend(_commandQueue, &command, 0) != pdTRUE) {
+#if WEBDASHBOARD_METRICS
+            _metrics.commandDropped();
+#endif
+            return false;
+        }
+        if (_scheduler) {
+            _scheduler->wake(_schedulerTask);   // Run it from loop() now
+        }
+        return true;
+    }
+    execute(command);
+    return true;
+}
+
+void WebDashboard::execute(const DashboardCommand& command) {
+#if WEBDASHBOARD_METRICS
+    uint32_t start = DashboardMetrics::cycles();
+#endif
+
+    switch (command.type) {
+        case CMD_OUTPUT:
+            runOutput(command.channel, command.ordinal, command.state);
+            break;
+        case CMD_MODE:
+            if (_modeCallback) _modeCallback(command.mode);
+            break;
+        case CMD_RESET:
+            if (_resetCallback) _resetCallback();
+            if (_params) _params->flush();  // Nothing waiting is lost
+            if (_log) _log->sync();
+            // Keep serving until the response has gone out
+            if (!defer(restartDevice, DASHBOARD_RESTART_DELAY)) restartDevice();
+            break;
+        case CMD_CUSTOM:
+            if (_customCallback) _customCallback();
+            break;
+        case CMD_CONTROL: {
+            // Mode first: output callbacks may depend on it
+            if (command.mode[0] && _modeCallback) _modeCallback(command.mode);
+
+            DashboardState state;
+            _state.read(state);
+            uint8_t ordinal = 0;
+            for (uint8_t id = 0; id < state.count; id++) {
+                if (!(state.channels[id].flags & CHANNEL_OUTPUT)) continue;
+                if (command.outputs & (1UL << id)) {
+                    runOutput(id, ordinal, (command.states & (1UL << id)) != 0);
+                }
+                ordinal++;
+            }
+            break;
+        }
+    }
+
+#if WEBDASHBOARD_METRICS
+    _metrics.recordCommand(command.type, start);
+#endif
+}
+
+void WebDashboard::runOutput(uint8_t channel, uint8_t ordinal, bool state) {
+    if (_outputCallback) _outputCallback(channel, state);
+#if WEBDASHBOARD_LEGACY
+    if (ordinal == 0 && _output1Callback) _output1Callback(state);
+    if (ordinal == 1 && _output2Callback) _output2Callback(state);
+#endif
+}
+
+bool WebDashboard::hasOutputCallback(uint8_t ordinal) {
+#if WEBDASHBOARD_LEGACY
+    return _outputCallback
+        || (ordinal == 0 && _output1Callback)
+        || (ordinal == 1 && _output2Callback);
+#else
+    return _outputCallback != nullptr;
+#endif
+}
+
+// Position of a channel among the output channels (CHANNEL_INVALID if
+// it is not an output), and the reverse lookup
+static uint8_t outputOrdinal(const DashboardState& state, uint8_t channel) {
+    uint8_t ordinal = 0;
+    for (uint8_t id = 0; id < state.count; id++) {
+        if (!(state.channels[id].flags & CHANNEL_OUTPUT)) continue;
+        if (id == channel) return ordinal;
+        ordinal++;
+    }
+    return CHANNEL_INVALID;
+}
+
+#if WEBDASHBOARD_LEGACY
+static uint8_t outputChannel(const DashboardState& state, uint8_t ordinal) {
+    for (uint8_t id = 0; id < state.count; id++) {
+        if ((state.channels[id].flags & CHANNEL_OUTPUT) && ordinal-- == 0) return id;
+    }
+    return CHANNEL_INVALID;
+}
+#endif
+
+// ==================== PRIVATE HANDLERS ====================
+
+void WebDashboard::handleRoot(DashboardRequest& request) {
+    DashboardBoot::mark(BOOT_FIRST_PAGE);   // A 304 counts: the browser has it
+
+    // The ETag changes whenever the page is rebuilt; browsers revalidate
+    // (no-cache) and get an empty 304 while their copy is current
+    request.sendHeader("ETag", DASHBOARD_PAGE_ETAG);
+    request.sendHeader("Cache-Control", "no-cache");
+
+    if (request.header("If-None-Match") == DASHBOARD_PAGE_ETAG) {
+        request.send(304, "text/html", "");
+        return;
+    }
+
+    request.sendHeader("Content-Encoding", "gzip");
+    request.send_P(200, "text/html", DASHBOARD_PAGE_GZ, DASHBOARD_PAGE_GZ_LEN);
+}
+
+void WebDashboard::handleStatus(DashboardRequest& request) {
+    if (sendCached(request, _statusCache, _statusJson)) {
+        return;
+    }
+
+    // Latest complete snapshot; publish() may run on another core
+    DashboardState state;
+    uint32_t version = _state.read(state);
+
+    StaticJsonDocument<DASHBOARD_STATUS_DOC> doc;
+    buildStatus(doc, state);
+
+    sendFresh(request, doc, _statusCache, _statusJson, sizeof(_statusJson), version);
+}
+
+void WebDashboard::handleMeta(DashboardRequest& request) {
+    DashboardState state;
+    _state.read(state);
+
+    // Revalidated by ETag: unchanged metadata costs an empty 304
+    char etag[24];
+    snprintf(etag, sizeof(etag), "\"%08lx-%lu\"", (unsigned long)_bootId,
+             (unsigned long)state.metaVersion);
+    request.sendHeader("ETag", etag);
+    request.sendHeader("Cache-Control", "no-cache");
+
+    if (request.header("If-None-Match") == etag) {
+        request.send(304, "application/json", "");
+        return;
+    }
+
+    StaticJsonDocument<DASHBOARD_META_DOC> doc;
+    buildMeta(doc, state);
+
+    request.sendJson(200, doc);
+}
+
+void WebDashboard::handleValues(DashboardRequest& request) {
+    if (sendCached(request, _valuesCache, _valuesJson)) {
+        return;
+    }
+
+    DashboardState state;
+    uint32_t version = _state.read(state);
+
+    StaticJsonDocument<DASHBOARD_VALUES_DOC> doc;
+    buildValues(doc, state);
+
+    sendFresh(request, doc, _valuesCache, _valuesJson, sizeof(_valuesJson), version);
+}
+
+// Polls close together (several tabs, a refresh after each button) get
+// the JSON built for an earlier one while it is recent, or while nothing
+// was published since. Only JSON is kept; MessagePack is built each time.
+bool WebDashboard::sendCached(DashboardRequest& request, const CachedJson& cache, const char* json) {
+    if (cache.length == 0 || request.wantsMsgPack()
+        || (millis() - cache.at >= DASHBOARD_STATUS_CACHE_MS && _state.version() != cache.version)) {
+        return false;
+    }
+    _cacheHits = _cacheHits + 1;
+    request.sendHeader("Vary", "Accept");   // As sendDocument(): JSON or MessagePack
+    request.send(200, "application/json", json);
+    return true;
+}
+
+void WebDashboard::sendFresh(DashboardRequest& request, const JsonDocument& doc, CachedJson& cache,
+                             char* json, size_t size, uint32_t version) {
+    if (DASHBOARD_STATUS_CACHE_MS > 0 && !request.wantsMsgPack()) {
+        size_t length = serializeJson(doc, json, size);
+        if (length < size - 1) {
+            cache.length = length;
+            cache.at = millis();
+            cache.version = version;
+            request.sendHeader("Vary", "Accept");
+            request.send(200, "application/json", json);
+            return;
+        }
+        cache.length = 0;           // Too big to keep
+    }
+    request.sendDocument(200, doc);
+}
+
+// /api/output?ch=<id>&state=0|1
+void WebDashboard::handleOutput(DashboardRequest& request) {
+    DashboardState state;
+    _state.read(state);
+
+    uint8_t channel = CHANNEL_INVALID;
+    if (request.hasArg("ch")) {
+        long id = request.arg("ch").toInt();
+        if (id >= 0 && id < state.count) channel = (uint8_t)id;
+    }
+    requestOutput(request, state, channel);
+}
+
+
+#if WEBDASHBOARD_LEGACY
+// Original routes /api/output1 and /api/output2: the N-th output channel
+template <uint8_t Ordinal>
+void WebDashboard::handleOutputN(DashboardRequest& request) {
+    DashboardState state;
+    _state.read(state);
+    requestOutput(request, state, outputChannel(state, Ordinal));
+}
+#endif
+
+void WebDashboard::requestOutput(DashboardRequest& request, const DashboardState& state,
+                                 uint8_t channel) {
+    uint8_t ordinal = outputOrdinal(state, channel);
+    if (request.hasArg("state") && ordinal != CHANNEL_INVALID && hasOutputCallback(ordinal)) {
+        DashboardCommand command = {};
+        command.type = CMD_OUTPUT;
+        command.channel = channel;
+        command.ordinal = ordinal;
+        command.state = request.arg("state") == "1";
+        sendCommandResult(request, dispatch(command));
     } else {
-        _server->send(400, "application/json", "{\"error\":\"Invalid request\"}");
+        request.send(400, "application/json", "{\"error\":\"Invalid request\"}");
     }
 }
 
-void WebDashboard::handleOutput2() {
-    if (_server->hasArg("state") && _output2Callback) {
-        bool state = _server->arg("state") == "1";
-        _output2Callback(state);
+// POST /api/control {"outputs":{"<id>":0|1,...},"mode":"..."}, both keys
+// optional. All or nothing: one invalid entry rejects the whole batch.
+// Answers with the /api/values of the state the batch asked for; the
+// application may still refuse a change, the push stream then corrects it.
+void WebDashboard::handleControl(DashboardRequest& request) {
+    DashboardState state;
+    _state.read(state);
+
+    StaticJsonDocument<DASHBOARD_CONTROL_DOC> body;
+    DashboardCommand command = {};
+    command.type = CMD_CONTROL;
+    bool valid = request.readJson(body);
+
+    JsonObject outputs = body["outputs"];
+    for (JsonPair entry : outputs) {
+        char* end;
+        unsigned long id = strtoul(entry.key().c_str(), &end, 10);
+        uint8_t ordinal = id < state.count ? outputOrdinal(state, (uint8_t)id) : CHANNEL_INVALID;
+        if (end == entry.key().c_str() || *end || ordinal == CHANNEL_INVALID
+            || !hasOutputCallback(ordinal)) {
+            valid = false;
+            break;
+        }
+        command.outputs |= 1UL << id;
+        if (entry.value().as<bool>()) command.states |= 1UL << id;
+    }
+
+    const char* mode = body["mode"];
+    if (mode) {
+        if (!*mode || !_modeCallback) valid = false;
+        strlcpy(command.mode, mode, sizeof(command.mode));
+    }
+
+    if (!valid || (!command.outputs && !command.mode[0])) {
+        request.send(400, "application/json", "{\"error\":\"Invalid request\"}");
+        return;
+    }
+    if (!dispatch(command)) {
+        sendCommandResult(request, false);
+        return;
+    }
+
+    for (uint8_t id = 0; id < state.count; id++) {
+        if (command.outputs & (1UL << id)) {
+            state.channels[id].value = (command.states & (1UL << id)) ? 1 : 0;
+        }
+    }
+    if (command.mode[0]) {
+        strlcpy(state.mode, command.mode, sizeof(state.mode));
+    }
 
-        StaticJsonDocument<64> doc;
-        doc["success"] = true;
-        String response;
-        serializeJson(doc, response);
-        _server->send(200, "application/json", response);
+    StaticJsonDocument<DASHBOARD_VALUES_DOC> doc;
+    buildValues(doc, state);
+    request.sendDocument(200, doc);
+}
+
+void WebDashboard::handleMode(DashboardRequest& request) {
+    if (request.hasArg("mode") && _modeCallback) {
+        DashboardCommand command = {};
+        command.type = CMD_MODE;
+        strlcpy(command.mode, request.arg("mode").c_str(), sizeof(command.mode));
+        sendCommandResult(request, dispatch(command));
     } else {
-        _server->send(400, "application/json", "{\"error\":\"Invalid request\"}");
+        request.send(400, "application/json", "{\"error\":\"Invalid request\"}");
+    }
+}
+
+void WebDashboard::handleReset(DashboardRequest& request) {
+    DashboardCommand command = {};
+    command.type = CMD_RESET;
+    sendCommandResult(request, dispatch(command));
+}
+
+void WebDashboard::handleCustom(DashboardRequest& request) {
+    DashboardCommand command = {};
+    command.type = CMD_CUSTOM;
+    if (!dispatch(command)) {
+        sendCommandResult(request, false);
+        return;
+    }
+
+    request.send(200, "application/json", _commandQueue
+        ? "{\"success\":true,\"message\":\"Custom action queued\"}"
+        : "{\"success\":true,\"message\":\"Custom action completed\"}");
+}
+
+#if WEBDASHBOARD_METRICS
+// Prometheus text format, streamed: it is larger than _txBuffer
+void WebDashboard::handleMetrics(DashboardRequest& request) {
+    MetricsCursor cursor = _metrics.cursor();
+    cursor.gauges[GAUGE_STREAMS] = _events.count();
+    cursor.gauges[GAUGE_SCHEDULER_OVERRUNS] = _scheduler ? _scheduler->overruns() : 0;
+    cursor.gauges[GAUGE_STA_CONNECTED] = _station.connected();
+    cursor.gauges[GAUGE_STA_RECONNECTS] = _station.reconnects();
+    cursor.gauges[GAUGE_PARAM_WRITES] = _params ? _params->writes() : 0;
+    cursor.gauges[GAUGE_LOG_DROPPED] = _log ? _log->dropped() : 0;
+    cursor.gauges[GAUGE_SENSOR_READS] = _sensors ? _sensors->totalReads() : 0;
+    cursor.gauges[GAUGE_SENSOR_FAILURES] = _sensors ? _sensors->totalFailures() : 0;
+    cursor.gauges[GAUGE_RULE_TRIPS] = _rules ? _rules->trips() : 0;
+    cursor.gauges[GAUGE_REQUESTS_LIMITED] = _admission.limited();
+    cursor.gauges[GAUGE_REQUESTS_BUSY] = _admission.busy();
+    cursor.gauges[GAUGE_RESPONSES_CACHED] = _cacheHits;
+    request.sendChunked(200, "text/plain; version=0.0.4", DashboardMetrics::fill, cursor);
+}
+#endif
+
+// Every peer with its last /api/values body, see DashboardFleet.h
+void WebDashboard::handleFleet(DashboardRequest& request) {
+    FleetCursor cursor;
+    cursor.fleet = _fleet;
+    cursor.part = 0;
+    cursor.index = 0;
+    cursor.length = 0;
+    cursor.offset = 0;
+    request.sendChunked(200, "application/json", FleetBase::fill, cursor);
+}
+
+void WebDashboard::handleParams(DashboardRequest& request) {
+    StaticJsonDocument<DASHBOARD_PARAMS_DOC> doc;
+    _params->build(doc);
+    request.sendDocument(200, doc);
+}
+
+// POST /api/params {"<key>":value,...}. All or nothing, like
+// /api/control; applied by the next loop() and saved with the next flush.
+// Answers with the listing as it will be.
+void WebDashboard::handleParamsUpdate(DashboardRequest& request) {
+    StaticJsonDocument<DASHBOARD_PARAMS_DOC> body;
+    if (!request.readJson(body) || !_params->stage(body.as<JsonObjectConst>())) {
+        request.send(400, "application/json", "{\"error\":\"Invalid request\"}");
+        return;
+    }
+    if (_scheduler) {
+        _scheduler->wake(_schedulerTask);
     }
+    handleParams(request);
 }
 
-void WebDashboard::handleMode() {
-    if (_server->hasArg("mode") && _modeCallback) {
-        String mode = _server->arg("mode");
-        _modeCallback(mode.c_str());
+void WebDashboard::handleRules(DashboardRequest& request) {
+    StaticJsonDocument<DASHBOARD_RULES_DOC> doc;
+    _rules->build(doc);
+    request.sendDocument(200, doc);
+}
+
+// POST /api/rules {"<index>":{"threshold":..,...}}. All or nothing;
+// applied by the next publish(). Answers with the listing as it will be.
+void WebDashboard::handleRulesUpdate(DashboardRequest& request) {
+    StaticJsonDocument<DASHBOARD_RULES_DOC> body;
+    if (!request.readJson(body) || !_rules->stage(body.as<JsonObjectConst>())) {
+        request.send(400, "application/json", "{\"error\":\"Invalid request\"}");
+        return;
+    }
+    handleRules(request);
+}
+
+#if !WEBDASHBOARD_ASYNC
+void WebDashboard::handleEvents(DashboardRequest& request) {
+    // The socket stays open; WebServer sends nothing for this request
+    if (!_events.accept(request.client())) {
+        request.send(503, "application/json", "{\"error\":\"Too many streams\"}");
+    }
+}
+#endif
+
+void WebDashboard::sendCommandResult(DashboardRequest& request, bool accepted) {
+    if (!accepted) {
+        // Async/task mode only: loop() has not drained the command queue
+        request.send(503, "application/json", "{\"error\":\"Busy\"}");
+        return;
+    }
+
+    request.send(200, "application/json", "{\"success\":true}");
+}
+
+// ==================== HISTORY ====================
+
+// Position in a streamed /api/history response
+struct HistoryCursor {
+    const HistoryBase* history;
+    const RollupBase* rollup;   // nullptr = raw samples
+    uint8_t channel;
+    uint8_t tier;
+    uint8_t part;               // 0 = head, 1 = samples, 2 = tail, 3 = done
+    uint32_t period;
+    uint32_t start;             // Time of the first sample
+    uint32_t first;
+    uint32_t next;
+    uint32_t end;
+};
 
-        StaticJsonDocument<64> doc;
-        doc["success"] = true;
-        String response;
-        serializeJson(doc, response);
-        _server->send(200, "application/json", response);
+// Longest sample as text; stop filling a buffer with less room left
+#define HISTORY_SAMPLE_TEXT 80
+
+static size_t formatSample(const HistoryCursor& cursor, char* out, size_t size) {
+    const char* comma = cursor.next != cursor.first ? "," : "";
+
+    // Overwritten samples stay in place as null, so the implicit
+    // timestamps (t + i * dt) remain valid
+    if (!cursor.rollup) {
+        float value;
+        if (cursor.history->read(cursor.channel, cursor.next, value) && !isnan(value)) {
+            return snprintf(out, size, "%s%.6g", comma, value);
+        }
     } else {
-        _server->send(400, "application/json", "{\"error\":\"Invalid request\"}");
+        RollupSample sample;
+        if (cursor.rollup->read(cursor.channel, cursor.next, sample) && sample.count > 0) {
+            return snprintf(out, size, "%s[%.6g,%.6g,%.6g,%lu]", comma, sample.avg(),
+                            sample.min, sample.max, (unsigned long)sample.count);
+        }
     }
+    return snprintf(out, size, "%snull", comma);
 }
 
-void WebDashboard::handleReset() {
-    if (_resetCallback) {
-        _resetCallback();
+static size_t fillHistory(HistoryCursor& cursor, char* buffer, size_t size) {
+    if (size < HISTORY_SAMPLE_TEXT + 2) {
+        return 0;
+    }
+
+    size_t length = 0;
+    if (cursor.part == 0) {
+        int n = snprintf(buffer, size,
+                         "{\"ch\":%u,\"tier\":%u,\"dt\":%lu,\"first\":%lu,\"t\":%lu,\"v\":[",
+                         (unsigned)cursor.channel, (unsigned)cursor.tier,
+                         (unsigned long)cursor.period, (unsigned long)cursor.first,
+                         (unsigned long)cursor.start);
+        if (n <= 0 || (size_t)n >= size) {
+            return 0;
+        }
+        length = n;
+        cursor.part = 1;
     }
 
-    StaticJsonDocument<64> doc;
-    doc["success"] = true;
-    String response;
-    serializeJson(doc, response);
-    _server->send(200, "application/json", response);
+    while (cursor.part == 1 && cursor.next != cursor.end
+           && size - length > HISTORY_SAMPLE_TEXT) {
+        length += formatSample(cursor, buffer + length, size - length);
+        cursor.next++;
+    }
+    if (cursor.part == 1 && cursor.next == cursor.end) {
+        cursor.part = 2;
+    }
 
-    delay(1000);
-    ESP.restart();
+    if (cursor.part == 2 && size - length > HISTORY_SAMPLE_TEXT) {
+        length += snprintf(buffer + length, size - length, "],\"next\":%lu}",
+                           (unsigned long)cursor.end);
+        cursor.part = 3;
+    }
+    return length;
+}
+
+// /api/history?ch=<id>[&tier=<n>][&since=<sample>][&last=<seconds>]
+//   tier 0 = raw samples, 1.. = rollup tiers as [avg,min,max,count]
+//   since: first sample/bucket number (default: the oldest stored)
+//   last:  only the last N seconds; without tier, picks the finest
+//          tier that still covers them
+// The response ends with "next", the since value for the next request.
+void WebDashboard::handleHistory(DashboardRequest& request) {
+    bool useLog = _log && _log->started();
+    if (!_history && !useLog) {
+        request.send(404, "application/json", "{\"error\":\"No history\"}");
+        return;
+    }
+
+    long channel = request.hasArg("ch") ? request.arg("ch").toInt() : -1;
+    uint32_t last = request.hasArg("last") ? strtoul(request.arg("last").c_str(), nullptr, 10) : 0;
+    if (channel < 0) {
+        request.send(400, "application/json", "{\"error\":\"Invalid request\"}");
+        return;
+    }
+    if (useLog && (!_history || request.arg("tier") == "log"
+                   || ((request.hasArg("from") || request.hasArg("to")) && !request.hasArg("tier")))) {
+        sendLogHistory(request, channel, last);
+        return;
+    }
+    if (!_history) {
+        request.send(400, "application/json", "{\"error\":\"Invalid request\"}");
+        return;
+    }
+
+    long tier = request.hasArg("tier") ? request.arg("tier").toInt() : 0;
+    uint8_t tiers = _history->tiers();
+    if (channel >= _history->channels() || tier < 0 || tier > tiers) {
+        request.send(400, "application/json", "{\"error\":\"Invalid request\"}");
+        return;
+    }
+
+    if (last > 0 && !request.hasArg("tier")) {
+        // Finest tier whose ring spans the requested time; older than
+        // the coarsest one comes from the log
+        uint64_t span = (uint64_t)last * 1000;
+        while (tier <= tiers) {
+            uint64_t covered = tier == 0
+                ? (uint64_t)_history->depth() * _history->period()
+                : (uint64_t)_history->tier(tier)->depth() * _history->tier(tier)->period();
+            if (covered >= span) break;
+            tier++;
+        }
+        if (tier > tiers) {
+            if (useLog) {
+                sendLogHistory(request, channel, last);
+                return;
+            }
+            tier = tiers;
+        }
+    }
+
+    HistoryCursor cursor = {};
+    cursor.history = _history;
+    cursor.rollup = tier > 0 ? _history->tier(tier) : nullptr;
+    cursor.channel = (uint8_t)channel;
+    cursor.tier = (uint8_t)tier;
+    if (cursor.rollup) {
+        if (channel >= cursor.rollup->channels()) {
+            request.send(400, "application/json", "{\"error\":\"Invalid request\"}");
+            return;
+        }
+        cursor.period = cursor.rollup->period();
+        cursor.end = cursor.rollup->end();
+        cursor.first = cursor.rollup->first();
+    } else {
+        cursor.period = _history->period();
+        cursor.end = _history->end();
+        cursor.first = _history->first();
+    }
+
+    if (last > 0) {
+        uint32_t count = (uint32_t)(((uint64_t)last * 1000 + cursor.period - 1) / cursor.period);
+        if (cursor.end - cursor.first > count) cursor.first = cursor.end - count;
+    }
+    if (request.hasArg("since")) {
+        uint32_t since = strtoul(request.arg("since").c_str(), nullptr, 10);
+        if (since > cursor.end) since = cursor.end;
+        if (since > cursor.first) cursor.first = since;
+    }
+    cursor.next = cursor.first;
+    cursor.start = cursor.rollup ? cursor.rollup->timeOf(cursor.first)
+                                 : _history->timeOf(cursor.first);
+
+    request.sendChunked(200, "application/json", fillHistory, cursor);
 }
 
-void WebDashboard::handleCustom() {
-    if (_customCallback) {
-        _customCallback();
+// /api/history from the flash log: from/to in seconds (Unix time once
+// the clock is set, see DashboardLog.h), or the 'last' seconds, after
+// seq 'since', at most 'limit' records
+void WebDashboard::sendLogHistory(DashboardRequest& request, long channel, uint32_t last) {
+    if (channel >= _log->channels()) {
+        request.send(400, "application/json", "{\"error\":\"Invalid request\"}");
+        return;
+    }
+
+    uint64_t from = 0;
+    uint64_t to = UINT64_MAX;
+    if (request.hasArg("from")) {
+        from = (uint64_t)strtoull(request.arg("from").c_str(), nullptr, 10) * 1000;
+    } else if (last > 0) {
+        uint64_t newest = _log->lastTime();
+        uint64_t span = (uint64_t)last * 1000;
+        from = newest > span ? newest - span : 0;
+    }
+    if (request.hasArg("to")) {
+        to = (uint64_t)strtoull(request.arg("to").c_str(), nullptr, 10) * 1000;
     }
+    uint32_t since = request.hasArg("since") ? strtoul(request.arg("since").c_str(), nullptr, 10) : 0;
+    uint32_t limit = request.hasArg("limit") ? strtoul(request.arg("limit").c_str(), nullptr, 10) : 0;
 
-    StaticJsonDocument<128> doc;
-    doc["success"] = true;
-    doc["message"] = "Custom action completed";
-    String response;
-    serializeJson(doc, response);
-    _server->send(200, "application/json", response);
+    LogCursor cursor;
+    if (!_log->open(cursor, (uint8_t)channel, since, from, to, limit)) {
+        request.send(503, "application/json", "{\"error\":\"Log unavailable\"}");
+        return;
+    }
+    request.sendChunked(200, "application/json", DashboardLog::fill, cursor);
 }
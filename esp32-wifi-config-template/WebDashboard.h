@@ -6,21 +6,138 @@
  *
  * Usage:
  *   1. Include this header in your main .ino file
- *   2. Create DashboardData struct with your sensor values
+ *   2. Declare a ChannelTable with your sensors and outputs
+ *      (DashboardChannels.h) and pass it to setChannels()
  *   3. Create WebDashboard instance
  *   4. Set callback functions for button actions
  *   5. Call begin() in setup(), loop() in loop()
+ *
+ * The older SensorData/OutputStates structs still work: publish() with
+ * them fills a built-in 5-channel table (ids 0-2 = value1..value3,
+ * ids 3-4 = output1..output2). Sketches that only use channel tables
+ * can build with -DWEBDASHBOARD_LEGACY=0, which drops that table, its
+ * API and the /api/output1, /api/output2 routes.
+ *
+ * Server backends (see DashboardRequest.h):
+ *   - Default: synchronous WebServer, serviced by loop()
+ *   - WEBDASHBOARD_ASYNC=1: ESPAsyncWebServer, serviced by the AsyncTCP
+ *     task. Button callbacks are queued and still run from loop(), so
+ *     application code never runs on the network task.
+ *   - useServerTask(): WebServer serviced by a dedicated FreeRTOS task
+ *     (core 0 by default). Callbacks are queued for loop() as above.
+ *
+ * Data handoff: call publish() (or the update*() setters) from ONE task.
+ * The state is copied into a lock-free snapshot (DashboardSnapshot.h),
+ * so the server always reads a complete, consistent copy without taking
+ * a lock, whichever task or core it runs on. Labels, units and names
+ * are stored as pointers and must point to strings that stay valid
+ * (string literals); the mode string is copied.
+ *
+ * Protocol: static metadata (channel labels, units, flags, name,
+ * version) is served once by /api/meta; /api/values carries only the
+ * channel values (indexed by channel id) plus "mv", the metadata
+ * version, so clients know when to fetch /api/meta again. /api/status
+ * still returns everything in the original sensors/outputs layout.
+ * Both answer in MessagePack instead of JSON for ?fmt=bin or
+ * Accept: application/msgpack.
+ *
+ * Batches: POST /api/control applies several outputs and the mode as
+ * one command (nothing runs in between) and answers with the resulting
+ * values, so a scene costs one round-trip.
+ *
+ * Deferred actions: defer() runs a function from loop() after a delay,
+ * so callbacks never block a request. A long action (blinking an LED,
+ * a restart after the response went out) becomes a chain of short
+ * steps that each defer() the next one.
+ *
+ * Scheduling: attach() runs loop() as a task of a DashboardScheduler
+ * instead of calling it yourself. The scheduler sleeps between
+ * deadlines and is woken as soon as a command is queued or a deferred
+ * action is due.
+ *
+ * Startup: begin() brings up WiFi, the log and the server before it
+ * returns. With config.deferStart it returns at once instead and a
+ * startup task does that while the sketch already runs its control;
+ * until started() is true there is no AP, no server and getIP() is
+ * 0.0.0.0. The boot stages are timed (DashboardBoot.h) and shown in
+ * /api/metrics.
+ *
+ * Radio: begin(DashboardConfig) sets the soft-AP channel, station cap,
+ * beacon interval and TX power; its refreshInterval reaches the page
+ * through /api/meta, so the poll period needs no page rebuild.
+ *
+ * Networks: the config's wifiMode can also join the plant WiFi (STA or
+ * AP+STA, DashboardStation.h); the connect and every reconnect happen
+ * off loop(). Every board advertises itself over mDNS, and a board
+ * given setFleet() polls the others and serves them all at /api/fleet
+ * (DashboardFleet.h).
+ *
+ * MQTT: with -DWEBDASHBOARD_MQTT=1, setMqtt() pushes what publish()
+ * changed to a broker in batches, from its own task (DashboardMqtt.h).
+ *
+ * Settings: setParams() attaches a ParamTable (DashboardParams.h) whose
+ * values are restored from NVS, written back in coalesced batches and,
+ * where editable, listed by GET and changed by POST /api/params.
+ *
+ * Sensors: a SensorTable (DashboardSensors.h) reads DHT, I2C and other
+ * drivers without blocking loop(); setSensors() reports its read and
+ * failure counts in /api/metrics.
+ *
+ * Auto mode: setRules() attaches a RuleTable (DashboardRules.h) that
+ * publish() evaluates when an input changes; GET and POST /api/rules
+ * list and edit it.
+ *
+ * Power: setPowerMode(POWER_SAVE) scales the CPU clock down while idle
+ * and enables light/modem sleep where the build and WiFi mode allow it
+ * (DashboardPower.h); the soft-AP stays up.
+ *
+ * Metrics: /api/metrics reports latency histograms per route and per
+ * callback, loop timing and heap figures in Prometheus text format
+ * (DashboardMetrics.h; -DWEBDASHBOARD_METRICS=0 removes it).
+ *
+ * History: setHistory() attaches a DashboardHistory that records the
+ * channels on every publish; /api/history streams it in chunks.
+ * setLog() adds a DashboardLog that keeps days of them on LittleFS,
+ * read with /api/history?tier=log.
+ *
+ * Live updates: the page subscribes to /api/events (Server-Sent Events)
+ * and only receives the values that changed since the last push, at
+ * most every DASHBOARD_EVENT_INTERVAL ms. It falls back to polling
+ * /api/values if the stream is unavailable.
  */
 
 #ifndef WEB_DASHBOARD_H
 #define WEB_DASHBOARD_H
 
 #include <WiFi.h>
-#include <WebServer.h>
 #include <ArduinoJson.h>
+#include "DashboardRequest.h"
+#include "DashboardChannels.h"
+#include "DashboardHistory.h"
+#include "DashboardLog.h"
+#include "DashboardScheduler.h"
+#include "DashboardPower.h"
+#include "DashboardSnapshot.h"
+#include "DashboardEvents.h"
+#include "DashboardMetrics.h"
+#include "DashboardStation.h"
+#include "DashboardFleet.h"
+#include "DashboardMqtt.h"
+#include "DashboardParams.h"
+#include "DashboardSensors.h"
+#include "DashboardDht.h"
+#include "DashboardRules.h"
+#include "DashboardAdmission.h"
+#include "DashboardBoot.h"
+
+// SensorData/OutputStates API and its fixed 5-channel layout
+#ifndef WEBDASHBOARD_LEGACY
+#define WEBDASHBOARD_LEGACY 1
+#endif
 
 // ==================== DATA STRUCTURES ====================
 
+#if WEBDASHBOARD_LEGACY
 // Sensor/input data to display on dashboard
 struct SensorData {
     float value1;           // Generic sensor value 1
@@ -46,6 +163,7 @@ struct OutputStates {
     bool showOutput1;       // Show/hide output1 controls
     bool showOutput2;       // Show/hide output2 controls
 };
+#endif
 
 // System information
 struct SystemInfo {
@@ -55,13 +173,124 @@ struct SystemInfo {
     unsigned long uptime;       // Uptime in seconds
 };
 
+// Soft-AP and page settings applied by begin(DashboardConfig). The
+// defaults match config.h.example; override them per deployment with
+// build flags (e.g. -DDASHBOARD_WIFI_CHANNEL=6) or set the fields.
+#ifndef DASHBOARD_WIFI_CHANNEL
+#define DASHBOARD_WIFI_CHANNEL 1         // 1-13
+#endif
+#ifndef DASHBOARD_MAX_CONNECTIONS
+#define DASHBOARD_MAX_CONNECTIONS 4      // Stations, 1-10
+#endif
+#ifndef DASHBOARD_BEACON_INTERVAL
+#define DASHBOARD_BEACON_INTERVAL 100    // Time units (1.024 ms), 100-60000
+#endif
+#ifndef DASHBOARD_TX_POWER
+#define DASHBOARD_TX_POWER WIFI_POWER_19_5dBm
+#endif
+#ifndef DASHBOARD_REFRESH_INTERVAL
+#define DASHBOARD_REFRESH_INTERVAL 2000  // Page poll period (ms), sent in /api/meta
+#endif
+
+// Which interfaces begin() brings up. In DASHBOARD_AP_STA the radio has
+// one channel: once the station joins, the soft-AP moves to the channel
+// of the plant network.
+enum DashboardWifiMode : uint8_t {
+    DASHBOARD_AP,               // Soft-AP only, at 192.168.4.1
+    DASHBOARD_STA,              // Join staSsid only
+    DASHBOARD_AP_STA            // Both
+};
+
+#define DASHBOARD_HOSTNAME_LEN 32    // mDNS name incl. '\0'
+
+struct DashboardConfig {
+    DashboardWifiMode wifiMode = DASHBOARD_AP;
+    const char* staSsid = nullptr;      // Network to join (STA modes)
+    const char* staPassword = nullptr;
+    const char* hostname = nullptr;     // mDNS <hostname>.local; nullptr = "dashboard-<mac>"
+    uint8_t channel = DASHBOARD_WIFI_CHANNEL;
+    uint8_t maxConnections = DASHBOARD_MAX_CONNECTIONS;
+    uint16_t beaconInterval = DASHBOARD_BEACON_INTERVAL;
+    wifi_power_t txPower = DASHBOARD_TX_POWER;
+    bool hidden = false;                // Do not broadcast the SSID
+    uint16_t refreshInterval = DASHBOARD_REFRESH_INTERVAL;
+    bool deferStart = false;            // begin() returns before WiFi is up (see started())
+};
+
+#define DASHBOARD_MODE_LEN 16        // Max mode string length (incl. '\0')
+
+// Complete state as published to the server (internal copy)
+struct DashboardState {
+    DashboardChannel channels[WEBDASHBOARD_MAX_CHANNELS];
+    uint8_t count;              // Channels in use
+    SystemInfo system;          // system.mode is unused, see mode[]
+    char mode[DASHBOARD_MODE_LEN];
+    bool hasSystem;
+    uint32_t metaVersion;       // Bumped when labels/units/flags change
+};
+
 // ==================== CALLBACK FUNCTIONS ====================
 
 // Callback function types for button actions
 typedef void (*OutputCallback)(bool state);
+typedef void (*ChannelCallback)(uint8_t channel, bool state);
 typedef void (*ModeCallback)(const char* mode);
 typedef void (*ActionCallback)();
 
+// ==================== COMMAND QUEUE ====================
+
+// User actions received by a handler. In async and server-task mode
+// these are queued and executed from loop(); otherwise they are
+// executed immediately.
+enum DashboardCommandType : uint8_t {
+    CMD_OUTPUT,
+    CMD_MODE,
+    CMD_RESET,
+    CMD_CUSTOM,
+    CMD_CONTROL                 // Batch: mode (if set), then outputs
+};
+
+#define DASHBOARD_COMMAND_QUEUE 8    // Pending commands (async/task mode)
+#define DASHBOARD_EVENT_INTERVAL 50  // Min ms between pushed updates
+#define DASHBOARD_TX_BUFFER 2048     // Response buffer (headers + JSON body)
+#define DASHBOARD_DEFERRED_MAX 8     // Pending deferred actions
+#define DASHBOARD_POLL_INTERVAL 5    // ms between WebServer polls (attach())
+#define DASHBOARD_STARTUP_STACK 6144 // Startup task (WiFi, mDNS, server setup)
+#define DASHBOARD_POLL_INTERVAL_SAVE 50  // Same, in POWER_SAVE
+#define DASHBOARD_RESTART_DELAY 1000 // ms between /api/reset and the restart
+
+// JSON document sizes, scaled with the channel capacity
+#define DASHBOARD_STATUS_DOC (192 + WEBDASHBOARD_MAX_CHANNELS * 80)   // Keys are not copied
+#define DASHBOARD_META_DOC   (128 + WEBDASHBOARD_MAX_CHANNELS * 96)
+#define DASHBOARD_VALUES_DOC (96 + WEBDASHBOARD_MAX_CHANNELS * 24)
+#define DASHBOARD_CONTROL_DOC (96 + WEBDASHBOARD_MAX_CHANNELS * 24)
+
+// /api/status and /api/values JSON kept for polls that come close
+// together: reused for this long, and while nothing was published (0 = off)
+#ifndef DASHBOARD_STATUS_CACHE_MS
+#define DASHBOARD_STATUS_CACHE_MS 250   // ms
+#endif
+#define DASHBOARD_STATUS_CACHE_SIZE (128 + WEBDASHBOARD_MAX_CHANNELS * 96)
+#define DASHBOARD_VALUES_CACHE_SIZE (96 + WEBDASHBOARD_MAX_CHANNELS * 16)
+#define DASHBOARD_PARAMS_DOC (64 + WEBDASHBOARD_MAX_PARAMS * 112)
+
+// ==================== DEFERRED ACTIONS ====================
+
+struct DashboardDeferred {
+    ActionCallback action;      // nullptr = free slot
+    uint32_t due;               // millis() when it may run
+};
+
+struct DashboardCommand {
+    DashboardCommandType type;
+    uint8_t channel;            // CMD_OUTPUT: channel id
+    uint8_t ordinal;            // CMD_OUTPUT: index among the outputs
+    bool state;
+    char mode[DASHBOARD_MODE_LEN];  // CMD_CONTROL: empty = keep the mode
+    uint32_t outputs;           // CMD_CONTROL: bit n = set channel n
+    uint32_t states;            // CMD_CONTROL: bit n = its new state
+};
+
 // ==================== WEB DASHBOARD CLASS ====================
 
 class WebDashboard {
@@ -69,55 +298,282 @@ public:
     // Constructor
     WebDashboard(const char* ssid, const char* password);
 
-    // Initialize WiFi AP and web server
-    void begin();
+    // Serve HTTP from a dedicated FreeRTOS task (call before begin()).
+    // Not needed with WEBDASHBOARD_ASYNC, which already runs off loop().
+    void useServerTask(BaseType_t core = 0, UBaseType_t priority = 1,
+                       uint32_t stackSize = 8192);
+
+    // Bring up WiFi and the web server. With config.deferStart this
+    // happens on a startup task and begin() returns at once, so control
+    // starts before the radio is up (DashboardBoot.h)
+    void begin(const DashboardConfig& config = DashboardConfig());
+    bool started() const { return _started; }   // WiFi and server up
+    const DashboardConfig& config() const { return _config; }
 
     // Call this in loop() to handle web requests
+    // (async/task mode: runs queued button callbacks)
     void loop();
 
-    // Update data that will be displayed
+    // Or let a scheduler call loop() (call after begin())
+    void attach(DashboardScheduler& scheduler);
+
+    // Trade latency for current (see DashboardPower.h). Before started()
+    // the mode is only recorded; it is applied once WiFi is up.
+    void setPowerMode(DashboardPowerMode mode);
+    DashboardPowerMode powerMode() const { return _powerMode; }
+
+    // Channels shown on the dashboard (the table must outlive it)
+    void setChannels(ChannelTableBase& channels);
+
+    // Record channel history, served by /api/history (optional)
+    void setHistory(HistoryBase& history);
+
+    // Also keep it on flash, /api/history?tier=log (call before begin())
+    void setLog(DashboardLog& log);
+
+    // Commit a complete, consistent copy of the channels and system info
+    void publish(const SystemInfo& info);
+
+#if WEBDASHBOARD_LEGACY
+    // Legacy fixed layout: fills the built-in 5-channel table
+    void publish(const SensorData& sensors, const OutputStates& outputs,
+                 const SystemInfo& info);
+
+    // Update one part of the legacy state (each call publishes a new copy)
     void updateSensorData(SensorData* data);
     void updateOutputStates(OutputStates* states);
+#endif
     void updateSystemInfo(SystemInfo* info);
 
     // Set callback functions for user interactions
-    void onOutput1Change(OutputCallback callback);
-    void onOutput2Change(OutputCallback callback);
+    void onOutputChange(ChannelCallback callback);  // Any output channel
+#if WEBDASHBOARD_LEGACY
+    void onOutput1Change(OutputCallback callback);  // 1st output channel
+    void onOutput2Change(OutputCallback callback);  // 2nd output channel
+#endif
     void onModeChange(ModeCallback callback);
     void onReset(ActionCallback callback);
     void onCustomAction(ActionCallback callback);
 
-    // Get WiFi info
-    IPAddress getIP();
+    // Run action from loop() once delayMs have passed. Safe to call from
+    // any task, including callbacks; false if DASHBOARD_DEFERRED_MAX
+    // actions are already pending.
+    bool defer(ActionCallback action, uint32_t delayMs = 0);
+
+    // Aggregate the peers' values at /api/fleet (call before begin())
+    void setFleet(FleetBase& fleet);
+
+    // Persisted settings, served at /api/params (call before begin())
+    void setParams(ParamTableBase& params);
+
+    // Sensor read/failure counters for /api/metrics (optional)
+    void setSensors(SensorTableBase& sensors);
+
+    // Threshold rules run by publish(), edited at /api/rules (call before begin())
+    void setRules(RuleTableBase& rules);
+
+#if WEBDASHBOARD_MQTT
+    // Also push every publish to an MQTT broker (call before begin())
+    void setMqtt(DashboardMqtt& mqtt);
+#endif
+
+    // Get WiFi info: the station address once joined, else the soft-AP's
+    IPAddress getIP();          // 0.0.0.0 until started()
+    const char* hostname() const { return _started ? _hostname : ""; }
+    const DashboardStation& station() const { return _station; }
 
 private:
+    friend class DashboardBench;    // test/bench times the JSON builders
+
     // WiFi credentials
     const char* _ssid;
     const char* _password;
+    DashboardConfig _config;    // As applied by begin()
+    char _hostname[DASHBOARD_HOSTNAME_LEN];
+    DashboardStation _station;
+    void startWifi();
+    void startAccessPoint();
+    void startMdns();
+
+    // Aggregator role (optional)
+    FleetBase* _fleet;
+
+    // Persisted settings, serviced from loop() (optional)
+    ParamTableBase* _params;
+
+    // Non-blocking sensor reads, counted in /api/metrics (optional)
+    SensorTableBase* _sensors;
+
+    // Auto-mode rules, evaluated on publish() (optional)
+    RuleTableBase* _rules;
+
+#if WEBDASHBOARD_MQTT
+    DashboardMqtt* _mqtt;       // Fed on commit() (optional)
+#endif
 
     // Web server
-    WebServer* _server;
+    DashboardServer* _server;
+    volatile bool _started;     // start() done: the server may be used
+
+    // Preallocated response/event buffer, only used from the task that
+    // serves requests (never allocated per request)
+    char _txBuffer[DASHBOARD_TX_BUFFER];
+
+    // Commands waiting for loop() (async/task mode only)
+    QueueHandle_t _commandQueue;
+
+    // Deferred actions, shared between tasks under _deferLock
+    DashboardDeferred _deferred[DASHBOARD_DEFERRED_MAX];
+    portMUX_TYPE _deferLock;
+    void runDeferred();
+
+    // Scheduler running loop() (attach), woken for new work
+    DashboardScheduler* _scheduler;
+    int8_t _schedulerTask;
+    static void schedulerLoop(void* context);
+    uint32_t loopInterval();
+
+    DashboardPowerMode _powerMode;
+    void applyPowerMode();
+
+    // Dedicated server task (useServerTask)
+    bool _useTask;
+    BaseType_t _taskCore;
+    UBaseType_t _taskPriority;
+    uint32_t _taskStackSize;
+    TaskHandle_t _serverTask;
+#if !WEBDASHBOARD_ASYNC
+    static void serverTaskMain(void* arg);
+#endif
+
+    // Startup task: WiFi, log and server, then _started
+    static void startupTaskMain(void* arg);
+    void start();
+    void printBoot();           // Timeline, once the server listens
+
+    // Application state: _staged is only touched by the publishing
+    // task, _state is what the server reads
+    DashboardState _staged;
+    DashboardSnapshot<DashboardState> _state;
+    bool stageChannels();
+    void commit(bool changed);
+    bool setSystemInfo(const SystemInfo& info);
 
-    // Data pointers
-    SensorData* _sensorData;
-    OutputStates* _outputStates;
-    SystemInfo* _systemInfo;
+    // Channel table being published, and its metaVersion() when staged
+    ChannelTableBase* _channels;
+    ChannelTableBase* _stagedTable;
+    uint32_t _stagedTableMeta;
+
+    // Channel history, recorded on commit() (optional)
+    HistoryBase* _history;
+    DashboardLog* _log;
+
+#if WEBDASHBOARD_LEGACY
+    // Backs the legacy SensorData/OutputStates API
+    ChannelTable<5> _legacyChannels;
+    void stageLegacySensors(const SensorData& sensors);
+    void stageLegacyOutputs(const OutputStates& outputs);
+#endif
+    uint32_t _bootId;           // Makes /api/meta ETags unique per boot
+
+    // Push stream (/api/events): what the connected clients last got
+    DashboardEvents _events;
+    DashboardState _pushed;
+    uint32_t _pushedVersion;
+    unsigned long _lastEventCheck;
+    void serviceEvents();
+
+    // Admission control (DashboardAdmission.h)
+    DashboardAdmission _admission;
+#if WEBDASHBOARD_ASYNC
+    volatile uint8_t _inFlight; // Admitted requests whose socket is open
+#endif
+    bool admit(DashboardRequest& request, bool control);
+
+    // Last /api/status and /api/values JSON, reused by polls that come
+    // close together (DASHBOARD_STATUS_CACHE_MS)
+    struct CachedJson {
+        size_t length;          // 0 = empty
+        uint32_t at;            // millis() it was built
+        uint32_t version;       // Of the state it was built from
+    };
+    CachedJson _statusCache;
+    CachedJson _valuesCache;
+    char _statusJson[DASHBOARD_STATUS_CACHE_SIZE];
+    char _valuesJson[DASHBOARD_VALUES_CACHE_SIZE];
+    volatile uint32_t _cacheHits;
+    bool sendCached(DashboardRequest& request, const CachedJson& cache, const char* json);
+    void sendFresh(DashboardRequest& request, const JsonDocument& doc, CachedJson& cache,
+                   char* json, size_t size, uint32_t version);
+
+    // JSON builders shared by the endpoints and the push stream
+    void buildStatus(JsonDocument& doc, const DashboardState& state);
+    void buildMeta(JsonDocument& doc, const DashboardState& state);
+    void buildValues(JsonDocument& doc, const DashboardState& state);
+    bool buildUpdate(JsonDocument& doc, const DashboardState& now, const DashboardState& last);
 
     // Callbacks
+    ChannelCallback _outputCallback;
+#if WEBDASHBOARD_LEGACY
     OutputCallback _output1Callback;
     OutputCallback _output2Callback;
+#endif
     ModeCallback _modeCallback;
     ActionCallback _resetCallback;
     ActionCallback _customCallback;
 
+    // Route registration (works for both server backends). The routes
+    // are a constant table (ROUTES, in flash) that begin() walks; each
+    // server closure only holds this and its entry.
+    typedef void (WebDashboard::*RouteHandler)(DashboardRequest& request);
+    struct RouteEntry {
+        const char* path;
+        RouteHandler handler;
+        uint8_t flags;          // RouteFlags
+    };
+    static const RouteEntry ROUTES[];
+    bool routeWanted(uint8_t flags) const;
+    void addRoute(const RouteEntry& entry);
+    void addPostRoute(const RouteEntry& entry);     // With a JSON body
+    uint8_t routeSlot(const char* path);
+    void serve(DashboardRequest& request, const RouteEntry& entry, uint8_t route);
+
+#if WEBDASHBOARD_METRICS
+    DashboardMetrics _metrics;
+    void handleMetrics(DashboardRequest& request);
+#endif
+
+    // Run a user action now, or queue it for loop() in async/task mode
+    bool dispatch(const DashboardCommand& command);
+    void execute(const DashboardCommand& command);
+    bool hasOutputCallback(uint8_t ordinal);
+    void runOutput(uint8_t channel, uint8_t ordinal, bool state);
+
     // Web request handlers
-    void handleRoot();
-    void handleStatus();
-    void handleOutput1();
-    void handleOutput2();
-    void handleMode();
-    void handleReset();
-    void handleCustom();
+    void handleRoot(DashboardRequest& request);
+    void handleStatus(DashboardRequest& request);
+    void handleMeta(DashboardRequest& request);
+    void handleValues(DashboardRequest& request);
+    void handleHistory(DashboardRequest& request);
+    void sendLogHistory(DashboardRequest& request, long channel, uint32_t last);
+    void handleFleet(DashboardRequest& request);
+    void handleParams(DashboardRequest& request);
+    void handleParamsUpdate(DashboardRequest& request);
+    void handleRules(DashboardRequest& request);
+    void handleRulesUpdate(DashboardRequest& request);
+    void handleOutput(DashboardRequest& request);
+    void handleControl(DashboardRequest& request);
+#if WEBDASHBOARD_LEGACY
+    template <uint8_t Ordinal> void handleOutputN(DashboardRequest& request);
+#endif
+    void requestOutput(DashboardRequest& request, const DashboardState& state, uint8_t channel);
+    void handleMode(DashboardRequest& request);
+    void handleReset(DashboardRequest& request);
+    void handleCustom(DashboardRequest& request);
+#if !WEBDASHBOARD_ASYNC
+    void handleEvents(DashboardRequest& request);
+#endif
+    void sendCommandResult(DashboardRequest& request, bool accepted);
 
     // HTML page
     const char* getHTML();
@@ -6,7 +6,7 @@
  *
  * How to use:
  * 1. Define your sensor/GPIO pins
- * 2. Read sensors and update data structures
+ * 2. Declare your channels (sensors and outputs) and update their values
  * 3. Implement callback functions for button actions
  * 4. That's it! WebDashboard handles the rest.
  *
@@ -15,6 +15,7 @@
  */
 
 #include "WebDashboard.h"
+#include "DashboardAdc.h"
 
 // ==================== CONFIGURATION ====================
 
@@ -25,24 +26,64 @@ const char* WIFI_PASSWORD = "esp32pass";
 // GPIO Pin Definitions - Customize for your project!
 const int LED_PIN = 2;           // Built-in LED
 const int RELAY_PIN = 4;         // Relay or output
-const int SENSOR_PIN = 34;       // Analog sensor
+const int SENSOR_PIN = 34;       // Analog sensor (must be an ADC1 pin)
+
+// The relay always boots off; the rules or the user switch it on. Set to
+// true only if re-energising it after a crash or brown-out is safe.
+const bool RESTORE_RELAY = false;
 
 // ==================== GLOBAL VARIABLES ====================
 
 // Web Dashboard instance
 WebDashboard dashboard(WIFI_SSID, WIFI_PASSWORD);
 
-// Data structures for dashboard
-SensorData sensors;
-OutputStates outputs;
+// Runs the periodic work below (and the dashboard) from loop()
+DashboardScheduler scheduler;
+int8_t sensorTask;
+int8_t logicTask;
+int8_t dashboardTask;
+
+// Task periods (ms). In sleep mode everything slows down, and the sensor
+// period keeps doubling up to SLEEP_SENSOR_MAX while the reading is steady.
+const uint32_t SENSOR_INTERVAL = 500;
+const uint32_t UPDATE_INTERVAL = 100;
+const uint32_t SLEEP_UPDATE_INTERVAL = 1000;
+const uint32_t SLEEP_SENSOR_MAX = 8000;
+const int SENSOR_STEADY_BAND = 20;      // ADC counts
+uint32_t sensorInterval = SENSOR_INTERVAL;
+
+// Dashboard channels - add as many as you need (up to the table size)
+ChannelTable<8> channels;
+uint8_t chSensor;
+uint8_t chTemperature;
+uint8_t chHumidity;
+uint8_t chLED;
+uint8_t chRelay;
+
 SystemInfo systemInfo;
 
+// Samples SENSOR_PIN in the background and filters it (see DashboardAdc.h)
+DashboardAdc adc;
+int8_t adcSensor;
+
 // Application state
 String currentMode = "auto";
 bool ledState = false;
 bool relayState = false;
 int sensorValue = 0;
 
+// Auto mode: relay on above 2000 counts, off again below 1500. The rule
+// table switches it when the sensor channel changes; thresholds are
+// tunable from the dashboard (Settings card, /api/rules)
+RuleTable<4> rules;
+int8_t relayRule;
+
+// Saved in flash and restored at boot (see initializeParams())
+ParamTable<8> params;
+char savedMode[16] = "auto";
+uint8_t paramRelayOn;
+uint8_t paramRelayHyst;
+
 // ==================== CALLBACK FUNCTIONS ====================
 // These are called when user interacts with the dashboard
 
@@ -52,9 +93,6 @@ void onLEDChange(bool state) {
 
     ledState = state;
     digitalWrite(LED_PIN, state ? HIGH : LOW);
-
-    // Update output states
-    outputs.output1 = ledState;
 }
 
 void onRelayChange(bool state) {
@@ -65,24 +103,73 @@ void onRelayChange(bool state) {
     if (currentMode == "manual") {
         relayState = state;
         digitalWrite(RELAY_PIN, state ? HIGH : LOW);
-        outputs.output2 = relayState;
     } else {
         Serial.println("Relay control only available in manual mode");
     }
 }
 
+// Called for every output channel; route it to the right handler
+void onOutputChange(uint8_t channel, bool state) {
+    if (channel == chLED) {
+        onLEDChange(state);
+    } else if (channel == chRelay) {
+        onRelayChange(state);
+    }
+}
+
+// A rule switched an output: drive the pin (any mode; in manual mode only
+// the relay's safety limit, DASHBOARD_RELAY_MAX_ON_TIME, does this)
+void onRuleSwitch(uint8_t channel, bool state) {
+    if (channel == chRelay) {
+        relayState = state;
+        digitalWrite(RELAY_PIN, state ? HIGH : LOW);
+        Serial.printf("Auto: Relay turned %s\n", state ? "ON" : "OFF");
+    }
+}
+
 void onModeChange(const char* mode) {
     Serial.print("Mode changed to: ");
     Serial.println(mode);
 
     currentMode = String(mode);
     systemInfo.mode = currentMode.c_str();
+    strlcpy(savedMode, mode, sizeof(savedMode));
+    rules.setActive(currentMode == "auto");
 
-    // Implement mode-specific behavior here
-    if (currentMode == "sleep") {
-        // Enter low power mode
+    // Sleep mode: clock down / light sleep between tasks (the access
+    // point stays up) and run the periodic tasks less often
+    bool sleep = currentMode == "sleep";
+    if (sleep) {
         Serial.println("Entering sleep mode...");
     }
+    dashboard.setPowerMode(sleep ? POWER_SAVE : POWER_PERFORMANCE);
+
+    uint32_t updateInterval = sleep ? SLEEP_UPDATE_INTERVAL : UPDATE_INTERVAL;
+    scheduler.setPeriod(logicTask, updateInterval);
+    scheduler.setPeriod(dashboardTask, updateInterval);
+
+    sensorInterval = SENSOR_INTERVAL;
+    scheduler.setPeriod(sensorTask, sensorInterval);
+
+    // Sleep: one short ADC burst per sensor read instead of sampling nonstop
+    adc.setInterval(sleep ? sensorInterval : 0);
+
+    // Leaving sleep, the last reading may be seconds old: read now so the
+    // rules and the page work from a fresh one
+    if (!sleep) {
+        scheduler.wake(sensorTask);
+        scheduler.wake(logicTask);
+        scheduler.wake(dashboardTask);
+    }
+}
+
+// A Settings-card edit was applied
+void onParamChange(uint8_t id) {
+    // The params write the rule's fields directly: evaluate it with the
+    // new threshold now, not once the sensor moves
+    if (id == paramRelayOn || id == paramRelayHyst) {
+        rules.recheck(relayRule);
+    }
 }
 
 void onReset() {
@@ -91,107 +178,167 @@ void onReset() {
     // ESP will restart automatically after this callback
 }
 
-void onCustomAction() {
-    Serial.println("💡 Blink LED Test - Blinking onboard LED 5 times...");
-
-    // Blink LED 5 times to confirm ESP32 is responding
-    bool originalState = ledState;
-    for (int i = 0; i < 5; i++) {
-        digitalWrite(LED_PIN, HIGH);
-        delay(150);
-        digitalWrite(LED_PIN, LOW);
-        delay(150);
+// Blink LED 5 times to confirm ESP32 is responding. Each step switches
+// the LED and defers the next one, so the request returns right away.
+const int BLINK_STEPS = 10;          // 5 x (on, off)
+const uint32_t BLINK_STEP_MS = 150;
+int blinkStep = BLINK_STEPS;         // BLINK_STEPS = idle
+
+void blinkStepAction() {
+    if (blinkStep < BLINK_STEPS) {
+        digitalWrite(LED_PIN, blinkStep % 2 == 0 ? HIGH : LOW);
+        blinkStep++;
+        dashboard.defer(blinkStepAction, BLINK_STEP_MS);
+        return;
     }
 
-    // Restore original LED state
-    digitalWrite(LED_PIN, originalState ? HIGH : LOW);
-
+    // Restore original state
+    digitalWrite(LED_PIN, ledState ? HIGH : LOW);
     Serial.println("✓ LED blink test completed - ESP32 is working!");
 }
 
+void onCustomAction() {
+    if (blinkStep < BLINK_STEPS) {
+        return;  // Already blinking
+    }
+    Serial.println("💡 Blink LED Test - Blinking onboard LED 5 times...");
+    blinkStep = 0;
+    blinkStepAction();
+}
+
 // ==================== SETUP ====================
 
 void setup() {
-    // Initialize Serial
-    Serial.begin(115200);
-    delay(1000);
+    // Outputs off before anything else
+    pinMode(LED_PIN, OUTPUT);
+    pinMode(RELAY_PIN, OUTPUT);
+    digitalWrite(LED_PIN, LOW);
+    digitalWrite(RELAY_PIN, LOW);
 
+    // No delay for the monitor to attach: the boot timeline is printed
+    // again once the server is up
+    Serial.begin(115200);
     Serial.println("\n\n╔════════════════════════════════════╗");
     Serial.println("║   ESP32 Dashboard Template v2.0   ║");
     Serial.println("╚════════════════════════════════════╝\n");
 
-    // Configure GPIO pins
-    pinMode(LED_PIN, OUTPUT);
-    pinMode(RELAY_PIN, OUTPUT);
     pinMode(SENSOR_PIN, INPUT);
+    adcSensor = adc.addChannel(SENSOR_PIN);
+    adc.begin();
 
-    digitalWrite(LED_PIN, LOW);
-    digitalWrite(RELAY_PIN, LOW);
-
-    // Initialize data structures
+    // Channels and rules, then restore the last mode, LED and thresholds
+    // before anything runs (the relay stays off, see RESTORE_RELAY)
     initializeDataStructures();
-
-    // Start web dashboard
-    dashboard.begin();
+    initializeRules();
+    initializeParams();
+    digitalWrite(LED_PIN, ledState ? HIGH : LOW);
+    digitalWrite(RELAY_PIN, relayState ? HIGH : LOW);
+    DashboardBoot::mark(BOOT_CONTROL);
+
+    // Optional: serve HTTP from its own task on core 0
+    // dashboard.useServerTask();
+
+    // Start web dashboard. Radio defaults come from the DASHBOARD_*
+    // build flags (platformio.ini); override them here if you prefer
+    DashboardConfig config;
+    config.deferStart = true;               // WiFi and server come up in the background
+    // config.channel = 6;                  // 1, 6 and 11 do not overlap
+    // config.txPower = WIFI_POWER_11dBm;   // Short range, less interference
+
+    // Also join the plant network (then reachable as http://<hostname>.local)
+    // config.wifiMode = DASHBOARD_AP_STA;
+    // config.staSsid = "PlantWiFi";
+    // config.staPassword = "secret";
+    // config.hostname = "line3-press";
+
+    // MQTT telemetry (build with the esp32dev-mqtt environment)
+    // static DashboardMqtt mqtt;
+    // mqtt.setServer("broker.plant.lan");
+    // dashboard.setMqtt(mqtt);
+
+    // Aggregator: poll every other dashboard, served at /api/fleet
+    // static Fleet<48> fleet;
+    // dashboard.setFleet(fleet);
+
+    // Keep the sensor on flash for days (read with /api/history?tier=log)
+    // static DashboardLog log(1);
+    // dashboard.setLog(log);
+
+    dashboard.setParams(params);
+    dashboard.setRules(rules);
+    dashboard.begin(config);
+    dashboard.attach(scheduler);
+
+    // Periodic tasks - add your own here
+    sensorTask = scheduler.every(SENSOR_INTERVAL, readSensors);
+    logicTask = scheduler.every(UPDATE_INTERVAL, runApplicationLogic);
+    dashboardTask = scheduler.every(UPDATE_INTERVAL, updateDashboardData);
+    if (currentMode == "sleep") {
+        onModeChange("sleep");              // Restored: slow the tasks down again
+    }
 
     // Register callback functions
-    dashboard.onOutput1Change(onLEDChange);
-    dashboard.onOutput2Change(onRelayChange);
+    dashboard.onOutputChange(onOutputChange);
     dashboard.onModeChange(onModeChange);
     dashboard.onReset(onReset);
     dashboard.onCustomAction(onCustomAction);
 
-    Serial.println("✓ Setup complete!");
+    Serial.println("✓ Setup complete, WiFi starting");
     Serial.println("✓ Connect to WiFi and open http://192.168.4.1\n");
 }
 
 // ==================== LOOP ====================
 
 void loop() {
-    // Handle web requests
-    dashboard.loop();
-
-    // Read sensors periodically
-    static unsigned long lastSensorRead = 0;
-    if (millis() - lastSensorRead > 500) {
-        readSensors();
-        lastSensorRead = millis();
-    }
+    // Runs whatever is due (web requests, sensors, your logic), then
+    // sleeps until the next deadline
+    scheduler.run();
+}
 
-    // Update dashboard data
-    updateDashboardData();
+// ==================== APPLICATION FUNCTIONS ====================
 
-    // Your application logic here!
-    runApplicationLogic();
+void initializeParams() {
+    // Editable on the dashboard's Settings card
+    DashboardRule& relay = rules.rule(relayRule);
+    paramRelayOn = params.addFloat("relayOn", &relay.threshold, 0, 4095, "Relay on above");
+    paramRelayHyst = params.addFloat("relayHyst", &relay.hysteresis, 0, 4095,
+                                     "Relay off this much lower");
+    params.onChange(onParamChange);
+
+    // Only remembered across restarts
+    params.addBool("led", &ledState);
+    if (RESTORE_RELAY) {
+        params.addBool("relay", &relayState);
+    }
+    params.addText("mode", savedMode, sizeof(savedMode));
 
-    // Small delay to prevent watchdog issues
-    delay(10);
+    params.begin();
+    currentMode = savedMode;
+    systemInfo.mode = currentMode.c_str();
+    rules.setActive(currentMode == "auto");
 }
 
-// ==================== APPLICATION FUNCTIONS ====================
+void initializeRules() {
+    // Relay follows the sensor in auto mode: on above 2000, off below
+    // 1500. It stays on at most DASHBOARD_RELAY_MAX_ON_TIME (60 s) in any
+    // mode; add minimum on/off times for e.g. a compressor:
+    // rules.setTiming(relayRule, 10000, 30000);
+    relayRule = rules.add(chSensor, RULE_ABOVE, 2000, 500, chRelay);
+    rules.onSwitch(onRuleSwitch);
+}
 
 void initializeDataStructures() {
-    // Configure sensor data
-    sensors.label1 = "Sensor";
-    sensors.label2 = "Temperature";
-    sensors.label3 = "Humidity";
-    sensors.unit1 = "units";
-    sensors.unit2 = "°C";
-    sensors.unit3 = "%";
-    sensors.showValue1 = true;
-    sensors.showValue2 = false;  // Hide until you add a real sensor
-    sensors.showValue3 = false;  // Hide until you add a real sensor
-    sensors.value1 = 0;
-    sensors.value2 = 0;
-    sensors.value3 = 0;
-
-    // Configure output states
-    outputs.label1 = "LED";
-    outputs.label2 = "Relay";
-    outputs.showOutput1 = true;
-    outputs.showOutput2 = true;
-    outputs.output1 = false;
-    outputs.output2 = false;
+    // Configure sensor channels
+    chSensor = channels.add("Sensor", "units");
+    channels.setDeadband(chSensor, 16);     // Ignore ADC noise (counts)
+    chTemperature = channels.add("Temperature", "°C", CHANNEL_HIDDEN);  // Hide until you add a real sensor
+    chHumidity = channels.add("Humidity", "%", CHANNEL_HIDDEN);        // Hide until you add a real sensor
+
+    // Configure output channels
+    chLED = channels.addOutput("LED");
+    chRelay = channels.addOutput("Relay");
+
+    dashboard.setChannels(channels);
 
     // Configure system info
     systemInfo.projectName = "🔧 My ESP32 Project";
@@ -201,8 +348,28 @@ void initializeDataStructures() {
 }
 
 void readSensors() {
-    // Read analog sensor
-    sensorValue = analogRead(SENSOR_PIN);
+    // Newest filtered reading (ADC counts); sampling runs in the background
+    int previous = sensorValue;
+    float reading = adc.value(adcSensor);
+    if (!isnan(reading)) {
+        sensorValue = lroundf(reading);
+    }
+
+    // Sleep mode: read less often while nothing changes, and go back to
+    // the normal rate as soon as it does
+    if (currentMode == "sleep") {
+        uint32_t interval = sensorInterval;
+        if (abs(sensorValue - previous) <= SENSOR_STEADY_BAND) {
+            interval = min(sensorInterval * 2, SLEEP_SENSOR_MAX);
+        } else {
+            interval = SENSOR_INTERVAL;
+        }
+        if (interval != sensorInterval) {
+            sensorInterval = interval;
+            scheduler.setPeriod(sensorTask, sensorInterval);
+            adc.setInterval(sensorInterval);
+        }
+    }
 
     // Example: Add more sensors here
     // float temperature = dht.readTemperature();
@@ -211,50 +378,33 @@ void readSensors() {
 
 void updateDashboardData() {
     // Update sensor values
-    sensors.value1 = sensorValue;
-    // sensors.value2 = temperature;
-    // sensors.value3 = humidity;
+    channels.setValue(chSensor, sensorValue);
+    // channels.setValue(chTemperature, temperature);
+    // channels.setValue(chHumidity, humidity);
 
     // Update output states
-    outputs.output1 = ledState;
-    outputs.output2 = relayState;
+    channels.setState(chLED, ledState);
+    channels.setState(chRelay, relayState);
 
     // Update system info
     systemInfo.uptime = millis() / 1000;
     systemInfo.mode = currentMode.c_str();
 
-    // Push updates to dashboard
-    dashboard.updateSensorData(&sensors);
-    dashboard.updateOutputStates(&outputs);
-    dashboard.updateSystemInfo(&systemInfo);
+    // Push a consistent copy to the dashboard
+    dashboard.publish(systemInfo);
 }
 
 void runApplicationLogic() {
-    // AUTOMATIC MODE: Implement your automatic control logic
-    if (currentMode == "auto") {
-        // Example: Turn relay ON when sensor > threshold
-        if (sensorValue > 2000 && !relayState) {
-            relayState = true;
-            digitalWrite(RELAY_PIN, HIGH);
-            Serial.println("Auto: Relay turned ON");
-        }
-        else if (sensorValue < 1500 && relayState) {
-            relayState = false;
-            digitalWrite(RELAY_PIN, LOW);
-            Serial.println("Auto: Relay turned OFF");
-        }
-    }
+    // AUTOMATIC MODE: threshold switching is done by the rule table
+    // (initializeRules()), evaluated by publish() when the sensor changes.
+    // Add rules there, or logic that does not fit a rule here.
 
     // MANUAL MODE: User controls everything via dashboard
     // Nothing to do here - buttons handle it
 
     // SLEEP MODE: Low power mode
-    if (currentMode == "sleep") {
-        // Implement power saving
-        // WiFi.disconnect();
-        // esp_sleep_enable_timer_wakeup(10 * 1000000); // 10 sec
-        // esp_light_sleep_start();
-    }
+    // Handled in onModeChange() and readSensors(): the access point stays
+    // up, only the clock and the task rates go down
 
     // Add your custom logic here!
     // Examples:
@@ -271,4 +421,3 @@ void runApplicationLogic() {
 // - Sensor calibration
 // - Data logging
 // - WiFi reconnection
-// - EEPROM saving/loading
@@ -9,12 +9,11 @@
  * - DHT22 sensor on GPIO 4
  * - LED on GPIO 2
  *
- * Libraries needed:
- * - DHT sensor library (Adafruit)
+ * The DHT22 is read with the RMT peripheral (DashboardDht.h), so no
+ * DHT library is needed and a read never blocks the loop.
  */
 
 #include "WebDashboard.h"
-#include <DHT.h>
 
 // ==================== CONFIGURATION ====================
 
@@ -23,25 +22,40 @@ const char* WIFI_PASSWORD = "weather123";
 
 // DHT Sensor
 #define DHTPIN 4
-#define DHTTYPE DHT22
-DHT dht(DHTPIN, DHTTYPE);
+DhtSensor dht(DHTPIN, DHT_MODEL_22);
+SensorTable<1> sensorTable;
 
 // LED for visual feedback
 const int LED_PIN = 2;
 
-// Temperature threshold for automatic fan control
+// Automatic fan control: on above 25 °C, off below 24 °C
 const float TEMP_THRESHOLD = 25.0;  // °C
+const float TEMP_HYSTERESIS = 1.0;
+
+// Channel ids behind SensorData/OutputStates
+const uint8_t CH_TEMPERATURE = 0;   // value1
+const uint8_t CH_FAN = 3;           // output1
 
 // ==================== GLOBALS ====================
 
 WebDashboard dashboard(WIFI_SSID, WIFI_PASSWORD);
+DashboardScheduler scheduler;
+RuleTable<1> rules;
 
 SensorData sensors;
 OutputStates outputs;
 SystemInfo systemInfo;
 
-float temperature = 0;
-float humidity = 0;
+// Last hour of temperature, humidity and heat index at one sample per
+// 5 s, stored as int16 in 0.01 steps (3 x 720 x 2 bytes = 4.3 KB), plus
+// 24 h as 15-minute min/max/avg buckets (3 x 96 x 16 bytes = 4.6 KB).
+// Read it back with /api/history?ch=0 or /api/history?ch=0&last=86400
+DashboardHistory<3, 720, int16_t> history(100);
+DashboardRollup<3, 96> quarterHours(180);   // 180 x 5 s = 15 min
+
+float temperature = NAN;             // NAN until the first good read
+float humidity = NAN;
+uint32_t reportedFailures = 0;
 bool fanState = false;
 String mode = "auto";
 
@@ -55,8 +69,16 @@ void onFanControl(bool state) {
     }
 }
 
+// The fan rule switched (auto mode, or the on-time limit in any mode)
+void onRuleSwitch(uint8_t channel, bool state) {
+    fanState = state;
+    digitalWrite(LED_PIN, state ? HIGH : LOW);
+    Serial.printf("Auto: Fan %s (temp: %.1f°C)\n", state ? "ON" : "OFF", temperature);
+}
+
 void onModeChange(const char* newMode) {
     mode = String(newMode);
+    rules.setActive(mode == "auto");
     Serial.printf("Mode: %s\n", mode.c_str());
 
     if (mode == "manual") {
@@ -70,38 +92,50 @@ void onReset() {
     Serial.println("Resetting...");
 }
 
-void onBlinkTest() {
-    Serial.println("💡 Blink LED Test - Blinking onboard LED 5 times...");
-
-    // Blink LED 5 times to confirm ESP32 is responding
-    bool originalState = fanState;
-    for (int i = 0; i < 5; i++) {
-        digitalWrite(LED_PIN, HIGH);
-        delay(150);
-        digitalWrite(LED_PIN, LOW);
-        delay(150);
+// Blink LED 5 times to confirm ESP32 is responding. Each step switches
+// the LED and defers the next one, so the request returns right away.
+const int BLINK_STEPS = 10;          // 5 x (on, off)
+const uint32_t BLINK_STEP_MS = 150;
+int blinkStep = BLINK_STEPS;         // BLINK_STEPS = idle
+
+void blinkStepAction() {
+    if (blinkStep < BLINK_STEPS) {
+        digitalWrite(LED_PIN, blinkStep % 2 == 0 ? HIGH : LOW);
+        blinkStep++;
+        dashboard.defer(blinkStepAction, BLINK_STEP_MS);
+        return;
     }
 
     // Restore original state
-    digitalWrite(LED_PIN, originalState ? HIGH : LOW);
-
+    digitalWrite(LED_PIN, fanState ? HIGH : LOW);
     Serial.println("✓ LED blink test completed!");
 }
 
+void onBlinkTest() {
+    if (blinkStep < BLINK_STEPS) {
+        return;  // Already blinking
+    }
+    Serial.println("💡 Blink LED Test - Blinking onboard LED 5 times...");
+    blinkStep = 0;
+    blinkStepAction();
+}
+
 // ==================== SETUP ====================
 
 void setup() {
-    Serial.begin(115200);
-    delay(1000);
+    // Fan off first
+    pinMode(LED_PIN, OUTPUT);
+    digitalWrite(LED_PIN, LOW);
+    DashboardBoot::mark(BOOT_CONTROL);
 
+    Serial.begin(115200);
     Serial.println("\n╔══════════════════════════════╗");
     Serial.println("║  Temperature Monitor v1.0   ║");
     Serial.println("╚══════════════════════════════╝\n");
 
     // Init hardware
-    pinMode(LED_PIN, OUTPUT);
-    digitalWrite(LED_PIN, LOW);
-    dht.begin();
+    sensorTable.add(dht, 2000);         // DHT22: at most every 2 s
+    sensorTable.begin();
 
     // Configure display
     sensors.label1 = "Temperature";
@@ -123,12 +157,31 @@ void setup() {
     systemInfo.version = "v1.0";
     systemInfo.mode = mode.c_str();
 
-    // Start dashboard
-    dashboard.begin();
+    history.setPeriod(5000);
+    history.addTier(quarterHours);
+    dashboard.setHistory(history);
+    dashboard.setSensors(sensorTable);
+
+    // Fan on above TEMP_THRESHOLD, with no on/off cycling faster than
+    // 30 s. It may run as long as it is warm: no maximum on time (the
+    // default is the DASHBOARD_RELAY_MAX_ON_TIME safety limit).
+    int8_t fanRule = rules.add(CH_TEMPERATURE, RULE_ABOVE, TEMP_THRESHOLD, TEMP_HYSTERESIS, CH_FAN);
+    rules.setTiming(fanRule, 30000, 30000, 0);
+    rules.onSwitch(onRuleSwitch);
+    dashboard.setRules(rules);
+
+    // Start dashboard (WiFi comes up in the background)
+    DashboardConfig config;
+    config.deferStart = true;
+    dashboard.begin(config);
     dashboard.onOutput1Change(onFanControl);
     dashboard.onModeChange(onModeChange);
     dashboard.onReset(onReset);
     dashboard.onCustomAction(onBlinkTest);
+    dashboard.attach(scheduler);
+
+    scheduler.every(100, readSensors);      // Polls; the table paces the DHT
+    scheduler.every(100, updateDashboard);
 
     Serial.println("✓ Ready! Open http://192.168.4.1\n");
 }
@@ -136,52 +189,51 @@ void setup() {
 // ==================== LOOP ====================
 
 void loop() {
-    dashboard.loop();
-
-    // Read sensors every 2 seconds
-    static unsigned long lastRead = 0;
-    if (millis() - lastRead > 2000) {
-        temperature = dht.readTemperature();
-        humidity = dht.readHumidity();
-
-        // Check if reads failed
-        if (isnan(temperature) || isnan(humidity)) {
-            Serial.println("Failed to read from DHT sensor!");
-            temperature = 0;
-            humidity = 0;
-        } else {
-            // Calculate heat index
-            float heatIndex = dht.computeHeatIndex(temperature, humidity, false);
-            sensors.value3 = heatIndex;
-        }
+    scheduler.run();
+}
 
-        lastRead = millis();
+// ==================== TASKS ====================
+
+// Heat index (°C) after the NWS regression, as the DHT library computes it
+float heatIndex(float celsius, float percent) {
+    float f = celsius * 1.8f + 32;
+    float hi = 0.5f * (f + 61.0f + (f - 68.0f) * 1.2f + percent * 0.094f);
+    if (hi > 79) {
+        hi = -42.379f + 2.04901523f * f + 10.14333127f * percent
+            - 0.22475541f * f * percent - 0.00683783f * f * f
+            - 0.05481717f * percent * percent + 0.00122874f * f * f * percent
+            + 0.00085282f * f * percent * percent - 0.00000199f * f * f * percent * percent;
+        if (percent < 13 && f >= 80 && f <= 112) {
+            hi -= ((13 - percent) * 0.25f) * sqrtf((17 - fabsf(f - 95)) * 0.05882f);
+        } else if (percent > 85 && f >= 80 && f <= 87) {
+            hi += ((percent - 85) * 0.1f) * ((87 - f) * 0.2f);
+        }
     }
+    return (hi - 32) / 1.8f;
+}
 
-    // AUTO MODE: Control fan based on temperature
-    if (mode == "auto") {
-        if (temperature > TEMP_THRESHOLD && !fanState) {
-            fanState = true;
-            digitalWrite(LED_PIN, HIGH);
-            Serial.printf("Auto: Fan ON (temp: %.1f°C)\n", temperature);
-        }
-        else if (temperature < TEMP_THRESHOLD - 1.0 && fanState) {
-            fanState = false;
-            digitalWrite(LED_PIN, LOW);
-            Serial.printf("Auto: Fan OFF (temp: %.1f°C)\n", temperature);
-        }
+void readSensors() {
+    sensorTable.service(millis());
+
+    // A failed read keeps the last good values for a few tries, then
+    // they turn NAN ("--" on the page) rather than a fake 0
+    if (sensorTable.failures(0) != reportedFailures) {
+        reportedFailures = sensorTable.failures(0);
+        Serial.printf("DHT read failed: %s (%lu of %lu)\n", sensorTable.lastError(0),
+                      (unsigned long)reportedFailures, (unsigned long)sensorTable.reads(0));
     }
 
-    // Update dashboard
+    temperature = sensorTable.value(0, 0);
+    humidity = sensorTable.value(0, 1);
+    sensors.value3 = isnan(temperature) || isnan(humidity) ? NAN : heatIndex(temperature, humidity);
+}
+
+void updateDashboard() {
     sensors.value1 = temperature;
     sensors.value2 = humidity;
     outputs.output1 = fanState;
     systemInfo.uptime = millis() / 1000;
     systemInfo.mode = mode.c_str();
 
-    dashboard.updateSensorData(&sensors);
-    dashboard.updateOutputStates(&outputs);
-    dashboard.updateSystemInfo(&systemInfo);
-
-    delay(10);
+    dashboard.publish(sensors, outputs, systemInfo);
 }
@@ -0,0 +1,26 @@
+/*
+ * bench_sources.cpp
+ *
+ * The dashboard sources live in the project root rather than src/, so
+ * the bench build (test_build_src = no) compiles them from here.
+ */
+
+#include "WebDashboard.cpp"
+#include "DashboardAdc.cpp"
+#include "DashboardAdmission.cpp"
+#include "DashboardBoot.cpp"
+#include "DashboardChannels.cpp"
+#include "DashboardDht.cpp"
+#include "DashboardEvents.cpp"
+#include "DashboardFleet.cpp"
+#include "DashboardHistory.cpp"
+#include "DashboardLog.cpp"
+#include "DashboardMetrics.cpp"
+#include "DashboardMqtt.cpp"
+#include "DashboardParams.cpp"
+#include "DashboardPower.cpp"
+#include "DashboardRequest.cpp"
+#include "DashboardRules.cpp"
+#include "DashboardScheduler.cpp"
+#include "DashboardSensors.cpp"
+#include "DashboardStation.cpp"
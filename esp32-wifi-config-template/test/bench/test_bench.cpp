@@ -0,0 +1,347 @@
+/*
+ * test_bench.cpp
+ *
+ * On-target micro-benchmarks for WebDashboard:
+ *
+ *   pio test -e bench                 (WebServer backend)
+ *   pio test -e bench-async           (ESPAsyncWebServer backend)
+ *
+ * The dashboard runs on the device under test and the benchmarks talk
+ * to it over the loopback interface, so no second device is needed.
+ * Every result is printed as one JSON line with a "BENCH " prefix:
+ *
+ *   BENCH {"name":"status_json","n":500,"mean_us":212.4,"min_us":198,"max_us":640,"bytes":517}
+ *
+ * Collect them with:  pio test -e bench | grep '^BENCH ' | cut -c7-
+ *
+ * Each benchmark is also a Unity test that fails when it goes over its
+ * budget (BENCH_*_BUDGET_*), so regressions show up before flashing. The
+ * budgets are generous ceilings, not targets: compare the BENCH lines
+ * between builds for the finer picture.
+ */
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <unity.h>
+#include "WebDashboard.h"
+#include "DashboardPage.h"         // DASHBOARD_PAGE_GZ_LEN
+
+#define BENCH_ITERATIONS 500        // Serializer runs per benchmark
+#define BENCH_PAGE_REQUESTS 20      // GET / for the throughput figure
+#define BENCH_CLIENTS 4             // Simultaneous simulated clients
+#define BENCH_ROUNDS 25             // Rounds of BENCH_CLIENTS requests
+#define BENCH_HEAP_REQUESTS 50      // Sequential requests for heap churn
+#define BENCH_TIMEOUT_MS 5000       // Per round of requests
+
+#ifndef BENCH_STATUS_BUDGET_US
+#define BENCH_STATUS_BUDGET_US 2000     // Build + serialize /api/status
+#endif
+#ifndef BENCH_VALUES_BUDGET_US
+#define BENCH_VALUES_BUDGET_US 1500     // Build + serialize /api/values
+#endif
+#ifndef BENCH_PAGE_BUDGET_US
+#define BENCH_PAGE_BUDGET_US 100000     // Mean time to send the gzipped page
+#endif
+#ifndef BENCH_REQUEST_BUDGET_US
+#define BENCH_REQUEST_BUDGET_US 50000   // Mean loopback request latency
+#endif
+#ifndef BENCH_HEAP_RETAINED_BUDGET
+#define BENCH_HEAP_RETAINED_BUDGET 256  // Bytes not given back per request
+#endif
+
+WebDashboard dashboard("DashboardBench", "benchmark");
+ChannelTable<8> channels;
+SystemInfo systemInfo;
+
+// Access to the private JSON builders (friend of WebDashboard)
+class DashboardBench {
+public:
+    static size_t status(char* out, size_t size, bool msgpack) {
+        DashboardState state;
+        dashboard._state.read(state);
+        StaticJsonDocument<DASHBOARD_STATUS_DOC> doc;
+        dashboard.buildStatus(doc, state);
+        return msgpack ? serializeMsgPack(doc, out, size) : serializeJson(doc, out, size);
+    }
+
+    static size_t values(char* out, size_t size, bool msgpack) {
+        DashboardState state;
+        dashboard._state.read(state);
+        StaticJsonDocument<DASHBOARD_VALUES_DOC> doc;
+        dashboard.buildValues(doc, state);
+        return msgpack ? serializeMsgPack(doc, out, size) : serializeJson(doc, out, size);
+    }
+};
+
+// ==================== RESULTS ====================
+
+struct BenchStats {
+    uint32_t n;
+    uint64_t sumCycles;
+    uint32_t minCycles;
+    uint32_t maxCycles;
+};
+
+static void resetStats(BenchStats& stats) {
+    stats.n = 0;
+    stats.sumCycles = 0;
+    stats.minCycles = UINT32_MAX;
+    stats.maxCycles = 0;
+}
+
+static void addSample(BenchStats& stats, uint32_t cycles) {
+    stats.n++;
+    stats.sumCycles += cycles;
+    if (cycles < stats.minCycles) stats.minCycles = cycles;
+    if (cycles > stats.maxCycles) stats.maxCycles = cycles;
+}
+
+static float meanUs(const BenchStats& stats) {
+    return stats.n ? (float)stats.sumCycles / stats.n / getCpuFrequencyMhz() : 0;
+}
+
+// One machine-readable line; extra holds further "key":value pairs
+static void report(const char* name, const BenchStats& stats, const char* extra) {
+    uint32_t mhz = getCpuFrequencyMhz();
+    Serial.printf("BENCH {\"name\":\"%s\",\"n\":%lu,\"mean_us\":%.1f,\"min_us\":%lu,"
+                  "\"max_us\":%lu%s%s}\n",
+                  name, (unsigned long)stats.n, meanUs(stats),
+                  (unsigned long)(stats.n ? stats.minCycles / mhz : 0),
+                  (unsigned long)(stats.maxCycles / mhz), extra[0] ? "," : "", extra);
+}
+
+// ==================== LOOPBACK CLIENTS ====================
+
+struct BenchClient {
+    WiFiClient socket;
+    uint32_t start;             // Cycle count when the request was sent
+    uint32_t cycles;            // Until the server closed the connection
+    size_t bytes;               // Headers + body
+    int status;
+    bool done;
+};
+
+static bool startRequest(BenchClient& client, const char* path) {
+    client.bytes = 0;
+    client.status = 0;
+    client.done = false;
+    if (!client.socket.connect(WiFi.softAPIP(), 80)) {
+        return false;
+    }
+    client.start = ESP.getCycleCount();
+    client.socket.printf("GET %s HTTP/1.1\r\nHost: bench\r\nAccept-Encoding: gzip\r\n"
+                         "Connection: close\r\n\r\n", path);
+    return true;
+}
+
+// Run the dashboard until every client has its complete response (the
+// server closes the connection). lowestHeap, if given, tracks the free
+// heap while the requests are in flight.
+static bool finishRequests(BenchClient* clients, uint8_t count, uint32_t* lowestHeap = nullptr) {
+    uint32_t started = millis();
+    uint8_t open = count;
+    uint8_t buffer[512];
+
+    while (open > 0 && millis() - started < BENCH_TIMEOUT_MS) {
+        dashboard.loop();
+        if (lowestHeap) {
+            uint32_t free = ESP.getFreeHeap();
+            if (free < *lowestHeap) *lowestHeap = free;
+        }
+
+        for (uint8_t i = 0; i < count; i++) {
+            BenchClient& client = clients[i];
+            if (client.done) continue;
+
+            int length;
+            while ((length = client.socket.read(buffer, sizeof(buffer))) > 0) {
+                if (client.bytes == 0 && length >= 12) {
+                    client.status = atoi((const char*)buffer + 9);    // "HTTP/1.1 200"
+                }
+                client.bytes += length;
+            }
+            if (!client.socket.connected() && !client.socket.available()) {
+                client.cycles = ESP.getCycleCount() - client.start;
+                client.socket.stop();
+                client.done = true;
+                open--;
+            }
+        }
+    }
+    return open == 0;
+}
+
+static bool fetch(BenchClient& client, const char* path, uint32_t* lowestHeap = nullptr) {
+    return startRequest(client, path) && finishRequests(&client, 1, lowestHeap)
+        && client.status == 200;
+}
+
+// ==================== BENCHMARKS ====================
+
+static char output[DASHBOARD_TX_BUFFER];
+
+static void benchSerializer(const char* name, size_t (*build)(char*, size_t, bool),
+                            bool msgpack, BenchStats& stats) {
+    size_t bytes = 0;
+    resetStats(stats);
+    for (uint16_t i = 0; i < BENCH_ITERATIONS; i++) {
+        uint32_t start = ESP.getCycleCount();
+        bytes = build(output, sizeof(output), msgpack);
+        addSample(stats, ESP.getCycleCount() - start);
+    }
+
+    char extra[32];
+    snprintf(extra, sizeof(extra), "\"bytes\":%u", (unsigned)bytes);
+    report(name, stats, extra);
+    TEST_ASSERT_TRUE_MESSAGE(bytes > 0, "document did not fit the buffer");
+}
+
+void test_status_json() {
+    BenchStats stats;
+    benchSerializer("status_json", DashboardBench::status, false, stats);
+    TEST_ASSERT_LESS_THAN_MESSAGE(BENCH_STATUS_BUDGET_US, meanUs(stats), "over budget");
+}
+
+void test_status_msgpack() {
+    BenchStats stats;
+    benchSerializer("status_msgpack", DashboardBench::status, true, stats);
+    TEST_ASSERT_LESS_THAN_MESSAGE(BENCH_STATUS_BUDGET_US, meanUs(stats), "over budget");
+}
+
+void test_values_json() {
+    BenchStats stats;
+    benchSerializer("values_json", DashboardBench::values, false, stats);
+    TEST_ASSERT_LESS_THAN_MESSAGE(BENCH_VALUES_BUDGET_US, meanUs(stats), "over budget");
+}
+
+void test_values_msgpack() {
+    BenchStats stats;
+    benchSerializer("values_msgpack", DashboardBench::values, true, stats);
+    TEST_ASSERT_LESS_THAN_MESSAGE(BENCH_VALUES_BUDGET_US, meanUs(stats), "over budget");
+}
+
+// The gzipped page as served by send_P
+void test_page_throughput() {
+    BenchStats stats;
+    BenchClient client;
+    size_t bytes = 0;
+    resetStats(stats);
+
+    for (uint8_t i = 0; i < BENCH_PAGE_REQUESTS; i++) {
+        TEST_ASSERT_TRUE(fetch(client, "/"));
+        addSample(stats, client.cycles);
+        bytes += client.bytes;
+    }
+
+    float seconds = (float)stats.sumCycles / getCpuFrequencyMhz() / 1e6f;
+    char extra[96];
+    snprintf(extra, sizeof(extra), "\"bytes\":%u,\"page_gz_bytes\":%u,\"kib_per_s\":%.1f",
+             (unsigned)(bytes / BENCH_PAGE_REQUESTS), (unsigned)DASHBOARD_PAGE_GZ_LEN,
+             bytes / 1024.0f / seconds);
+    report("page_send", stats, extra);
+    TEST_ASSERT_LESS_THAN_MESSAGE(BENCH_PAGE_BUDGET_US, meanUs(stats), "over budget");
+}
+
+// BENCH_CLIENTS connections at once, BENCH_ROUNDS times
+void test_requests_per_second() {
+    static BenchClient clients[BENCH_CLIENTS];
+    BenchStats stats;
+    uint32_t failed = 0;
+    resetStats(stats);
+
+    uint32_t begin = ESP.getCycleCount();
+    for (uint8_t round = 0; round < BENCH_ROUNDS; round++) {
+        uint8_t started = 0;
+        for (uint8_t i = 0; i < BENCH_CLIENTS; i++) {
+            if (startRequest(clients[started], "/api/values")) started++;
+            else failed++;
+        }
+        finishRequests(clients, started);
+        for (uint8_t i = 0; i < started; i++) {
+            if (clients[i].done && clients[i].status == 200) addSample(stats, clients[i].cycles);
+            else failed++;
+        }
+    }
+    float seconds = (float)(ESP.getCycleCount() - begin) / getCpuFrequencyMhz() / 1e6f;
+
+    char extra[96];
+    snprintf(extra, sizeof(extra), "\"clients\":%u,\"requests_per_s\":%.1f,\"errors\":%lu",
+             (unsigned)BENCH_CLIENTS, stats.n / seconds, (unsigned long)failed);
+    report("requests_values", stats, extra);
+
+    TEST_ASSERT_EQUAL(0, failed);
+    TEST_ASSERT_LESS_THAN_MESSAGE(BENCH_REQUEST_BUDGET_US, meanUs(stats), "over budget");
+}
+
+// Heap taken while a request is in flight, and what is not given back
+void test_heap_churn() {
+    BenchClient client;
+    BenchStats stats;
+    resetStats(stats);
+
+    TEST_ASSERT_TRUE(fetch(client, "/api/status"));    // Warm up lazily allocated state
+    uint32_t before = ESP.getFreeHeap();
+    uint32_t lowest = before;
+    for (uint8_t i = 0; i < BENCH_HEAP_REQUESTS; i++) {
+        TEST_ASSERT_TRUE(fetch(client, "/api/status", &lowest));
+        addSample(stats, client.cycles);
+    }
+    delay(100);                 // Let lwIP release closed sockets
+    uint32_t after = ESP.getFreeHeap();
+    float retained = ((float)before - (float)after) / BENCH_HEAP_REQUESTS;
+
+    char extra[112];
+    snprintf(extra, sizeof(extra),
+             "\"heap_free\":%lu,\"heap_in_flight\":%lu,\"heap_retained_per_request\":%.1f",
+             (unsigned long)after, (unsigned long)(before - lowest), retained);
+    report("heap_status", stats, extra);
+    TEST_ASSERT_LESS_THAN_MESSAGE(BENCH_HEAP_RETAINED_BUDGET, retained, "heap not given back");
+}
+
+// ==================== RUNNER ====================
+
+static void initializeDashboard() {
+    // A realistic page: six sensors, two outputs
+    channels.add("Temperature", "°C");
+    channels.add("Humidity", "%");
+    channels.add("Pressure", "hPa");
+    channels.add("Light", "lx");
+    channels.add("Soil", "%");
+    channels.add("Battery", "V");
+    channels.addOutput("Fan");
+    channels.addOutput("Pump");
+    for (uint8_t id = 0; id < 6; id++) {
+        channels.setValue(id, 1000.0f / (id + 3));
+    }
+    dashboard.setChannels(channels);
+
+    systemInfo.projectName = "Benchmark";
+    systemInfo.version = "bench";
+    systemInfo.mode = "auto";
+    systemInfo.uptime = 0;
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(2000);                // Give the test runner time to open the port
+
+    initializeDashboard();
+    dashboard.begin();
+    while (!dashboard.started()) {
+        delay(10);              // WiFi and the server come up on their own task
+    }
+    dashboard.publish(systemInfo);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_status_json);
+    RUN_TEST(test_status_msgpack);
+    RUN_TEST(test_values_json);
+    RUN_TEST(test_values_msgpack);
+    RUN_TEST(test_page_throughput);
+    RUN_TEST(test_requests_per_second);
+    RUN_TEST(test_heap_churn);
+    UNITY_END();
+}
+
+void loop() {
+}
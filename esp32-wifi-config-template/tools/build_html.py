@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+"""
+Compress web/dashboard.html into DashboardPage.h (gzip bytes in PROGMEM
+plus a content-hash ETag) for WebDashboard.
+
+Usage:
+    python3 tools/build_html.py        # run by hand (Arduino IDE users)
+
+PlatformIO runs it automatically before every build:
+    extra_scripts = pre:tools/build_html.py
+
+The header is only rewritten when the page changes, so unchanged pages
+do not trigger a rebuild. Commit the regenerated DashboardPage.h
+together with any change to web/dashboard.html.
+"""
+
+import gzip
+import hashlib
+import os
+import sys
+
+SOURCE = os.path.join("web", "dashboard.html")
+OUTPUT = "DashboardPage.h"
+BYTES_PER_LINE = 16
+
+
+def render_header(html):
+    """Return the C++ header text for the given page bytes."""
+    # mtime=0 keeps the output reproducible from build to build
+    compressed = gzip.compress(html, compresslevel=9, mtime=0)
+    etag = hashlib.sha1(html).hexdigest()[:16]
+
+    lines = [
+        "/*",
+        " * DashboardPage.h",
+        " *",
+        " * GENERATED by tools/build_html.py from web/dashboard.html - do not edit.",
+        " *",
+        " * Original: %d bytes, gzipped: %d bytes" % (len(html), len(compressed)),
+        " */",
+        "",
+        "#ifndef DASHBOARD_PAGE_H",
+        "#define DASHBOARD_PAGE_H",
+        "",
+        "#include <Arduino.h>",
+        "",
+        "#define DASHBOARD_PAGE_ETAG \"\\\"%s\\\"\"" % etag,
+        "",
+        "const size_t DASHBOARD_PAGE_GZ_LEN = %d;" % len(compressed),
+        "",
+        "const uint8_t DASHBOARD_PAGE_GZ[] PROGMEM = {",
+    ]
+    for i in range(0, len(compressed), BYTES_PER_LINE):
+        chunk = compressed[i:i + BYTES_PER_LINE]
+        lines.append("    " + ", ".join("0x%02x" % b for b in chunk) + ",")
+    lines += [
+        "};",
+        "",
+        "#endif // DASHBOARD_PAGE_H",
+        "",
+    ]
+    return "\n".join(lines), len(html), len(compressed)
+
+
+def build(project_dir):
+    """Regenerate the header if needed. Returns True if it was written."""
+    source = os.path.join(project_dir, SOURCE)
+    output = os.path.join(project_dir, OUTPUT)
+
+    with open(source, "rb") as f:
+        html = f.read()
+
+    header, raw_size, gz_size = render_header(html)
+
+    if os.path.exists(output):
+        with open(output, "r", encoding="utf-8") as f:
+            if f.read() == header:
+                return False
+
+    with open(output, "w", encoding="utf-8", newline="\n") as f:
+        f.write(header)
+    print("build_html: %s -> %s (%d -> %d bytes)" % (SOURCE, OUTPUT, raw_size, gz_size))
+    return True
+
+
+try:
+    # Defined when running as a PlatformIO extra script
+    Import("env")  # noqa: F821
+    build(env.subst("$PROJECT_DIR"))  # noqa: F821
+except NameError:
+    env = None
+
+if env is None and __name__ == "__main__":
+    here = os.path.dirname(os.path.abspath(__file__))
+    if not build(os.path.dirname(here)):
+        print("build_html: %s is up to date" % OUTPUT)
+    sys.exit(0)
@@ -0,0 +1,349 @@
+#!/usr/bin/env python3
+"""
+Load generator and soak test for a WebDashboard device.
+
+Simulates K browsers polling the dashboard (GET /api/status every 2 s by
+default) plus periodic bursts of button presses (POST /api/control), and
+reports latency percentiles and error rates per report window. If the
+device serves /api/metrics, its free heap, low-water mark and largest
+free block are scraped every window and a leak trend (bytes/hour) is
+printed at the end.
+
+Usage (connect this machine to the dashboard's WiFi first):
+    python3 tools/dashboard_loadgen.py                      # 4 clients, until Ctrl-C
+    python3 tools/dashboard_loadgen.py -k 8 -d 10m          # 8 clients for 10 minutes
+    python3 tools/dashboard_loadgen.py -k 16 --ramp 60      # +1 client per minute: scaling limit
+    python3 tools/dashboard_loadgen.py -d 72h --jsonl soak.jsonl
+
+Only the Python standard library is used.
+"""
+
+import argparse
+import http.client
+import json
+import random
+import re
+import sys
+import threading
+import time
+from collections import Counter
+
+HEAP_GAUGES = {
+    "dashboard_heap_free_bytes": "free",
+    "dashboard_heap_min_free_bytes": "min",
+    "dashboard_heap_largest_free_block_bytes": "block",
+}
+
+
+def parse_duration(text):
+    """'90' / '90s' / '30m' / '72h' / '2d' -> seconds (0 = forever)."""
+    match = re.fullmatch(r"(\d+(?:\.\d+)?)([smhd]?)", text.strip())
+    if not match:
+        raise argparse.ArgumentTypeError("invalid duration: %s" % text)
+    scale = {"": 1, "s": 1, "m": 60, "h": 3600, "d": 86400}[match.group(2)]
+    return float(match.group(1)) * scale
+
+
+def percentile(counts, total, fraction):
+    """Percentile from a Counter of latency (ms) -> occurrences."""
+    if total == 0:
+        return None
+    rank = fraction * (total - 1)
+    seen = 0
+    for value in sorted(counts):
+        seen += counts[value]
+        if seen > rank:
+            return value
+    return max(counts)
+
+
+class Stats:
+    """Latencies (whole ms) and errors for one kind of request."""
+
+    def __init__(self):
+        self.latencies = Counter()
+        self.requests = 0
+        self.errors = Counter()
+
+    def add(self, latency_ms, error):
+        self.requests += 1
+        if error:
+            self.errors[error] += 1
+        else:
+            self.latencies[int(latency_ms)] += 1
+
+    def merge(self, other):
+        self.latencies.update(other.latencies)
+        self.requests += other.requests
+        self.errors.update(other.errors)
+
+    def summary(self):
+        ok = sum(self.latencies.values())
+        failed = sum(self.errors.values())
+        return {
+            "requests": self.requests,
+            "errors": failed,
+            "error_rate": failed / self.requests if self.requests else 0.0,
+            "p50_ms": percentile(self.latencies, ok, 0.50),
+            "p90_ms": percentile(self.latencies, ok, 0.90),
+            "p99_ms": percentile(self.latencies, ok, 0.99),
+            "max_ms": max(self.latencies) if self.latencies else None,
+            "error_kinds": dict(self.errors),
+        }
+
+
+class Recorder:
+    """Thread-safe collection of the current window and the totals."""
+
+    KINDS = ("poll", "control")
+
+    def __init__(self):
+        self._lock = threading.Lock()
+        self._window = {kind: Stats() for kind in self.KINDS}
+        self.totals = {kind: Stats() for kind in self.KINDS}
+
+    def add(self, kind, latency_ms, error=None):
+        with self._lock:
+            self._window[kind].add(latency_ms, error)
+
+    def take_window(self):
+        with self._lock:
+            window = self._window
+            self._window = {kind: Stats() for kind in self.KINDS}
+        for kind in self.KINDS:
+            self.totals[kind].merge(window[kind])
+        return window
+
+
+def request(args, method, path, body=None):
+    """One request on a fresh connection, like the page's fetch().
+
+    Returns (latency_ms, error, response_body); error is None on success.
+    """
+    headers = {"Connection": "close"}
+    if body is not None:
+        body = json.dumps(body)
+        headers["Content-Type"] = "application/json"
+
+    start = time.monotonic()
+    connection = http.client.HTTPConnection(args.host, args.port, timeout=args.timeout)
+    try:
+        connection.request(method, path, body=body, headers=headers)
+        response = connection.getresponse()
+        data = response.read()
+        latency = (time.monotonic() - start) * 1000
+        if response.status != 200:
+            return latency, "http_%d" % response.status, data
+        return latency, None, data
+    except TimeoutError:
+        return None, "timeout", None
+    except ConnectionRefusedError:
+        return None, "refused", None
+    except ConnectionResetError:
+        return None, "reset", None
+    except (OSError, http.client.HTTPException) as error:
+        return None, type(error).__name__, None
+    finally:
+        connection.close()
+
+
+def poll_client(args, recorder, stop):
+    """One simulated browser: GET args.path every args.interval seconds."""
+    # Spread the clients over the interval, as real page loads would be
+    next_due = time.monotonic() + random.uniform(0, args.interval)
+    while not stop.is_set():
+        delay = next_due - time.monotonic()
+        if delay > 0 and stop.wait(delay):
+            break
+        latency, error, _ = request(args, "GET", args.path)
+        recorder.add("poll", latency, error)
+        next_due += args.interval
+        if next_due < time.monotonic():
+            next_due = time.monotonic()     # Fell behind: do not catch up in a burst
+
+
+def output_channels(args):
+    """Ids of the output channels, from /api/meta."""
+    _, error, data = request(args, "GET", "/api/meta")
+    if error:
+        return []
+    meta = json.loads(data)
+    return [c["id"] for c in meta.get("channels", []) if c.get("flags", 0) & 2]
+
+
+def control_bursts(args, recorder, stop):
+    """Every args.burst_interval s: args.burst_size POST /api/control."""
+    outputs = output_channels(args)
+    if not outputs:
+        print("loadgen: no output channels in /api/meta, control bursts disabled",
+              file=sys.stderr)
+        return
+
+    state = 0
+    while not stop.wait(args.burst_interval):
+        for _ in range(args.burst_size):
+            state ^= 1
+            batch = {"outputs": {str(id): state for id in outputs}}
+            latency, error, _ = request(args, "POST", "/api/control", batch)
+            recorder.add("control", latency, error)
+
+
+def scrape_heap(args):
+    """Heap gauges from /api/metrics, or None if not available."""
+    _, error, data = request(args, "GET", "/api/metrics")
+    if error:
+        return None
+    heap = {}
+    for line in data.decode("utf-8", "replace").splitlines():
+        parts = line.split()
+        if len(parts) == 2 and parts[0] in HEAP_GAUGES:
+            heap[HEAP_GAUGES[parts[0]]] = int(float(parts[1]))
+    return heap or None
+
+
+def slope_per_hour(samples):
+    """Least-squares slope of (seconds, bytes) samples, in bytes/hour."""
+    if len(samples) < 2:
+        return None
+    n = len(samples)
+    mean_t = sum(t for t, _ in samples) / n
+    mean_v = sum(v for _, v in samples) / n
+    var = sum((t - mean_t) ** 2 for t, _ in samples)
+    if var == 0:
+        return None
+    cov = sum((t - mean_t) * (v - mean_v) for t, v in samples)
+    return cov / var * 3600
+
+
+def format_ms(value):
+    return "-" if value is None else "%dms" % value
+
+
+def format_window(elapsed, clients, window, heap):
+    poll = window["poll"].summary()
+    control = window["control"].summary()
+    hours, rest = divmod(int(elapsed), 3600)
+    line = "[%02d:%02d:%02d] clients=%d req=%d err=%.1f%% p50=%s p90=%s p99=%s max=%s" % (
+        hours, rest // 60, rest % 60, clients, poll["requests"], poll["error_rate"] * 100,
+        format_ms(poll["p50_ms"]), format_ms(poll["p90_ms"]),
+        format_ms(poll["p99_ms"]), format_ms(poll["max_ms"]))
+    if control["requests"]:
+        line += " | control=%d err=%d p99=%s" % (
+            control["requests"], control["errors"], format_ms(control["p99_ms"]))
+    if heap:
+        line += " | heap free=%s min=%s block=%s" % (
+            heap.get("free", "-"), heap.get("min", "-"), heap.get("block", "-"))
+    return line
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Load/soak test for a WebDashboard device")
+    parser.add_argument("--host", default="192.168.4.1")
+    parser.add_argument("--port", type=int, default=80)
+    parser.add_argument("-k", "--clients", type=int, default=4, help="simulated browsers")
+    parser.add_argument("--path", default="/api/status", help="polled endpoint")
+    parser.add_argument("--interval", type=float, default=2.0, help="poll period per client (s)")
+    parser.add_argument("-d", "--duration", type=parse_duration, default=0,
+                        help="run time, e.g. 600, 30m, 72h (default: until Ctrl-C)")
+    parser.add_argument("--ramp", type=parse_duration, default=0,
+                        help="start with 1 client and add one every RAMP seconds")
+    parser.add_argument("--burst-interval", type=float, default=30.0,
+                        help="seconds between control bursts (0 = none)")
+    parser.add_argument("--burst-size", type=int, default=5, help="requests per burst")
+    parser.add_argument("--timeout", type=float, default=5.0, help="per request (s)")
+    parser.add_argument("--report", type=parse_duration, default=60,
+                        help="report window, e.g. 60, 5m")
+    parser.add_argument("--jsonl", help="append one JSON object per window to this file")
+    args = parser.parse_args()
+
+    recorder = Recorder()
+    stop = threading.Event()
+    threads = []
+
+    def start_client():
+        thread = threading.Thread(target=poll_client, args=(args, recorder, stop), daemon=True)
+        thread.start()
+        threads.append(thread)
+
+    if args.burst_interval > 0:
+        threading.Thread(target=control_bursts, args=(args, recorder, stop), daemon=True).start()
+
+    started = time.monotonic()
+    for _ in range(1 if args.ramp else args.clients):
+        start_client()
+    print("loadgen: %s:%d, %d client(s)%s, %s every %.1fs" % (
+        args.host, args.port, len(threads),
+        " ramping to %d" % args.clients if args.ramp else "", args.path, args.interval))
+
+    jsonl = open(args.jsonl, "a", encoding="utf-8") if args.jsonl else None
+    heap_samples = []
+    heap_available = True
+    next_report = started + args.report
+    next_ramp = started + args.ramp
+
+    try:
+        while True:
+            now = time.monotonic()
+            if args.duration and now - started >= args.duration:
+                break
+            if args.ramp and now >= next_ramp and len(threads) < args.clients:
+                start_client()
+                next_ramp += args.ramp
+            if now < next_report:
+                time.sleep(min(0.5, next_report - now))
+                continue
+
+            next_report += args.report
+            window = recorder.take_window()
+            heap = scrape_heap(args) if heap_available else None
+            if heap is None and heap_available and not heap_samples:
+                heap_available = False
+                print("loadgen: /api/metrics not available, heap not tracked")
+            if heap and "free" in heap:
+                heap_samples.append((now - started, heap["free"]))
+
+            print(format_window(now - started, len(threads), window, heap), flush=True)
+            if jsonl:
+                record = {
+                    "t": round(now - started, 1),
+                    "clients": len(threads),
+                    "poll": window["poll"].summary(),
+                    "control": window["control"].summary(),
+                    "heap": heap,
+                }
+                jsonl.write(json.dumps(record) + "\n")
+                jsonl.flush()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        stop.set()
+
+    for thread in threads:
+        thread.join(args.timeout + 1)
+    window = recorder.take_window()     # Fold the last partial window into the totals
+    elapsed = time.monotonic() - started
+
+    print("\n=== Summary (%.0f s, %d clients) ===" % (elapsed, len(threads)))
+    for kind in Recorder.KINDS:
+        total = recorder.totals[kind].summary()
+        if not total["requests"]:
+            continue
+        print("%-8s requests=%d errors=%d (%.2f%%) p50=%s p90=%s p99=%s max=%s%s" % (
+            kind, total["requests"], total["errors"], total["error_rate"] * 100,
+            format_ms(total["p50_ms"]), format_ms(total["p90_ms"]),
+            format_ms(total["p99_ms"]), format_ms(total["max_ms"]),
+            " %s" % total["error_kinds"] if total["error_kinds"] else ""))
+    if heap_samples:
+        slope = slope_per_hour(heap_samples)
+        print("heap     first=%d last=%d trend=%s" % (
+            heap_samples[0][1], heap_samples[-1][1],
+            "-" if slope is None else "%+.0f bytes/hour" % slope))
+    if jsonl:
+        jsonl.close()
+
+    failed = sum(recorder.totals[kind].summary()["errors"] for kind in Recorder.KINDS)
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())